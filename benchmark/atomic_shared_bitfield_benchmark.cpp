@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include <trak/atomic_shared_bitfield.hpp>
+
+#include <cstdint>
+#include <mutex>
+
+namespace {
+    enum class A : std::uint32_t {};
+    enum class B : std::uint32_t {};
+
+    using bitfield = trak::shared_bitfield<A, B>;
+
+    bitfield flag_of(const benchmark::State& state) {
+        return static_cast<bitfield>(std::uint32_t{1} << (state.thread_index() % 32));
+    }
+
+    struct locked_bitfield {
+        std::mutex mutex;
+        bitfield value = static_cast<bitfield>(0u);
+    };
+
+    locked_bitfield locked;
+    trak::atomic_shared_bitfield<A, B> atomic;
+
+    void set_flag_mutex(benchmark::State& state) {
+        const auto flag = flag_of(state);
+        for (auto _ : state) {
+            std::lock_guard<std::mutex> lock(locked.mutex);
+            locked.value |= flag;
+            locked.value &= static_cast<bitfield>(~static_cast<std::uint32_t>(flag));
+        }
+    }
+    BENCHMARK(set_flag_mutex)->ThreadRange(1, 64)->UseRealTime();
+
+    void set_flag_atomic(benchmark::State& state) {
+        const auto flag = flag_of(state);
+        const auto clear = static_cast<bitfield>(~static_cast<std::uint32_t>(flag));
+        for (auto _ : state) {
+            atomic.fetch_or(flag, std::memory_order_acq_rel);
+            atomic.fetch_and(clear, std::memory_order_acq_rel);
+        }
+    }
+    BENCHMARK(set_flag_atomic)->ThreadRange(1, 64)->UseRealTime();
+
+    void set_flag_atomic_relaxed(benchmark::State& state) {
+        const auto flag = flag_of(state);
+        const auto clear = static_cast<bitfield>(~static_cast<std::uint32_t>(flag));
+        for (auto _ : state) {
+            atomic.fetch_or(flag, std::memory_order_relaxed);
+            atomic.fetch_and(clear, std::memory_order_relaxed);
+        }
+    }
+    BENCHMARK(set_flag_atomic_relaxed)->ThreadRange(1, 64)->UseRealTime();
+
+    void test_and_set_mutex(benchmark::State& state) {
+        const auto flag = flag_of(state);
+        for (auto _ : state) {
+            std::lock_guard<std::mutex> lock(locked.mutex);
+            const auto set = static_cast<std::uint32_t>(locked.value & flag) != 0;
+            locked.value = set ? locked.value & static_cast<bitfield>(~static_cast<std::uint32_t>(flag)) : locked.value | flag;
+            benchmark::DoNotOptimize(set);
+        }
+    }
+    BENCHMARK(test_and_set_mutex)->ThreadRange(1, 64)->UseRealTime();
+
+    void test_and_set_atomic(benchmark::State& state) {
+        const auto flag = flag_of(state);
+        for (auto _ : state) {
+            const auto set = atomic.test_and_set(flag, std::memory_order_acq_rel);
+            if (set) {
+                atomic.test_and_clear(flag, std::memory_order_release);
+            }
+            benchmark::DoNotOptimize(set);
+        }
+    }
+    BENCHMARK(test_and_set_atomic)->ThreadRange(1, 64)->UseRealTime();
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,155 @@
+#include <benchmark/benchmark.h>
+#include <trak/bitfield_algorithm.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+    enum class A : unsigned int {};
+    enum class B : unsigned int {};
+
+    using bitfield = trak::shared_bitfield<A, B>;
+
+    std::vector<bitfield> make_bitfields(std::size_t size, unsigned int seed) {
+        std::mt19937 engine(seed);
+        std::vector<bitfield> values;
+        values.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            values.push_back(static_cast<bitfield>(static_cast<unsigned int>(engine())));
+        }
+        return values;
+    }
+
+    void or_scalar_loop(benchmark::State& state) {
+        auto dst = make_bitfields(state.range(0), 1);
+        const auto src = make_bitfields(state.range(0), 2);
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < dst.size(); ++i) {
+                dst[i] |= src[i];
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(bitfield));
+    }
+    BENCHMARK(or_scalar_loop)->Range(1 << 10, 1 << 20);
+
+    void or_bulk(benchmark::State& state) {
+        auto dst = make_bitfields(state.range(0), 1);
+        const auto src = make_bitfields(state.range(0), 2);
+        for (auto _ : state) {
+            trak::bitfield_or(trak::span(dst), trak::span(src));
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(bitfield));
+    }
+    BENCHMARK(or_bulk)->Range(1 << 10, 1 << 20);
+
+    void count_scalar_loop(benchmark::State& state) {
+        const auto values = make_bitfields(state.range(0), 1);
+        for (auto _ : state) {
+            std::size_t count = 0;
+            for (auto value : values) {
+                for (auto bits = static_cast<unsigned int>(value); bits != 0; bits &= bits - 1) {
+                    ++count;
+                }
+            }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(bitfield));
+    }
+    BENCHMARK(count_scalar_loop)->Range(1 << 10, 1 << 20);
+
+    void count_bulk(benchmark::State& state) {
+        const auto values = make_bitfields(state.range(0), 1);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(trak::bitfield_count(trak::span(values)));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(bitfield));
+    }
+    BENCHMARK(count_bulk)->Range(1 << 10, 1 << 20);
+
+    void all_scalar_loop(benchmark::State& state) {
+        const auto values = std::vector<bitfield>(state.range(0), static_cast<bitfield>(0xffu));
+        const bitfield mask = static_cast<bitfield>(0x0fu);
+        for (auto _ : state) {
+            bool all = true;
+            for (auto value : values) {
+                all &= (value & mask) == mask;
+            }
+            benchmark::DoNotOptimize(all);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(bitfield));
+    }
+    BENCHMARK(all_scalar_loop)->Range(1 << 10, 1 << 20);
+
+    void all_bulk(benchmark::State& state) {
+        const auto values = std::vector<bitfield>(state.range(0), static_cast<bitfield>(0xffu));
+        const bitfield mask = static_cast<bitfield>(0x0fu);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(trak::bitfield_all(trak::span(values), mask));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(bitfield));
+    }
+    BENCHMARK(all_bulk)->Range(1 << 10, 1 << 20);
+
+    void mismatch_scalar_loop(benchmark::State& state) {
+        const auto lhs = make_bitfields(state.range(0), 1);
+        auto rhs = lhs;
+        rhs.back() ^= static_cast<bitfield>(1u);
+        const bitfield mask = static_cast<bitfield>(0xffffffffu);
+        for (auto _ : state) {
+            std::size_t i = 0;
+            while (i < lhs.size() && (lhs[i] & mask) == (rhs[i] & mask)) {
+                ++i;
+            }
+            benchmark::DoNotOptimize(i);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(bitfield) * 2);
+    }
+    BENCHMARK(mismatch_scalar_loop)->Range(1 << 10, 1 << 20);
+
+    void mismatch_bulk(benchmark::State& state) {
+        const auto lhs = make_bitfields(state.range(0), 1);
+        auto rhs = lhs;
+        rhs.back() ^= static_cast<bitfield>(1u);
+        const bitfield mask = static_cast<bitfield>(0xffffffffu);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(trak::bitfield_mismatch(trak::span(lhs), trak::span(rhs), mask));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(bitfield) * 2);
+    }
+    BENCHMARK(mismatch_bulk)->Range(1 << 10, 1 << 20);
+
+    void count_kernel(benchmark::State& state) {
+        const auto& kernels = trak::detail::bitfield_kernels_for(static_cast<trak::detail::simd_level>(state.range(0)));
+        const auto values = make_bitfields(1 << 16, 1);
+        const auto* data = trak::detail::bitfield_bytes(values.data());
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(kernels.count(data, values.size() * sizeof(bitfield)));
+        }
+        state.SetBytesProcessed(state.iterations() * values.size() * sizeof(bitfield));
+    }
+
+    void or_kernel(benchmark::State& state) {
+        const auto& kernels = trak::detail::bitfield_kernels_for(static_cast<trak::detail::simd_level>(state.range(0)));
+        auto dst = make_bitfields(1 << 12, 1);
+        const auto src = make_bitfields(1 << 12, 2);
+        for (auto _ : state) {
+            kernels.bit_or(trak::detail::bitfield_bytes(dst.data()), trak::detail::bitfield_bytes(src.data()), dst.size() * sizeof(bitfield));
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * dst.size() * sizeof(bitfield));
+    }
+
+    // Registers the kernels of each instruction set supported by this CPU, with the simd_level as argument.
+    const bool registered = [] {
+        for (int level = 0; level <= static_cast<int>(trak::detail::detect_simd_level()); ++level) {
+            benchmark::RegisterBenchmark("count_kernel", count_kernel)->Arg(level);
+            benchmark::RegisterBenchmark("or_kernel", or_kernel)->Arg(level);
+        }
+        return true;
+    }();
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <trak/bitfield_flags.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    enum class A : std::uint32_t {};
+    enum class B : std::uint32_t {};
+
+    using bitfield = trak::shared_bitfield<A, B>;
+
+    constexpr std::size_t size = 1 << 14;
+
+    /**
+     * Returns bitfields with state.range(0) random bits set each.
+     */
+    std::vector<bitfield> make_bitfields(const benchmark::State& state) {
+        std::mt19937 engine(1);
+        std::vector<bitfield> values;
+        values.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            std::uint32_t bits = 0;
+            while (static_cast<std::int64_t>(trak::detail::popcount64(bits)) < state.range(0)) {
+                bits |= std::uint32_t{1} << (engine() % 32);
+            }
+            values.push_back(static_cast<bitfield>(bits));
+        }
+        return values;
+    }
+
+    inline std::uint32_t apply(std::uint32_t state, A flag) noexcept {
+        return state * 31 + static_cast<std::uint32_t>(flag);
+    }
+
+    void flags_bit_test_loop(benchmark::State& state) {
+        const auto values = make_bitfields(state);
+        for (auto _ : state) {
+            std::uint32_t result = 0;
+            for (auto value : values) {
+                const auto bits = static_cast<std::uint32_t>(static_cast<A>(value));
+                for (unsigned int bit = 0; bit < std::numeric_limits<std::uint32_t>::digits; ++bit) {
+                    if (bits & (std::uint32_t{1} << bit)) {
+                        result = apply(result, static_cast<A>(std::uint32_t{1} << bit));
+                    }
+                }
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(flags_bit_test_loop)->Arg(1)->Arg(4)->Arg(16)->Arg(32);
+
+    void flags_range(benchmark::State& state) {
+        const auto values = make_bitfields(state);
+        for (auto _ : state) {
+            std::uint32_t result = 0;
+            for (auto value : values) {
+                for (A flag : trak::flags_of(value)) {
+                    result = apply(result, flag);
+                }
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(flags_range)->Arg(1)->Arg(4)->Arg(16)->Arg(32);
+
+    void flags_for_each(benchmark::State& state) {
+        const auto values = make_bitfields(state);
+        for (auto _ : state) {
+            std::uint32_t result = 0;
+            for (auto value : values) {
+                trak::for_each_flag(value, [&](bitfield flag) { result = apply(result, flag); });
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(flags_for_each)->Arg(1)->Arg(4)->Arg(16)->Arg(32);
+}
+
+BENCHMARK_MAIN();
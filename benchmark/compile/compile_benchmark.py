@@ -0,0 +1,361 @@
+#!/usr/bin/env python3
+"""
+Compile-time benchmark of the trak type-list metafunctions.
+
+Generates one translation unit per pack size, each declaring that many enum classes and exercising
+membership tests, intersections and shared bitfield operators over overlapping windows of the pack.
+Every translation unit is compiled in isolation and the following figures are recorded:
+
+  * wall-clock compile time,
+  * peak resident memory of the compiler,
+  * number of template instantiations (Clang only, taken from -ftime-trace),
+  * time spent in template instantiation (GCC only, taken from -ftime-report).
+
+With --constants, an additional translation unit declaring that many shared constants over random subsets of
+64 enums is compiled with debug information, and its object size, symbol count and debug-info size are recorded.
+
+With --permuted, a translation unit combining that many shared bitfield expressions, whose operands list the same
+sets of enums in different orders, is compiled with TRAK_CANONICAL_ORDER set to 0 and 1, and the compile time,
+object size, symbol count and template instantiations of both ordering modes are recorded.
+
+The results are written as JSON. When a baseline produced by a previous run is given, the script
+fails if any figure regressed by more than the given tolerance.
+"""
+
+import argparse
+import json
+import os
+import random
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+WINDOWS = 16
+
+
+def generate(size):
+    """Returns the source of the benchmark translation unit for a pack of size enums."""
+    lines = ['#include <trak/shared_bitfield.hpp>', '']
+    for i in range(size):
+        lines.append('enum class E%d : unsigned int { V0 = 1, V1 = 2, V2 = 4 };' % i)
+    lines.append('')
+    lines.append('using all_t = trak::shared_bitfield<%s>;' % ', '.join('E%d' % i for i in range(size)))
+
+    width = max(1, size // 2)
+    stride = max(1, size // WINDOWS)
+    windows = []
+    for w in range(WINDOWS):
+        first = (w * stride) % size
+        members = sorted(set((first + i) % size for i in range(width)))
+        windows.append(members)
+        lines.append('using window%d_t = trak::shared_bitfield<%s>;' % (w, ', '.join('E%d' % i for i in members)))
+    lines.append('')
+
+    for i in range(size):
+        lines.append('static_assert(trak::is_member_of_shared_enum<E%d, %s>::value, "");'
+                     % (i, ', '.join('E%d' % j for j in range(size))))
+    lines.append('')
+
+    for w in range(WINDOWS):
+        n = (w + 1) % WINDOWS
+        common = sorted(set(windows[w]) & set(windows[n]))
+        if not common:
+            continue
+        target = 'E%d' % common[0]
+        lines.extend([
+            'unsigned int window%d(all_t all) {' % w,
+            '    window%d_t lhs = %s::V0;' % (w, target),
+            '    window%d_t rhs = %s::V1;' % (n, target),
+            '    auto value = lhs | rhs;',
+            '    value &= all;',
+            '    value ^= rhs;',
+            '    return static_cast<unsigned int>(static_cast<%s>(value & lhs));' % target,
+            '}',
+        ])
+    lines.append('')
+    return '\n'.join(lines)
+
+
+def generate_constants(count, enums=64, values=64):
+    """Returns the source of a translation unit declaring and using count shared constants."""
+    rng = random.Random(count)
+    lines = ['#include <trak/shared_bitfield.hpp>', '']
+    enumerators = ', '.join('V%d' % v for v in range(values))
+    for i in range(enums):
+        lines.append('enum class E%d : unsigned int { %s };' % (i, enumerators))
+    lines.append('')
+    for c in range(count):
+        members = rng.sample(range(enums), rng.randint(2, 6))
+        value = rng.randrange(values)
+        types = ', '.join('E%d' % m for m in members)
+        lines.extend([
+            'constexpr inline trak::shared_enum<%s> C%d = E%d::V%d;' % (types, c, members[0], value),
+            'unsigned int use%d(E%d value) {' % (c, members[-1]),
+            '    E%d converted = C%d;' % (members[1], c),
+            '    return static_cast<unsigned int>(converted) + (C%d == value);' % c,
+            '}',
+        ])
+    lines.append('')
+    return '\n'.join(lines)
+
+
+def generate_permuted(count, enums=16, sets=32, orders=6):
+    """Returns the source of a translation unit of count bitfield expressions over permuted operand types."""
+    rng = random.Random(count)
+    lines = ['#include <trak/shared_bitfield.hpp>', '']
+    for i in range(enums):
+        lines.append('enum class E%d : unsigned int { V0 = 1, V1 = 2, V2 = 4 };' % i)
+    lines.append('')
+    pools = []
+    for s in range(sets):
+        members = rng.sample(range(enums), rng.randint(2, 5))
+        pool = []
+        for o in range(orders):
+            rng.shuffle(members)
+            pool.append('P%d_%d' % (s, o))
+            lines.append('using P%d_%d = trak::shared_bitfield<%s>;' % (s, o, ', '.join('E%d' % m for m in members)))
+        pools.append((members[0], pool))
+    lines.append('')
+    for c in range(count):
+        target, pool = pools[rng.randrange(sets)]
+        operands = [rng.choice(pool) for _ in range(6)]
+        lines.extend([
+            'unsigned int expression%d(%s) {' % (c, ', '.join('%s p%d' % (t, i) for i, t in enumerate(operands))),
+            '    auto value = ((p0 | p1) & (p2 | p3)) ^ (p4 | p5);',
+            '    return static_cast<unsigned int>(static_cast<E%d>(value));' % target,
+            '}',
+        ])
+    lines.append('')
+    return '\n'.join(lines)
+
+
+def elf_sections(path):
+    """Returns a dictionary of section names to sizes of the ELF64 little-endian object at path."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'\x7fELF' or data[4] != 2 or data[5] != 1:
+        return {}
+    shoff, = struct.unpack_from('<Q', data, 0x28)
+    shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x3a)
+    headers = [struct.unpack_from('<IIQQQQIIQQ', data, shoff + i * shentsize) for i in range(shnum)]
+    names = headers[shstrndx][4]
+    sections = {}
+    for header in headers:
+        name = data[names + header[0]:data.index(b'\0', names + header[0])].decode()
+        sections[name] = sections.get(name, 0) + header[5]
+    return sections
+
+
+def measure_constants(args, workdir):
+    source = os.path.join(workdir, 'constants_%d.cpp' % args.constants)
+    output = os.path.join(workdir, 'constants_%d.o' % args.constants)
+    with open(source, 'w') as f:
+        f.write(generate_constants(args.constants))
+
+    command = [args.compiler, '-std=c++%s' % args.std, '-I', args.include, '-g', '-O0', '-c', source, '-o', output]
+    command += args.flags
+    if compiler_flavour(args.compiler) == 'clang':
+        command.append('-ftime-trace')
+    elapsed, peak, _ = run_compiler(command)
+
+    sections = elf_sections(output)
+    result = {
+        'constants': args.constants,
+        'compile_seconds': elapsed,
+        'peak_memory_kib': peak,
+        'object_bytes': os.path.getsize(output),
+    }
+    if sections:
+        result['symbols'] = sections.get('.symtab', 0) // 24
+        result['debug_info_bytes'] = sum(size for name, size in sections.items() if name.startswith('.debug'))
+    if compiler_flavour(args.compiler) == 'clang':
+        result['instantiations'] = count_instantiations(os.path.splitext(output)[0] + '.json')
+    return result
+
+
+def measure_permuted(args, workdir):
+    source = os.path.join(workdir, 'permuted_%d.cpp' % args.permuted)
+    with open(source, 'w') as f:
+        f.write(generate_permuted(args.permuted))
+
+    result = {'expressions': args.permuted}
+    for mode, define in (('preserved', '0'), ('canonical', '1')):
+        output = os.path.join(workdir, 'permuted_%s.o' % mode)
+        command = [args.compiler, '-std=c++%s' % args.std, '-I', args.include, '-DTRAK_CANONICAL_ORDER=%s' % define,
+                   '-O0', '-c', source, '-o', output]
+        command += args.flags
+        if compiler_flavour(args.compiler) == 'clang':
+            command.append('-ftime-trace')
+        elapsed, peak, _ = run_compiler(command)
+
+        sections = elf_sections(output)
+        entry = {'compile_seconds': elapsed, 'peak_memory_kib': peak, 'object_bytes': os.path.getsize(output)}
+        if sections:
+            entry['symbols'] = sections.get('.symtab', 0) // 24
+        if compiler_flavour(args.compiler) == 'clang':
+            entry['instantiations'] = count_instantiations(os.path.splitext(output)[0] + '.json')
+        result[mode] = entry
+    return result
+
+
+def compiler_flavour(compiler):
+    """Returns 'clang', 'gcc' or 'other', depending on the --version output of compiler."""
+    try:
+        version = subprocess.run([compiler, '--version'], capture_output=True, text=True).stdout.lower()
+    except OSError:
+        return 'other'
+    if 'clang' in version:
+        return 'clang'
+    if 'gcc' in version or 'g++' in version or 'free software foundation' in version:
+        return 'gcc'
+    return 'other'
+
+
+def run_compiler(command):
+    """Runs command and returns its wall time in seconds, its peak memory in KiB and its stderr output."""
+    start = time.perf_counter()
+    process = subprocess.Popen(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+    stderr = process.stderr.read()
+    _, status, usage = os.wait4(process.pid, 0)
+    elapsed = time.perf_counter() - start
+    process.returncode = os.waitstatus_to_exitcode(status)
+    if process.returncode != 0:
+        sys.stderr.write(stderr)
+        raise RuntimeError('compilation failed: %s' % ' '.join(command))
+    # ru_maxrss is reported in KiB on Linux and in bytes on macOS.
+    peak = usage.ru_maxrss // 1024 if sys.platform == 'darwin' else usage.ru_maxrss
+    return elapsed, peak, stderr
+
+
+def count_instantiations(trace_file):
+    """Counts the template instantiation events of a Clang -ftime-trace file."""
+    with open(trace_file) as f:
+        events = json.load(f).get('traceEvents', [])
+    return sum(1 for event in events if event.get('name') in ('InstantiateClass', 'InstantiateFunction'))
+
+
+def parse_instantiation_time(report):
+    """Extracts the wall time of the 'template instantiation' phase from a GCC -ftime-report."""
+    for line in report.splitlines():
+        if line.strip().startswith('template instantiation'):
+            # The fields are usr, sys and wall time, each followed by its percentage in parentheses.
+            times = re.findall(r'([0-9.]+)\s*\(', line.split(':', 1)[1])
+            return float(times[2]) if len(times) > 2 else None
+    return None
+
+
+def measure(args, size, workdir):
+    source = os.path.join(workdir, 'pack_%d.cpp' % size)
+    output = os.path.join(workdir, 'pack_%d.o' % size)
+    with open(source, 'w') as f:
+        f.write(generate(size))
+
+    flavour = compiler_flavour(args.compiler)
+    command = [args.compiler, '-std=c++%s' % args.std, '-I', args.include, '-c', source, '-o', output]
+    command += args.flags
+    if flavour == 'clang':
+        command.append('-ftime-trace')
+    elif flavour == 'gcc':
+        command.append('-ftime-report')
+
+    times = []
+    peak = 0
+    result = {'size': size}
+    for _ in range(args.repetitions):
+        elapsed, memory, stderr = run_compiler(command)
+        times.append(elapsed)
+        peak = max(peak, memory)
+        if flavour == 'gcc':
+            result['instantiation_seconds'] = parse_instantiation_time(stderr)
+    result['compile_seconds'] = min(times)
+    result['peak_memory_kib'] = peak
+    if flavour == 'clang':
+        result['instantiations'] = count_instantiations(os.path.splitext(output)[0] + '.json')
+    return result
+
+
+def check_regressions(results, constants, baseline, tolerance):
+    """Returns a list of human readable regressions of results and constants against baseline."""
+    previous = {entry['size']: entry for entry in baseline['results']}
+    regressions = []
+    old = baseline.get('constants')
+    if constants and old and old['constants'] == constants['constants']:
+        for key in ('compile_seconds', 'peak_memory_kib', 'object_bytes', 'symbols', 'debug_info_bytes', 'instantiations'):
+            if constants.get(key) is not None and old.get(key) is not None and constants[key] > old[key] * (1.0 + tolerance):
+                regressions.append('%s for %d constants: %s -> %s' % (key, constants['constants'], old[key], constants[key]))
+    for entry in results:
+        old = previous.get(entry['size'])
+        if old is None:
+            continue
+        for key in ('compile_seconds', 'peak_memory_kib', 'instantiations'):
+            if entry.get(key) is None or old.get(key) is None:
+                continue
+            if entry[key] > old[key] * (1.0 + tolerance):
+                regressions.append('%s for %d types: %s -> %s' % (key, entry['size'], old[key], entry[key]))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--compiler', required=True, help='C++ compiler to benchmark')
+    parser.add_argument('--include', required=True, help='include directory of trak')
+    parser.add_argument('--std', default='17', help='C++ standard version (default: 17)')
+    parser.add_argument('--sizes', type=int, nargs='+', default=[8, 64, 256], help='pack sizes to benchmark')
+    parser.add_argument('--constants', type=int, default=0, help='number of shared constants to benchmark (default: 0)')
+    parser.add_argument('--permuted', type=int, default=0, help='number of permuted bitfield expressions to benchmark (default: 0)')
+    parser.add_argument('--repetitions', type=int, default=3, help='compilations per pack size')
+    parser.add_argument('--output', help='file to write the JSON results to')
+    parser.add_argument('--baseline', help='JSON results of a previous run to compare against')
+    parser.add_argument('--tolerance', type=float, default=0.2, help='allowed relative regression (default: 0.2)')
+    parser.add_argument('--flags', nargs=argparse.REMAINDER, default=[], help='additional compiler flags')
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as workdir:
+        results = [measure(args, size, workdir) for size in args.sizes]
+        constants = measure_constants(args, workdir) if args.constants else None
+        permuted = measure_permuted(args, workdir) if args.permuted else None
+
+    for entry in results:
+        print('%4d types: %.3f s, %d KiB peak%s%s' % (
+            entry['size'], entry['compile_seconds'], entry['peak_memory_kib'],
+            ', %d instantiations' % entry['instantiations'] if 'instantiations' in entry else '',
+            ', %.3f s instantiating' % entry['instantiation_seconds'] if entry.get('instantiation_seconds') else ''))
+
+    if constants:
+        print('%d constants: %.3f s, %d KiB peak, %d bytes object%s%s' % (
+            constants['constants'], constants['compile_seconds'], constants['peak_memory_kib'], constants['object_bytes'],
+            ', %d symbols, %d bytes debug info' % (constants['symbols'], constants['debug_info_bytes'])
+            if 'symbols' in constants else '',
+            ', %d instantiations' % constants['instantiations'] if 'instantiations' in constants else ''))
+
+    if permuted:
+        for mode in ('preserved', 'canonical'):
+            entry = permuted[mode]
+            print('%d permuted expressions, %s order: %.3f s, %d KiB peak, %d bytes object%s%s' % (
+                permuted['expressions'], mode, entry['compile_seconds'], entry['peak_memory_kib'], entry['object_bytes'],
+                ', %d symbols' % entry['symbols'] if 'symbols' in entry else '',
+                ', %d instantiations' % entry['instantiations'] if 'instantiations' in entry else ''))
+
+    report = {'compiler': args.compiler, 'std': args.std, 'results': results}
+    if constants:
+        report['constants'] = constants
+    if permuted:
+        report['permuted'] = permuted
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            regressions = check_regressions(results, constants, json.load(f), args.tolerance)
+        for regression in regressions:
+            print('regression: %s' % regression)
+        return 1 if regressions else 0
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
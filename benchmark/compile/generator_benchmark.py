@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+Benchmark of the registry generator and of the build times of the code using its outputs.
+
+Synthesizes a registry of enums, many of them sharing value names, and generates its headers both split, one header
+per enum, and monolithic, a single header. For each mode, the following figures are recorded:
+
+  * wall-clock time of generating the headers from scratch, and the number of headers,
+  * wall-clock time of regenerating them after adding a value to one enum, and the number of rewritten headers,
+  * wall-clock time of a clean build of translation units each including the headers of a few enums,
+  * wall-clock time of the incremental build after the regeneration, rebuilding the translation units depending
+    on a rewritten header, and their number.
+
+The results are written as JSON.
+"""
+
+import argparse
+import concurrent.futures
+import json
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+NAMESPACE = 'bench'
+
+
+def generate_registry(args, rng):
+    """Returns a registry of args.enums enums, whose values are shared by several enums with probability args.shared."""
+    names = ['NAME_%d' % i for i in range(args.names)]
+    values = {name: 0x1000 + i for i, name in enumerate(names)}
+    enums = []
+    for e in range(args.enums):
+        chosen = set()
+        while len(chosen) < args.values:
+            # Shared names are drawn from a small pool, so they are used by several enums.
+            pool = args.names // 10 if rng.random() < args.shared else args.names
+            chosen.add(names[rng.randrange(pool)])
+        enums.append({'name': 'Enum%d' % e, 'values': [{'name': n, 'value': values[n]} for n in sorted(chosen)]})
+    return {'namespace': NAMESPACE, 'underlying_type': 'std::uint32_t', 'enums': enums}
+
+
+def generate(args, registry_path, output_dir, monolithic):
+    """Runs the generator and returns the wall time in seconds and the written or removed outputs."""
+    command = [sys.executable, args.generator, '--registry', registry_path, '--output', output_dir, '--verbose']
+    if monolithic:
+        command.append('--monolithic')
+    start = time.perf_counter()
+    process = subprocess.run(command, capture_output=True, text=True)
+    elapsed = time.perf_counter() - start
+    if process.returncode != 0:
+        sys.stderr.write(process.stderr)
+        raise RuntimeError('generation failed: %s' % ' '.join(command))
+    return elapsed, [line.split(' ', 1)[1] for line in process.stdout.splitlines() if line]
+
+
+def generate_unit(index, args, rng, monolithic):
+    """Returns the source of a translation unit using the constants of a few enums and the enums it uses."""
+    used = rng.sample(range(args.enums), args.includes)
+    if monolithic:
+        source = ['#include <%s/%s.hpp>' % (NAMESPACE, NAMESPACE)]
+    else:
+        source = ['#include <%s/Enum%d.hpp>' % (NAMESPACE, e) for e in used]
+    source.extend(['', 'std::uint32_t unit%d_use() {' % index, '    std::uint32_t result = 0;'])
+    for e in used:
+        source.append('    result += static_cast<std::uint32_t>(static_cast<%s::Enum%d>(%s::Enum%d{}));'
+                      % (NAMESPACE, e, NAMESPACE, e))
+    source.extend(['    return result;', '}', ''])
+    return '\n'.join(source)
+
+
+def run(commands, workdir, jobs):
+    """Runs the commands in parallel and returns the wall time in seconds."""
+    def execute(command):
+        process = subprocess.run(command, cwd=workdir, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+        if process.returncode != 0:
+            sys.stderr.write(process.stderr)
+            raise RuntimeError('compilation failed: %s' % ' '.join(command))
+
+    start = time.perf_counter()
+    with concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as executor:
+        for future in [executor.submit(execute, command) for command in commands]:
+            future.result()
+    return time.perf_counter() - start
+
+
+def read_dependencies(path):
+    """Returns the absolute paths listed in the make dependency file at path."""
+    with open(path) as f:
+        content = f.read().replace('\\\n', ' ')
+    return set(os.path.abspath(token) for token in content.split(':', 1)[1].split())
+
+
+def measure(args, registry, mode):
+    monolithic = mode == 'monolithic'
+    rng = random.Random(args.units * 7 + args.enums)
+    with tempfile.TemporaryDirectory() as workdir:
+        registry_path = os.path.join(workdir, 'registry.json')
+        output_dir = os.path.join(workdir, 'generated')
+        with open(registry_path, 'w') as f:
+            json.dump(registry, f)
+        clean_generation, outputs = generate(args, registry_path, output_dir, monolithic)
+
+        units = ['unit%d' % index for index in range(args.units)]
+        commands = {}
+        for index, unit in enumerate(units):
+            with open(os.path.join(workdir, unit + '.cpp'), 'w') as f:
+                f.write(generate_unit(index, args, rng, monolithic))
+            commands[unit] = [args.compiler, '-std=c++%s' % args.std, '-I', args.include, '-I', output_dir,
+                              '-MD', '-MF', unit + '.d', '-c', unit + '.cpp', '-o', unit + '.o'] + args.flags
+        clean_build = run(commands.values(), workdir, args.jobs)
+
+        # Adding a value to one enum rewrites the headers holding it, and rebuilds the units including them.
+        changed = dict(registry, enums=[dict(enum) for enum in registry['enums']])
+        enum = changed['enums'][len(changed['enums']) // 2]
+        enum['values'] = enum['values'] + [{'name': 'ADDED_VALUE', 'value': 1}]
+        with open(registry_path, 'w') as f:
+            json.dump(changed, f)
+        incremental_generation, rewritten = generate(args, registry_path, output_dir, monolithic)
+        rewritten = set(os.path.abspath(os.path.join(output_dir, path)) for path in rewritten)
+        touched = [unit for unit in units
+                   if read_dependencies(os.path.join(workdir, unit + '.d')) & rewritten]
+        incremental_build = run([commands[unit] for unit in touched], workdir, args.jobs)
+    return {
+        'mode': mode,
+        'enums': args.enums,
+        'units': args.units,
+        'outputs': len(outputs),
+        'generation_seconds': clean_generation,
+        'regeneration_seconds': incremental_generation,
+        'rewritten_outputs': len(rewritten),
+        'clean_build_seconds': clean_build,
+        'incremental_build_seconds': incremental_build,
+        'incremental_units': len(touched),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--compiler', required=True, help='C++ compiler to benchmark')
+    parser.add_argument('--include', required=True, help='include directory of trak')
+    parser.add_argument('--generator', required=True, help='the generator script trak_generate.py')
+    parser.add_argument('--std', default='17', help='C++ standard version (default: 17)')
+    parser.add_argument('--enums', type=int, default=400, help='number of enums of the registry (default: 400)')
+    parser.add_argument('--names', type=int, default=6000, help='number of value names of the registry (default: 6000)')
+    parser.add_argument('--values', type=int, default=24, help='number of values per enum (default: 24)')
+    parser.add_argument('--shared', type=float, default=0.3,
+                        help='probability of a value to be drawn from the shared names (default: 0.3)')
+    parser.add_argument('--units', type=int, default=40, help='number of translation units (default: 40)')
+    parser.add_argument('--includes', type=int, default=4, help='number of enums used per translation unit (default: 4)')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count() or 1, help='parallel compilations')
+    parser.add_argument('--output', help='file to write the JSON results to')
+    parser.add_argument('--flags', nargs=argparse.REMAINDER, default=[], help='additional compiler flags')
+    args = parser.parse_args()
+    args.include = os.path.abspath(args.include)
+    args.generator = os.path.abspath(args.generator)
+
+    registry = generate_registry(args, random.Random(args.enums * 31 + args.names))
+    results = []
+    for mode in ['split', 'monolithic']:
+        result = measure(args, registry, mode)
+        results.append(result)
+        print('%-10s %d enums, %d headers: generation %.2f s, regeneration %.2f s (%d rewritten); '
+              '%d units: clean build %.2f s, incremental build %.2f s (%d units)' % (
+                  mode, result['enums'], result['outputs'], result['generation_seconds'],
+                  result['regeneration_seconds'], result['rewritten_outputs'], result['units'],
+                  result['clean_build_seconds'], result['incremental_build_seconds'], result['incremental_units']))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump({'compiler': args.compiler, 'jobs': args.jobs, 'results': results}, f, indent=2)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""
+Build-time benchmark of a synthetic project using trak.
+
+Generates a project of many translation units sharing a header of enum classes. Each translation unit has its own
+header declaring a slice of the shared constants, includes the headers of its neighbours and uses their constants
+in comparisons, conversions and shared bitfield operators. The project is built once per mode and the following
+figures are recorded:
+
+  * wall-clock time of a clean build, including the module interface if any,
+  * wall-clock time of an incremental build after touching the header of one translation unit,
+  * wall-clock time of an incremental build after touching the shared header.
+
+The modes are 'headers' (the headers compiled with the given --std, by default 17 and 20, the latter using the
+concepts build) and 'module' (the named module trak, imported instead of included, which requires C++20 and
+-fmodules-ts for GCC or --precompile for Clang).
+
+The results are written as JSON.
+"""
+
+import argparse
+import concurrent.futures
+import json
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+ENUMS = 64
+VALUES = 32
+NEIGHBOURS = 2
+
+
+def compiler_flavour(compiler):
+    """Returns 'clang', 'gcc' or 'other', depending on the --version output of compiler."""
+    try:
+        version = subprocess.run([compiler, '--version'], capture_output=True, text=True).stdout.lower()
+    except OSError:
+        return 'other'
+    if 'clang' in version:
+        return 'clang'
+    if 'gcc' in version or 'g++' in version or 'free software foundation' in version:
+        return 'gcc'
+    return 'other'
+
+
+def generate_shared(module):
+    """Returns the source of the header shared by all translation units."""
+    lines = ['#pragma once', '', '#include <cstdint>']
+    lines.append('import trak;' if module else '#include <trak/shared_bitfield.hpp>')
+    lines.append('')
+    enumerators = ', '.join('V%d = %d' % (v, 1 << (v % 31)) for v in range(VALUES))
+    for i in range(ENUMS):
+        lines.append('enum class E%d : std::uint32_t { %s };' % (i, enumerators))
+    lines.append('')
+    return '\n'.join(lines)
+
+
+def generate_unit(index, units, constants, rng):
+    """Returns the sources of the header and the translation unit of the given index."""
+    header = ['#pragma once', '', '#include "shared.hpp"', '', 'namespace unit%d {' % index]
+    used = []
+    for c in range(constants):
+        members = rng.sample(range(ENUMS), rng.randint(2, 6))
+        header.append('    constexpr inline trak::shared_enum<%s> C%d = E%d::V%d;'
+                      % (', '.join('E%d' % m for m in members), c, members[0], rng.randrange(VALUES)))
+        used.append(members)
+    header.extend(['}', ''])
+
+    neighbours = [(index + n) % units for n in range(NEIGHBOURS + 1)]
+    source = ['#include "unit%d.hpp"' % n for n in sorted(set(neighbours))]
+    source.extend(['', 'std::uint32_t unit%d_use(E%d value, trak::shared_bitfield<E%d> bits) {' % (index, used[0][-1], used[0][0]),
+                   '    std::uint32_t result = 0;'])
+    for c, members in enumerate(used):
+        source.extend([
+            '    {',
+            '        E%d converted = unit%d::C%d;' % (members[1], index, c),
+            '        result += static_cast<std::uint32_t>(converted) + (unit%d::C%d == E%d::V%d);'
+            % (index, c, members[-1], c % VALUES),
+            '        result += static_cast<std::uint32_t>(bits | trak::shared_bitfield<E%d>(E%d::V%d));'
+            % (used[0][0], used[0][0], c % VALUES),
+            '    }',
+        ])
+    for n in neighbours[1:]:
+        source.append('    result += static_cast<std::uint32_t>(unit%d::C0 == unit%d::C0);' % (n, n))
+    source.extend(['    return result + static_cast<std::uint32_t>(value);', '}', ''])
+    return '\n'.join(header), '\n'.join(source), neighbours
+
+
+def generate_project(args, workdir, module):
+    """Writes the project to workdir and returns the dependencies of each translation unit on unit headers."""
+    rng = random.Random(args.units * 31 + args.constants)
+    with open(os.path.join(workdir, 'shared.hpp'), 'w') as f:
+        f.write(generate_shared(module))
+    per_unit = max(1, args.constants // args.units)
+    dependencies = []
+    for index in range(args.units):
+        header, source, neighbours = generate_unit(index, args.units, per_unit, rng)
+        with open(os.path.join(workdir, 'unit%d.hpp' % index), 'w') as f:
+            f.write(header)
+        with open(os.path.join(workdir, 'unit%d.cpp' % index), 'w') as f:
+            f.write(source)
+        dependencies.append(set(neighbours))
+    return dependencies
+
+
+def compile_command(args, std, module, flavour, source, output):
+    command = [args.compiler, '-std=c++%s' % std, '-I', args.include, '-c', source, '-o', output] + args.flags
+    if module:
+        if flavour == 'gcc':
+            command.append('-fmodules-ts')
+        elif flavour == 'clang':
+            command.append('-fmodule-file=trak=trak.pcm')
+    return command
+
+
+def module_command(args, flavour):
+    interface = os.path.join(args.module_dir, 'trak.cppm')
+    if flavour == 'gcc':
+        # GCC does not recognize the .cppm extension.
+        return [args.compiler, '-std=c++20', '-fmodules-ts', '-I', args.include, '-x', 'c++', '-c', interface, '-o', 'trak.o'] + args.flags
+    return [args.compiler, '-std=c++20', '-I', args.include, '--precompile', interface, '-o', 'trak.pcm'] + args.flags
+
+
+def run(commands, workdir, jobs):
+    """Runs the commands in parallel and returns the wall time in seconds."""
+    def execute(command):
+        process = subprocess.run(command, cwd=workdir, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+        if process.returncode != 0:
+            sys.stderr.write(process.stderr)
+            raise RuntimeError('compilation failed: %s' % ' '.join(command))
+
+    start = time.perf_counter()
+    with concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as executor:
+        for future in [executor.submit(execute, command) for command in commands]:
+            future.result()
+    return time.perf_counter() - start
+
+
+def measure(args, mode, std):
+    flavour = compiler_flavour(args.compiler)
+    module = mode == 'module'
+    with tempfile.TemporaryDirectory() as workdir:
+        dependencies = generate_project(args, workdir, module)
+        units = ['unit%d' % index for index in range(args.units)]
+        commands = {unit: compile_command(args, std, module, flavour, unit + '.cpp', unit + '.o') for unit in units}
+
+        clean = run([module_command(args, flavour)], workdir, 1) if module else 0.0
+        clean += run(commands.values(), workdir, args.jobs)
+        # Touching the header of unit 0 rebuilds the units including it.
+        touched = [unit for unit, uses in zip(units, dependencies) if 0 in uses]
+        incremental = run([commands[unit] for unit in touched], workdir, args.jobs)
+        # Touching the shared header rebuilds every unit.
+        shared = run(commands.values(), workdir, args.jobs)
+    return {
+        'mode': mode,
+        'std': std,
+        'units': args.units,
+        'constants': max(1, args.constants // args.units) * args.units,
+        'clean_seconds': clean,
+        'incremental_seconds': incremental,
+        'incremental_units': len(touched),
+        'shared_header_seconds': shared,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--compiler', required=True, help='C++ compiler to benchmark')
+    parser.add_argument('--include', required=True, help='include directory of trak')
+    parser.add_argument('--module-dir', help='directory of trak.cppm, required for the module mode')
+    parser.add_argument('--std', nargs='+', default=['17', '20'], help='C++ standard versions of the headers mode')
+    parser.add_argument('--modes', nargs='+', default=['headers'], choices=['headers', 'module'], help='modes to benchmark')
+    parser.add_argument('--units', type=int, default=200, help='number of translation units (default: 200)')
+    parser.add_argument('--constants', type=int, default=4000, help='number of shared constants (default: 4000)')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count() or 1, help='parallel compilations')
+    parser.add_argument('--output', help='file to write the JSON results to')
+    parser.add_argument('--flags', nargs=argparse.REMAINDER, default=[], help='additional compiler flags')
+    args = parser.parse_args()
+    args.include = os.path.abspath(args.include)
+    if args.module_dir:
+        args.module_dir = os.path.abspath(args.module_dir)
+
+    results = []
+    for mode in args.modes:
+        if mode == 'module' and not args.module_dir:
+            parser.error('the module mode requires --module-dir')
+        for std in (args.std if mode == 'headers' else ['20']):
+            result = measure(args, mode, std)
+            results.append(result)
+            print('%-7s c++%s: %d units, %d constants: clean %.2f s, incremental %.2f s (%d units), shared header %.2f s' % (
+                mode, std, result['units'], result['constants'], result['clean_seconds'], result['incremental_seconds'],
+                result['incremental_units'], result['shared_header_seconds']))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump({'compiler': args.compiler, 'jobs': args.jobs, 'results': results}, f, indent=2)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
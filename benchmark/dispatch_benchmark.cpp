@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <trak/dispatch.hpp>
+
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    enum class Dense : unsigned int {
+        V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11, V12, V13, V14, V15
+    };
+
+    enum class Sparse : unsigned int {
+        V0 = 3, V1 = 9, V2 = 14, V3 = 22, V4 = 31, V5 = 40, V6 = 47, V7 = 55,
+        V8 = 60, V9 = 71, V10 = 80, V11 = 88, V12 = 95, V13 = 103, V14 = 110, V15 = 126
+    };
+
+    constexpr std::size_t size = 4096;
+
+    /**
+     * Returns size values, chosen randomly from the enumerators of E if random is true, otherwise in a repeating
+     * pattern the branch predictor learns.
+     */
+    template<typename E>
+    std::vector<E> make_values(bool random) {
+        std::mt19937 engine(1);
+        std::vector<E> values;
+        for (std::size_t i = 0; i < size; ++i) {
+            values.push_back(trak::enum_reflection<E>::values[random ? engine() % 16 : i % 4]);
+        }
+        return values;
+    }
+
+    /**
+     * A handler doing a different cheap operation per enumerator.
+     */
+    struct handler {
+        unsigned int& state;
+
+        template<typename E, E V>
+        void operator()(std::integral_constant<E, V>) const noexcept {
+            constexpr auto index = static_cast<unsigned int>(V);
+            if constexpr (index % 3 == 0) {
+                state += index;
+            } else if constexpr (index % 3 == 1) {
+                state ^= index * 2654435761u;
+            } else {
+                state = state * 31 + index;
+            }
+        }
+    };
+
+    template<typename E>
+    void dispatch(benchmark::State& state) {
+        const auto values = make_values<E>(state.range(0) != 0);
+        for (auto _ : state) {
+            unsigned int result = 0;
+            for (auto value : values) {
+                trak::dispatch(value, handler{result});
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK_TEMPLATE(dispatch, Dense)->ArgName("random")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(dispatch, Sparse)->ArgName("random")->Arg(0)->Arg(1);
+
+    // The hand-written switch equivalent to dispatching with handler.
+#define TRAK_BENCHMARK_CASE(E, V) case E::V: handler{result}(std::integral_constant<E, E::V>{}); break;
+#define TRAK_BENCHMARK_SWITCH(E) \
+    switch (value) { \
+        TRAK_BENCHMARK_CASE(E, V0) TRAK_BENCHMARK_CASE(E, V1) TRAK_BENCHMARK_CASE(E, V2) TRAK_BENCHMARK_CASE(E, V3) \
+        TRAK_BENCHMARK_CASE(E, V4) TRAK_BENCHMARK_CASE(E, V5) TRAK_BENCHMARK_CASE(E, V6) TRAK_BENCHMARK_CASE(E, V7) \
+        TRAK_BENCHMARK_CASE(E, V8) TRAK_BENCHMARK_CASE(E, V9) TRAK_BENCHMARK_CASE(E, V10) TRAK_BENCHMARK_CASE(E, V11) \
+        TRAK_BENCHMARK_CASE(E, V12) TRAK_BENCHMARK_CASE(E, V13) TRAK_BENCHMARK_CASE(E, V14) TRAK_BENCHMARK_CASE(E, V15) \
+    }
+
+    template<typename E>
+    void switch_statement(benchmark::State& state) {
+        const auto values = make_values<E>(state.range(0) != 0);
+        for (auto _ : state) {
+            unsigned int result = 0;
+            for (auto value : values) {
+                TRAK_BENCHMARK_SWITCH(E)
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK_TEMPLATE(switch_statement, Dense)->ArgName("random")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(switch_statement, Sparse)->ArgName("random")->Arg(0)->Arg(1);
+
+#undef TRAK_BENCHMARK_SWITCH
+#undef TRAK_BENCHMARK_CASE
+}
+
+BENCHMARK_MAIN();
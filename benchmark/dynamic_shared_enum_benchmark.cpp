@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+#include <trak/dynamic_shared_enum.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+    template<std::size_t I>
+    struct tag {
+        enum class type : std::uint32_t {};
+    };
+
+    template<std::size_t I>
+    using E = typename tag<I>::type;
+
+    constexpr std::size_t types = 32;
+    constexpr std::size_t size = 1 << 16;
+
+    template<typename Is>
+    struct type_list;
+
+    template<std::size_t... Is>
+    struct type_list<std::index_sequence<Is...>> {
+        using variant = std::variant<E<Is>...>;
+
+        template<typename T>
+        static T make(std::size_t type, std::uint32_t value) {
+            T result{};
+            static_cast<void>(((type == Is ? (result = T(static_cast<E<Is>>(value)), true) : false) || ...));
+            return result;
+        }
+
+        template<typename F>
+        static auto visit(const trak::dynamic_shared_enum& value, F&& f) {
+            return trak::visit<E<Is>...>(value, std::forward<F>(f));
+        }
+    };
+
+    using all_types = type_list<std::make_index_sequence<types>>;
+
+    template<typename T>
+    std::vector<T> make_values() {
+        std::mt19937 engine(1);
+        std::vector<T> values;
+        values.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            values.push_back(all_types::make<T>(engine() % types, engine() % 16));
+        }
+        return values;
+    }
+
+    struct accumulate {
+        template<typename T>
+        std::uint32_t operator()(T value) const noexcept {
+            return static_cast<std::uint32_t>(value) * 3 + 1;
+        }
+    };
+
+    void visit_variant(benchmark::State& state) {
+        const auto values = make_values<all_types::variant>();
+        for (auto _ : state) {
+            std::uint32_t sum = 0;
+            for (const auto& value : values) {
+                sum += std::visit(accumulate{}, value);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        state.counters["bytes_per_value"] = sizeof(all_types::variant);
+    }
+    BENCHMARK(visit_variant);
+
+    void visit_dynamic(benchmark::State& state) {
+        const auto values = make_values<trak::dynamic_shared_enum>();
+        for (auto _ : state) {
+            std::uint32_t sum = 0;
+            for (const auto& value : values) {
+                sum += all_types::visit(value, accumulate{});
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        state.counters["bytes_per_value"] = sizeof(trak::dynamic_shared_enum);
+    }
+    BENCHMARK(visit_dynamic);
+
+    void as_variant(benchmark::State& state) {
+        const auto values = make_values<all_types::variant>();
+        for (auto _ : state) {
+            std::uint32_t sum = 0;
+            for (const auto& value : values) {
+                const auto* e = std::get_if<E<7>>(&value);
+                sum += e != nullptr ? static_cast<std::uint32_t>(*e) : 0;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(as_variant);
+
+    void as_dynamic(benchmark::State& state) {
+        const auto values = make_values<trak::dynamic_shared_enum>();
+        for (auto _ : state) {
+            std::uint32_t sum = 0;
+            for (const auto& value : values) {
+                const auto e = value.as<E<7>>();
+                sum += e.has_value() ? static_cast<std::uint32_t>(*e) : 0;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(as_dynamic);
+
+    /**
+     * Measures the memory of the values of a queue, including the 64-bit enums a variant needs to be able to hold.
+     */
+    void footprint(benchmark::State& state) {
+        enum class Wide : std::uint64_t {};
+        using wide_variant = std::variant<E<0>, E<1>, Wide>;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(sizeof(all_types::variant));
+        }
+        state.counters["variant_bytes"] = sizeof(all_types::variant);
+        state.counters["variant_with_64_bit_bytes"] = sizeof(wide_variant);
+        state.counters["dynamic_bytes"] = sizeof(trak::dynamic_shared_enum);
+    }
+    BENCHMARK(footprint);
+}
+
+BENCHMARK_MAIN();
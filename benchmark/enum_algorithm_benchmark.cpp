@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <trak/enum_algorithm.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+    enum class A : unsigned int {
+        V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11, V12, V13, V14, V15
+    };
+
+    enum class B : unsigned int {
+        V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11, V12, V13, V14, V15
+    };
+
+    using shared = trak::shared_enum<A, B>;
+
+    /**
+     * A draw command bucketed by its state.
+     */
+    struct command {
+        shared state;
+        unsigned int mesh;
+        float depth;
+    };
+
+    std::vector<command> make_commands(std::size_t size) {
+        std::mt19937 engine(1);
+        std::vector<command> commands;
+        commands.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            commands.push_back({static_cast<A>(engine() % 16), static_cast<unsigned int>(i), static_cast<float>(engine() % 1000)});
+        }
+        return commands;
+    }
+
+    shared state_of(const command& value) {
+        return value.state;
+    }
+
+    void sort_commands(benchmark::State& state) {
+        const auto commands = make_commands(state.range(0));
+        auto sorted = commands;
+        for (auto _ : state) {
+            sorted = commands;
+            std::sort(sorted.begin(), sorted.end(), [](const command& lhs, const command& rhs) {
+                return lhs.state < rhs.state;
+            });
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(sort_commands)->Range(1 << 8, 1 << 16);
+
+    void stable_sort_commands(benchmark::State& state) {
+        const auto commands = make_commands(state.range(0));
+        auto sorted = commands;
+        for (auto _ : state) {
+            sorted = commands;
+            std::stable_sort(sorted.begin(), sorted.end(), [](const command& lhs, const command& rhs) {
+                return lhs.state < rhs.state;
+            });
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(stable_sort_commands)->Range(1 << 8, 1 << 16);
+
+    void counting_sort_commands(benchmark::State& state) {
+        const auto commands = make_commands(state.range(0));
+        auto sorted = commands;
+        for (auto _ : state) {
+            sorted = commands;
+            benchmark::DoNotOptimize(trak::counting_sort(sorted.begin(), sorted.end(), state_of));
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(counting_sort_commands)->Range(1 << 8, 1 << 16);
+
+    void partition_commands(benchmark::State& state) {
+        const auto commands = make_commands(state.range(0));
+        auto sorted = commands;
+        for (auto _ : state) {
+            sorted = commands;
+            benchmark::DoNotOptimize(trak::partition_by_enum(sorted.begin(), sorted.end(), state_of));
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(partition_commands)->Range(1 << 8, 1 << 16);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+#include <trak/enum_map.hpp>
+#include <trak/enum_set.hpp>
+
+#include <cstddef>
+#include <map>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    enum class A : unsigned int {
+        V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11, V12, V13, V14, V15, V16, V17, V18, V19, V20, V21, V22, V23,
+        V24, V25, V26, V27, V28, V29, V30, V31, V32, V33, V34, V35, V36, V37, V38, V39, V40, V41, V42, V43, V44, V45,
+        V46, V47, V48, V49, V50, V51, V52, V53, V54, V55, V56, V57, V58, V59, V60, V61, V62, V63
+    };
+
+    enum class B : unsigned int {
+        V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11, V12, V13, V14, V15, V16, V17, V18, V19, V20, V21, V22, V23,
+        V24, V25, V26, V27, V28, V29, V30, V31, V32, V33, V34, V35, V36, V37, V38, V39, V40, V41, V42, V43, V44, V45,
+        V46, V47, V48, V49, V50, V51, V52, V53, V54, V55, V56, V57, V58, V59, V60, V61, V62, V63
+    };
+
+    using shared = trak::shared_enum<A, B>;
+
+    constexpr std::size_t size = 4096;
+
+    /**
+     * Returns size keys randomly chosen from the enumerators of A.
+     */
+    std::vector<shared> make_keys() {
+        std::mt19937 engine(1);
+        std::uniform_int_distribution<unsigned int> distribution(0, 63);
+        std::vector<shared> keys;
+        for (std::size_t i = 0; i < size; ++i) {
+            keys.push_back(static_cast<shared>(distribution(engine)));
+        }
+        return keys;
+    }
+
+    template<typename Map>
+    void lookup_map(benchmark::State& state) {
+        const auto keys = make_keys();
+        Map map;
+        for (unsigned int i = 0; i < 64; ++i) {
+            map[i] = i;
+        }
+        for (auto _ : state) {
+            unsigned int sum = 0;
+            for (auto key : keys) {
+                sum += map[static_cast<unsigned int>(key)];
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK_TEMPLATE(lookup_map, std::map<unsigned int, unsigned int>);
+    BENCHMARK_TEMPLATE(lookup_map, std::unordered_map<unsigned int, unsigned int>);
+
+    void lookup_enum_map(benchmark::State& state) {
+        const auto keys = make_keys();
+        trak::enum_map<A, unsigned int> map;
+        for (unsigned int i = 0; i < 64; ++i) {
+            map[static_cast<A>(i)] = i;
+        }
+        for (auto _ : state) {
+            unsigned int sum = 0;
+            for (auto key : keys) {
+                sum += map[key];
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(lookup_enum_map);
+
+    template<typename Set>
+    void contains_set(benchmark::State& state) {
+        const auto keys = make_keys();
+        Set set;
+        for (unsigned int i = 0; i < 64; i += 3) {
+            set.insert(i);
+        }
+        for (auto _ : state) {
+            std::size_t count = 0;
+            for (auto key : keys) {
+                count += set.count(static_cast<unsigned int>(key));
+            }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK_TEMPLATE(contains_set, std::set<unsigned int>);
+    BENCHMARK_TEMPLATE(contains_set, std::unordered_set<unsigned int>);
+
+    void contains_enum_set(benchmark::State& state) {
+        const auto keys = make_keys();
+        trak::enum_set<A> set;
+        for (unsigned int i = 0; i < 64; i += 3) {
+            set.insert(static_cast<A>(i));
+        }
+        for (auto _ : state) {
+            std::size_t count = 0;
+            for (auto key : keys) {
+                count += set.contains(key);
+            }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(contains_enum_set);
+}
+
+BENCHMARK_MAIN();
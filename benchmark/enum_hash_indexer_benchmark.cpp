@@ -0,0 +1,176 @@
+#include <benchmark/benchmark.h>
+#include <trak/enum_hash_indexer.hpp>
+#include <trak/enum_map.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    enum class Sparse16 : std::uint32_t {};
+    enum class Sparse64 : std::uint32_t {};
+    enum class Sparse512 : std::uint32_t {};
+
+    template<typename E>
+    struct key_count;
+
+    template<>
+    struct key_count<Sparse16> : std::integral_constant<std::size_t, 16> {};
+
+    template<>
+    struct key_count<Sparse64> : std::integral_constant<std::size_t, 64> {};
+
+    template<>
+    struct key_count<Sparse512> : std::integral_constant<std::size_t, 512> {};
+
+    /**
+     * Sparse values of E like the ones of graphics APIs, about 13 apart from 0x8000 on.
+     */
+    template<typename E>
+    struct sparse_values {
+        static constexpr std::array<E, key_count<E>::value> values = [] {
+            std::array<E, key_count<E>::value> values{};
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                values[i] = static_cast<E>(0x8000 + i * 13 + (i * i * 7) % 5);
+            }
+            return values;
+        }();
+    };
+}
+
+template<>
+struct trak::enum_traits<Sparse16> : trak::detail::enum_traits_base<Sparse16, false, sparse_values<Sparse16>> {};
+
+template<>
+struct trak::enum_traits<Sparse64> : trak::detail::enum_traits_base<Sparse64, false, sparse_values<Sparse64>> {};
+
+template<>
+struct trak::enum_traits<Sparse512> : trak::detail::enum_traits_base<Sparse512, false, sparse_values<Sparse512>> {};
+
+template<>
+struct trak::enum_indexer<Sparse16> : trak::enum_hash_indexer<Sparse16> {};
+
+template<>
+struct trak::enum_indexer<Sparse64> : trak::enum_hash_indexer<Sparse64> {};
+
+template<>
+struct trak::enum_indexer<Sparse512> : trak::enum_hash_indexer<Sparse512> {};
+
+namespace {
+    constexpr std::size_t size = 1 << 16;
+
+    /**
+     * Returns size keys of E, one of 4 being no value of E at random, so branches on it are mispredicted. The keys
+     * are too many for branch predictors to learn their sequence.
+     */
+    template<typename E>
+    std::vector<E> make_keys() {
+        std::mt19937 engine(1);
+        std::uniform_int_distribution<std::size_t> distribution(0, key_count<E>::value - 1);
+        std::vector<E> keys;
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto value = sparse_values<E>::values[distribution(engine)];
+            keys.push_back(engine() % 4 == 0 ? static_cast<E>(static_cast<std::uint32_t>(value) + 1) : value);
+        }
+        return keys;
+    }
+
+    template<typename E>
+    void index_hash(benchmark::State& state) {
+        const auto keys = make_keys<E>();
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (auto key : keys) {
+                sum += trak::enum_hash_indexer<E>::index(key);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<typename E>
+    void index_unordered_map(benchmark::State& state) {
+        const auto keys = make_keys<E>();
+        std::unordered_map<std::uint32_t, std::size_t> indices;
+        for (std::size_t i = 0; i < key_count<E>::value; ++i) {
+            indices.emplace(static_cast<std::uint32_t>(sparse_values<E>::values[i]), i);
+        }
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (auto key : keys) {
+                const auto found = indices.find(static_cast<std::uint32_t>(key));
+                sum += found != indices.end() ? found->second : key_count<E>::value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<typename E>
+    void index_binary_search(benchmark::State& state) {
+        const auto keys = make_keys<E>();
+        const auto& values = sparse_values<E>::values;
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (auto key : keys) {
+                const auto found = std::lower_bound(values.begin(), values.end(), key);
+                sum += found != values.end() && *found == key ? static_cast<std::size_t>(found - values.begin()) : values.size();
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<typename E>
+    void lookup_enum_map(benchmark::State& state) {
+        const auto keys = make_keys<E>();
+        trak::enum_map<E, unsigned int> map;
+        for (std::size_t i = 0; i < key_count<E>::value; ++i) {
+            map[sparse_values<E>::values[i]] = static_cast<unsigned int>(i);
+        }
+        for (auto _ : state) {
+            unsigned int sum = 0;
+            for (auto key : keys) {
+                const auto found = map.find(key);
+                sum += found != nullptr ? *found : 0;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<typename E>
+    void lookup_unordered_map(benchmark::State& state) {
+        const auto keys = make_keys<E>();
+        std::unordered_map<E, unsigned int> map;
+        for (std::size_t i = 0; i < key_count<E>::value; ++i) {
+            map[sparse_values<E>::values[i]] = static_cast<unsigned int>(i);
+        }
+        for (auto _ : state) {
+            unsigned int sum = 0;
+            for (auto key : keys) {
+                const auto found = map.find(key);
+                sum += found != map.end() ? found->second : 0;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+#define TRAK_HASH_BENCHMARKS(E) \
+    BENCHMARK_TEMPLATE(index_hash, E); \
+    BENCHMARK_TEMPLATE(index_unordered_map, E); \
+    BENCHMARK_TEMPLATE(index_binary_search, E); \
+    BENCHMARK_TEMPLATE(lookup_enum_map, E); \
+    BENCHMARK_TEMPLATE(lookup_unordered_map, E)
+
+    TRAK_HASH_BENCHMARKS(Sparse16);
+    TRAK_HASH_BENCHMARKS(Sparse64);
+    TRAK_HASH_BENCHMARKS(Sparse512);
+}
+
+BENCHMARK_MAIN();
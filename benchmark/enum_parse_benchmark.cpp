@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include <trak/enum_parse.hpp>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    enum class A : unsigned int {
+        ActiveTexture, AttachShader, BindBuffer, BindFramebuffer, BindRenderbuffer, BindTexture, BlendColor,
+        BlendEquation, BlendFunc, BufferData, BufferSubData, CheckFramebufferStatus, Clear, ClearColor, ClearDepth,
+        ClearStencil, ColorMask, CompileShader, CopyTexImage2D, CreateProgram, CreateShader, CullFace, DeleteBuffers,
+        DeleteFramebuffers, DeleteProgram, DeleteShader, DeleteTextures, DepthFunc, DepthMask, DepthRange,
+        DetachShader, Disable, DrawArrays, DrawElements, Enable, Finish, Flush, FramebufferTexture2D, FrontFace,
+        GenBuffers, GenFramebuffers, GenTextures, GenerateMipmap, GetError, Hint, IsEnabled, LineWidth, LinkProgram,
+        PixelStorei, PolygonOffset, ReadPixels, Scissor, ShaderSource, StencilFunc, StencilMask, StencilOp,
+        TexImage2D, TexParameteri, Uniform1i, Uniform4fv, UniformMatrix4fv, UseProgram, VertexAttribPointer, Viewport
+    };
+
+    enum class B : unsigned int {
+        ActiveTexture, AttachShader, BindBuffer, BindFramebuffer, BindRenderbuffer, BindTexture, BlendColor,
+        BlendEquation, BlendFunc, BufferData, BufferSubData, CheckFramebufferStatus, Clear, ClearColor, ClearDepth,
+        ClearStencil, ColorMask, CompileShader, CopyTexImage2D, CreateProgram, CreateShader, CullFace, DeleteBuffers,
+        DeleteFramebuffers, DeleteProgram, DeleteShader, DeleteTextures, DepthFunc, DepthMask, DepthRange,
+        DetachShader, Disable, DrawArrays, DrawElements, Enable, Finish, Flush, FramebufferTexture2D, FrontFace,
+        GenBuffers, GenFramebuffers, GenTextures, GenerateMipmap, GetError, Hint, IsEnabled, LineWidth, LinkProgram,
+        PixelStorei, PolygonOffset, ReadPixels, Scissor, ShaderSource, StencilFunc, StencilMask, StencilOp,
+        TexImage2D, TexParameteri, Uniform1i, Uniform4fv, UniformMatrix4fv, UseProgram, VertexAttribPointer, Viewport
+    };
+
+    using shared = trak::shared_enum<A, B>;
+
+    constexpr std::size_t size = 4096;
+
+    /**
+     * Returns size tokens randomly chosen from the names of A, of which about one in ten is unknown.
+     */
+    std::vector<std::string> make_tokens() {
+        const auto& names = trak::enum_reflection<A>::names;
+        std::mt19937 engine(42);
+        std::uniform_int_distribution<std::size_t> distribution(0, names.size() + names.size() / 10);
+        std::vector<std::string> tokens;
+        tokens.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto index = distribution(engine);
+            tokens.emplace_back(index < names.size() ? std::string(names[index]) : "Unknown" + std::to_string(index));
+        }
+        return tokens;
+    }
+
+    void parse_perfect_hash(benchmark::State& state) {
+        const auto tokens = make_tokens();
+        for (auto _ : state) {
+            unsigned int sum = 0;
+            for (const auto& token : tokens) {
+                auto value = trak::parse<shared>(token);
+                sum += value ? static_cast<unsigned int>(static_cast<A>(*value)) : 0;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(parse_perfect_hash);
+
+    void parse_unordered_map_string(benchmark::State& state) {
+        std::unordered_map<std::string, unsigned int> map;
+        for (std::size_t i = 0; i < trak::enum_reflection<A>::size; ++i) {
+            map.emplace(trak::enum_reflection<A>::names[i], static_cast<unsigned int>(trak::enum_reflection<A>::values[i]));
+        }
+        const auto tokens = make_tokens();
+        std::vector<std::string_view> views(tokens.begin(), tokens.end());
+        for (auto _ : state) {
+            unsigned int sum = 0;
+            for (auto token : views) {
+                auto it = map.find(std::string(token));
+                sum += it != map.end() ? it->second : 0;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(parse_unordered_map_string);
+
+    void parse_unordered_map_string_view(benchmark::State& state) {
+        std::unordered_map<std::string_view, unsigned int> map;
+        for (std::size_t i = 0; i < trak::enum_reflection<A>::size; ++i) {
+            map.emplace(trak::enum_reflection<A>::names[i], static_cast<unsigned int>(trak::enum_reflection<A>::values[i]));
+        }
+        const auto tokens = make_tokens();
+        for (auto _ : state) {
+            unsigned int sum = 0;
+            for (const auto& token : tokens) {
+                auto it = map.find(token);
+                sum += it != map.end() ? it->second : 0;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(parse_unordered_map_string_view);
+}
+
+BENCHMARK_MAIN();
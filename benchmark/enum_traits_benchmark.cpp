@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <trak/enum_traits.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+    enum class A : std::uint16_t {
+        V1 = 1, V2, V3, V4, V5, V6, V7, V8, V100 = 100, V101, V102
+    };
+
+    enum class B : std::uint16_t {
+        V1 = 1, V2, V3, V4, V5, V6, V7, V8, V100 = 100, V101, V102, V200 = 200
+    };
+
+    enum class F : std::uint16_t {
+        F0 = 1, F1 = 2, F2 = 4, F3 = 8
+    };
+
+    using shared = trak::shared_enum<A, B>;
+    using bits = trak::shared_bitfield<F>;
+
+    constexpr std::size_t size = 1 << 22;
+
+    std::vector<std::uint16_t> make_values() {
+        constexpr std::uint16_t valid[] = {1, 2, 3, 4, 5, 6, 7, 8, 100, 101, 102};
+        std::mt19937 engine(1);
+        std::vector<std::uint16_t> values(size);
+        for (auto& value : values) {
+            value = valid[engine() % 11];
+        }
+        return values;
+    }
+
+    std::vector<std::uint16_t> make_flags() {
+        std::mt19937 engine(1);
+        std::vector<std::uint16_t> values(size);
+        for (auto& value : values) {
+            value = static_cast<std::uint16_t>(engine() & 15);
+        }
+        return values;
+    }
+
+    std::size_t validate_switch(const std::vector<std::uint16_t>& values) {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            switch (values[i]) {
+                case 1: case 2: case 3: case 4: case 5: case 6: case 7: case 8: case 100: case 101: case 102:
+                    break;
+                default:
+                    return i;
+            }
+        }
+        return values.size();
+    }
+
+    void copy_baseline(benchmark::State& state) {
+        const auto values = make_values();
+        std::vector<std::uint16_t> out(size);
+        for (auto _ : state) {
+            std::memcpy(out.data(), values.data(), size * sizeof(std::uint16_t));
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * size * sizeof(std::uint16_t));
+    }
+    BENCHMARK(copy_baseline);
+
+    void validate_switch(benchmark::State& state) {
+        const auto values = make_values();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(validate_switch(values));
+        }
+        state.SetBytesProcessed(state.iterations() * size * sizeof(std::uint16_t));
+    }
+    BENCHMARK(validate_switch);
+
+    void validate_shared(benchmark::State& state) {
+        const auto values = make_values();
+        const auto& kernels = trak::detail::validate_kernels_for<std::uint16_t>(static_cast<trak::detail::simd_level>(state.range(0)));
+        constexpr auto intervals = trak::detail::make_value_intervals<std::uint16_t, A, B>();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(kernels.first_outside(values.data(), values.size(), intervals.first.data(), intervals.extent.data(), intervals.size));
+        }
+        state.SetBytesProcessed(state.iterations() * size * sizeof(std::uint16_t));
+    }
+    BENCHMARK(validate_shared)->DenseRange(0, static_cast<int>(trak::detail::detect_simd_level()));
+
+    void validate_bitfield(benchmark::State& state) {
+        const auto values = make_flags();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(trak::validate<bits>(trak::span<const std::uint16_t>(values)));
+        }
+        state.SetBytesProcessed(state.iterations() * size * sizeof(std::uint16_t));
+    }
+    BENCHMARK(validate_bitfield);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <trak/instrumentation.hpp>
+#include <trak/shared_enum.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+    enum class A : std::uint32_t {
+        V0, V1, V2, V3, V4, V5, V6, V7
+    };
+
+    enum class B : std::uint32_t {
+        V0, V1, V2, V3, V4, V5, V6, V7
+    };
+
+    using shared = trak::shared_enum<A, B>;
+
+    constexpr std::size_t size = 4096;
+
+    std::vector<shared> make_values() {
+        std::mt19937 engine(1);
+        std::vector<shared> values;
+        for (std::size_t i = 0; i < size; ++i) {
+            values.push_back(shared(static_cast<std::uint32_t>(engine() % 8)));
+        }
+        return values;
+    }
+
+    // Built twice, as trak_instrument_benchmark with TRAK_INSTRUMENT 0, and as trak_instrument_on_benchmark
+    // with TRAK_INSTRUMENT 1, such that the overhead is the difference of both runs.
+
+    void convert(benchmark::State& state) {
+        const auto values = make_values();
+        for (auto _ : state) {
+            std::uint32_t sum = 0;
+            for (auto value : values) {
+                B converted = value;
+                sum += static_cast<std::uint32_t>(converted);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(convert)->ThreadRange(1, 8);
+
+    void compare(benchmark::State& state) {
+        const auto values = make_values();
+        for (auto _ : state) {
+            std::uint32_t count = 0;
+            for (auto value : values) {
+                count += value == A::V3;
+            }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(compare)->ThreadRange(1, 8);
+
+    void report(benchmark::State& state) {
+        const auto values = make_values();
+        for (auto value : values) {
+            benchmark::DoNotOptimize(value == A::V3);
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(trak::instrument_report());
+        }
+    }
+    BENCHMARK(report);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <trak/packed_enum_vector.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+    enum class A : unsigned int {
+        V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11
+    };
+
+    enum class B : unsigned int {
+        V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11
+    };
+
+    using shared = trak::shared_enum<A, B>;
+
+    constexpr std::size_t size = 1 << 20;
+
+    std::vector<shared> make_values() {
+        std::mt19937 engine(1);
+        std::vector<shared> values;
+        values.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            values.push_back(static_cast<A>(engine() % 12));
+        }
+        return values;
+    }
+
+    trak::packed_enum_vector<shared> make_packed() {
+        trak::packed_enum_vector<shared> packed;
+        packed.reserve(size);
+        for (auto value : make_values()) {
+            packed.push_back(value);
+        }
+        return packed;
+    }
+
+    void decode_vector(benchmark::State& state) {
+        const auto values = make_values();
+        std::vector<shared> out(size, A::V0);
+        for (auto _ : state) {
+            out.assign(values.begin(), values.end());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        state.counters["bytes_per_value"] = static_cast<double>(values.capacity() * sizeof(shared)) / size;
+    }
+    BENCHMARK(decode_vector);
+
+    void decode_packed(benchmark::State& state) {
+        const auto packed = make_packed();
+        std::vector<shared> out(size, A::V0);
+        for (auto _ : state) {
+            packed.unpack(0, size, out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        state.counters["bytes_per_value"] = static_cast<double>(packed.memory_usage()) / size;
+    }
+    BENCHMARK(decode_packed);
+
+    void decode_packed_indexed(benchmark::State& state) {
+        const auto packed = make_packed();
+        std::vector<shared> out(size, A::V0);
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < size; ++i) {
+                out[i] = packed[i];
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(decode_packed_indexed);
+
+    void unpack_kernel(benchmark::State& state) {
+        const auto kernel = trak::detail::unpack_kernel_for(static_cast<trak::detail::simd_level>(state.range(0)));
+        const auto packed = make_packed();
+        std::vector<unsigned char> bytes(size * packed.width / 8 + 8);
+        std::vector<std::uint32_t> out(size);
+        for (auto _ : state) {
+            kernel(bytes.data(), 0, size, packed.width, out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    // Registers the kernel of each instruction set supported by this CPU, with the simd_level as argument.
+    const bool registered = [] {
+        for (int level = 0; level <= static_cast<int>(trak::detail::detect_simd_level()); ++level) {
+            benchmark::RegisterBenchmark("unpack_kernel", unpack_kernel)->Arg(level);
+        }
+        return true;
+    }();
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <trak/mapped_file.hpp>
+#include <trak/serialization.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    enum class A : std::uint32_t {
+        V0, V1, V2, V3, V4, V5, V6, V7
+    };
+
+    enum class B : std::uint32_t {
+        V0, V1, V2, V3
+    };
+
+    using shared = trak::shared_enum<A, B>;
+
+    constexpr std::size_t size = 1 << 22;
+    constexpr const char* path = "trak_serialization_benchmark.bin";
+
+    std::vector<shared> make_values() {
+        std::mt19937 engine(1);
+        std::vector<shared> values;
+        values.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            values.push_back(static_cast<A>(engine() % 8));
+        }
+        return values;
+    }
+
+    void write_file(trak::endian order) {
+        const auto values = make_values();
+        trak::enum_stream_writer<shared> writer(order);
+        writer.open(path);
+        writer.write(trak::span<const shared>(values));
+        writer.close();
+    }
+
+    std::uint64_t sum(trak::span<const shared> values) {
+        std::uint64_t sum = 0;
+        for (auto value : values) {
+            sum += static_cast<std::uint32_t>(value);
+        }
+        return sum;
+    }
+
+    void write_stream(benchmark::State& state) {
+        const auto values = make_values();
+        const auto order = static_cast<trak::endian>(state.range(0));
+        for (auto _ : state) {
+            trak::enum_stream_writer<shared> writer(order);
+            writer.open(path);
+            writer.write(trak::span<const shared>(values));
+            if (writer.close() != trak::stream_error::none) {
+                state.SkipWithError("write failed");
+            }
+        }
+        state.SetBytesProcessed(state.iterations() * size * sizeof(shared));
+        std::remove(path);
+    }
+    BENCHMARK(write_stream)->Arg(static_cast<int>(trak::endian::native))
+            ->Arg(static_cast<int>(trak::endian::native == trak::endian::little ? trak::endian::big : trak::endian::little));
+
+    void read_stream(benchmark::State& state) {
+        write_file(static_cast<trak::endian>(state.range(0)));
+        std::vector<shared> buffer(1 << 14, A::V0);
+        for (auto _ : state) {
+            trak::enum_stream_reader<shared> reader;
+            reader.open(path);
+            std::uint64_t total = 0;
+            while (auto n = reader.read(trak::span<shared>(buffer))) {
+                total += sum(trak::span<const shared>(buffer.data(), n));
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetBytesProcessed(state.iterations() * size * sizeof(shared));
+        std::remove(path);
+    }
+    BENCHMARK(read_stream)->Arg(static_cast<int>(trak::endian::native))
+            ->Arg(static_cast<int>(trak::endian::native == trak::endian::little ? trak::endian::big : trak::endian::little));
+
+#if TRAK_HAS_MAPPED_FILE
+    void read_mapped(benchmark::State& state) {
+        write_file(trak::endian::native);
+        for (auto _ : state) {
+            trak::mapped_file file;
+            file.open(path);
+            trak::span<const shared> values;
+            if (trak::view_enum_stream(file.bytes(), values) != trak::stream_error::none) {
+                state.SkipWithError("view failed");
+            }
+            benchmark::DoNotOptimize(sum(values));
+        }
+        state.SetBytesProcessed(state.iterations() * size * sizeof(shared));
+        std::remove(path);
+    }
+    BENCHMARK(read_mapped);
+#endif
+}
+
+BENCHMARK_MAIN();
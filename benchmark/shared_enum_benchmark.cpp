@@ -0,0 +1,225 @@
+#include <benchmark/benchmark.h>
+#include <trak/shared_bitfield.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+enum class A : unsigned int {
+    First = 1,
+    Second = 2,
+    Third = 4
+};
+
+enum class B : unsigned int {
+    First = 1,
+    Second = 2,
+    Third = 4
+};
+
+enum class NarrowA : std::uint8_t {
+    First = 1,
+    Second = 2,
+    Third = 4
+};
+
+enum class NarrowB : std::uint16_t {
+    First = 1,
+    Second = 2,
+    Third = 4
+};
+
+constexpr inline A operator|(A a, A b) {
+    return static_cast<A>(static_cast<unsigned int>(a) | static_cast<unsigned int>(b));
+}
+
+constexpr std::size_t size = 4096;
+
+unsigned int takes_A(A value) {
+    return static_cast<unsigned int>(value);
+}
+
+unsigned int takes_int(unsigned int value) {
+    return value;
+}
+
+/**
+ * Returns size values randomly chosen from First, Second and Third, converted to T.
+ */
+template<typename T>
+std::vector<T> make_values() {
+    std::mt19937 engine(42);
+    std::uniform_int_distribution<unsigned int> distribution(0, 2);
+    std::vector<T> values;
+    values.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        values.push_back(static_cast<T>(1u << distribution(engine)));
+    }
+    return values;
+}
+
+void pass_raw_int(benchmark::State& state) {
+    auto values = make_values<unsigned int>();
+    for (auto _ : state) {
+        unsigned int sum = 0;
+        for (auto value : values) {
+            sum += takes_int(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(pass_raw_int);
+
+void pass_raw_enum(benchmark::State& state) {
+    auto values = make_values<A>();
+    for (auto _ : state) {
+        unsigned int sum = 0;
+        for (auto value : values) {
+            sum += takes_A(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(pass_raw_enum);
+
+void pass_shared_enum(benchmark::State& state) {
+    auto values = make_values<trak::shared_enum<A, B>>();
+    for (auto _ : state) {
+        unsigned int sum = 0;
+        for (auto value : values) {
+            sum += takes_A(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(pass_shared_enum);
+
+void or_raw_int(benchmark::State& state) {
+    auto values = make_values<unsigned int>();
+    for (auto _ : state) {
+        unsigned int mask = 0;
+        for (auto value : values) {
+            mask = mask | value;
+        }
+        benchmark::DoNotOptimize(mask);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(or_raw_int);
+
+void or_raw_enum(benchmark::State& state) {
+    auto values = make_values<A>();
+    for (auto _ : state) {
+        A mask = A::First;
+        for (auto value : values) {
+            mask = mask | value;
+        }
+        benchmark::DoNotOptimize(mask);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(or_raw_enum);
+
+void or_shared_bitfield(benchmark::State& state) {
+    auto values = make_values<trak::shared_bitfield<A, B>>();
+    for (auto _ : state) {
+        trak::shared_bitfield<A, B> mask = A::First;
+        for (auto value : values) {
+            mask = mask | value;
+        }
+        benchmark::DoNotOptimize(mask);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(or_shared_bitfield);
+
+void compare_raw_int(benchmark::State& state) {
+    auto values = make_values<unsigned int>();
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (auto value : values) {
+            count += value == 2u;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(compare_raw_int);
+
+void compare_raw_enum(benchmark::State& state) {
+    auto values = make_values<A>();
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (auto value : values) {
+            count += value == A::Second;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(compare_raw_enum);
+
+void compare_shared_enum(benchmark::State& state) {
+    auto values = make_values<trak::shared_enum<A, B>>();
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (auto value : values) {
+            count += value == A::Second;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(compare_shared_enum);
+
+constexpr std::size_t large_size = 1u << 22u;
+
+/**
+ * Returns large_size values randomly chosen from First, Second and Third of E, converted to T, which exceed the
+ * caches for 32-bit values.
+ */
+template<typename T, typename E>
+std::vector<T> make_large_values() {
+    std::mt19937 engine(42);
+    std::uniform_int_distribution<unsigned int> distribution(0, 2);
+    std::vector<T> values;
+    values.reserve(large_size);
+    for (std::size_t i = 0; i < large_size; ++i) {
+        values.push_back(static_cast<E>(1u << distribution(engine)));
+    }
+    return values;
+}
+
+void scan_wide_shared_enum(benchmark::State& state) {
+    auto values = make_large_values<trak::shared_enum<A, B>, A>();
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (auto value : values) {
+            count += value == A::Second;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * large_size);
+    state.SetBytesProcessed(state.iterations() * large_size * sizeof(values[0]));
+}
+BENCHMARK(scan_wide_shared_enum);
+
+void scan_narrow_shared_enum(benchmark::State& state) {
+    auto values = make_large_values<trak::shared_enum<A, NarrowA, NarrowB>, NarrowA>();
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (auto value : values) {
+            count += value == A::Second;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * large_size);
+    state.SetBytesProcessed(state.iterations() * large_size * sizeof(values[0]));
+}
+BENCHMARK(scan_narrow_shared_enum);
+
+BENCHMARK_MAIN();
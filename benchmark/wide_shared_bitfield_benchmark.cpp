@@ -0,0 +1,248 @@
+#include <benchmark/benchmark.h>
+#include <trak/shared_bitfield.hpp>
+#include <trak/wide_shared_bitfield.hpp>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+    enum class A : std::uint16_t {};
+    enum class B : std::uint16_t {};
+
+    enum class SplitA : std::uint64_t {};
+    enum class SplitB : std::uint64_t {};
+
+    template<std::size_t N>
+    using wide = trak::wide_shared_bitfield<N, A, B>;
+
+    /**
+     * A flag set of N bits split by hand across shared bitfields of 64 bits.
+     */
+    template<std::size_t N>
+    using split = std::array<trak::shared_bitfield<SplitA, SplitB>, N / 64>;
+
+    constexpr std::size_t size = 1 << 10;
+
+    /**
+     * Returns the split flag set without flags set.
+     */
+    template<std::size_t N, std::size_t... Is>
+    split<N> empty_split(std::index_sequence<Is...>) {
+        return {{(static_cast<void>(Is), trak::shared_bitfield<SplitA, SplitB>(SplitA{}))...}};
+    }
+
+    template<std::size_t N>
+    split<N> empty_split() {
+        return empty_split<N>(std::make_index_sequence<N / 64>());
+    }
+
+    /**
+     * Returns the indices of the flags of size sets of N flags, each having 1 of 16 flags set on average.
+     */
+    template<std::size_t N>
+    std::vector<std::vector<std::size_t>> make_flags() {
+        std::mt19937 engine(1);
+        std::vector<std::vector<std::size_t>> flags(size);
+        for (auto& set : flags) {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (engine() % 16 == 0) {
+                    set.push_back(i);
+                }
+            }
+        }
+        return flags;
+    }
+
+    template<std::size_t N>
+    std::vector<wide<N>> make_wide() {
+        std::vector<wide<N>> values(size);
+        const auto flags = make_flags<N>();
+        for (std::size_t i = 0; i < size; ++i) {
+            for (auto flag : flags[i]) {
+                values[i].set(static_cast<A>(flag));
+            }
+        }
+        return values;
+    }
+
+    template<std::size_t N>
+    std::vector<std::bitset<N>> make_bitset() {
+        std::vector<std::bitset<N>> values(size);
+        const auto flags = make_flags<N>();
+        for (std::size_t i = 0; i < size; ++i) {
+            for (auto flag : flags[i]) {
+                values[i].set(flag);
+            }
+        }
+        return values;
+    }
+
+    template<std::size_t N>
+    std::vector<split<N>> make_split() {
+        std::vector<split<N>> values(size, empty_split<N>());
+        const auto flags = make_flags<N>();
+        for (std::size_t i = 0; i < size; ++i) {
+            for (auto flag : flags[i]) {
+                auto& part = values[i][flag / 64];
+                part |= trak::shared_bitfield<SplitA, SplitB>(static_cast<SplitA>(std::uint64_t{1} << (flag % 64)));
+            }
+        }
+        return values;
+    }
+
+    template<std::size_t N>
+    void or_wide(benchmark::State& state) {
+        const auto values = make_wide<N>();
+        for (auto _ : state) {
+            wide<N> result;
+            for (const auto& value : values) {
+                result |= value;
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<std::size_t N>
+    void or_bitset(benchmark::State& state) {
+        const auto values = make_bitset<N>();
+        for (auto _ : state) {
+            std::bitset<N> result;
+            for (const auto& value : values) {
+                result |= value;
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<std::size_t N>
+    void or_split(benchmark::State& state) {
+        const auto values = make_split<N>();
+        for (auto _ : state) {
+            auto result = empty_split<N>();
+            for (const auto& value : values) {
+                for (std::size_t i = 0; i < N / 64; ++i) {
+                    result[i] |= value[i];
+                }
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<std::size_t N>
+    void count_wide(benchmark::State& state) {
+        const auto values = make_wide<N>();
+        for (auto _ : state) {
+            std::size_t result = 0;
+            for (const auto& value : values) {
+                result += value.count();
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<std::size_t N>
+    void count_bitset(benchmark::State& state) {
+        const auto values = make_bitset<N>();
+        for (auto _ : state) {
+            std::size_t result = 0;
+            for (const auto& value : values) {
+                result += value.count();
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<std::size_t N>
+    void count_split(benchmark::State& state) {
+        const auto values = make_split<N>();
+        for (auto _ : state) {
+            std::size_t result = 0;
+            for (const auto& value : values) {
+                for (const auto& part : value) {
+                    result += trak::detail::popcount64(static_cast<std::uint64_t>(static_cast<SplitA>(part)));
+                }
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    /**
+     * Counts the sets having a flag in common with a mask of one flag in the last word, so every word is tested.
+     */
+    template<std::size_t N>
+    void intersects_wide(benchmark::State& state) {
+        const auto values = make_wide<N>();
+        const wide<N> mask = static_cast<A>(N - 1);
+        for (auto _ : state) {
+            std::size_t result = 0;
+            for (const auto& value : values) {
+                result += (value & mask).any();
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<std::size_t N>
+    void intersects_bitset(benchmark::State& state) {
+        const auto values = make_bitset<N>();
+        std::bitset<N> mask;
+        mask.set(N - 1);
+        for (auto _ : state) {
+            std::size_t result = 0;
+            for (const auto& value : values) {
+                result += (value & mask).any();
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    template<std::size_t N>
+    void intersects_split(benchmark::State& state) {
+        const auto values = make_split<N>();
+        auto mask = empty_split<N>();
+        mask[N / 64 - 1] = trak::shared_bitfield<SplitA, SplitB>(static_cast<SplitA>(std::uint64_t{1} << 63));
+        for (auto _ : state) {
+            std::size_t result = 0;
+            for (const auto& value : values) {
+                bool any = false;
+                for (std::size_t i = 0; i < N / 64; ++i) {
+                    any |= static_cast<std::uint64_t>(static_cast<SplitA>(value[i] & mask[i])) != 0;
+                }
+                result += any;
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+#define TRAK_WIDE_BENCHMARKS(N) \
+    BENCHMARK_TEMPLATE(or_wide, N); \
+    BENCHMARK_TEMPLATE(or_bitset, N); \
+    BENCHMARK_TEMPLATE(or_split, N); \
+    BENCHMARK_TEMPLATE(count_wide, N); \
+    BENCHMARK_TEMPLATE(count_bitset, N); \
+    BENCHMARK_TEMPLATE(count_split, N); \
+    BENCHMARK_TEMPLATE(intersects_wide, N); \
+    BENCHMARK_TEMPLATE(intersects_bitset, N); \
+    BENCHMARK_TEMPLATE(intersects_split, N)
+
+    TRAK_WIDE_BENCHMARKS(128);
+    TRAK_WIDE_BENCHMARKS(256);
+    TRAK_WIDE_BENCHMARKS(512);
+    TRAK_WIDE_BENCHMARKS(2048);
+}
+
+BENCHMARK_MAIN();
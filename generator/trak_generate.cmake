@@ -0,0 +1,59 @@
+find_package(Python3 COMPONENTS Interpreter QUIET)
+
+set(TRAK_GENERATE_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/trak_generate.py CACHE INTERNAL "")
+
+# trak_generate_registry(<target> REGISTRY <file> OUTPUT_DIR <dir> [NAMESPACE <namespace>] [MONOLITHIC])
+#
+# Creates the interface library <target>, whose include directory holds the enums and shared enum constants
+# generated from the JSON or XML registry file, and which links to trak, and the utility target <target>_generate
+# generating the headers. They are regenerated when the registry changes. Only headers whose content changed are
+# rewritten, so only the translation units including them are recompiled.
+#
+# CMake 3.19 and newer generate the headers before building the targets linking to <target>. With older versions,
+# the consuming targets need to depend on <target>_generate with add_dependencies.
+function(trak_generate_registry target)
+    cmake_parse_arguments(ARG "MONOLITHIC" "REGISTRY;OUTPUT_DIR;NAMESPACE" "" ${ARGN})
+    if (NOT Python3_FOUND)
+        message(FATAL_ERROR "trak_generate_registry requires a Python 3 interpreter")
+    endif ()
+    if (NOT ARG_REGISTRY OR NOT ARG_OUTPUT_DIR)
+        message(FATAL_ERROR "trak_generate_registry requires REGISTRY and OUTPUT_DIR")
+    endif ()
+    get_filename_component(registry ${ARG_REGISTRY} ABSOLUTE)
+
+    set(args --registry ${registry} --output ${ARG_OUTPUT_DIR})
+    if (ARG_NAMESPACE)
+        list(APPEND args --namespace ${ARG_NAMESPACE})
+    endif ()
+    if (ARG_MONOLITHIC)
+        list(APPEND args --monolithic)
+    endif ()
+
+    # The outputs depend on the registry, so it is re-read when the registry changes.
+    execute_process(
+            COMMAND ${Python3_EXECUTABLE} ${TRAK_GENERATE_SCRIPT} ${args} --list-outputs
+            OUTPUT_VARIABLE outputs
+            RESULT_VARIABLE result)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "trak_generate_registry failed to read ${registry}")
+    endif ()
+    string(STRIP "${outputs}" outputs)
+    string(REPLACE "\n" ";" outputs "${outputs}")
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${registry})
+
+    set(stamp ${CMAKE_CURRENT_BINARY_DIR}/${target}_generate.stamp)
+    add_custom_command(
+            OUTPUT ${stamp}
+            BYPRODUCTS ${outputs}
+            COMMAND Python3::Interpreter ${TRAK_GENERATE_SCRIPT} ${args}
+            COMMAND ${CMAKE_COMMAND} -E touch ${stamp}
+            DEPENDS ${registry} ${TRAK_GENERATE_SCRIPT}
+            COMMENT "Generating shared enum constants from ${ARG_REGISTRY}"
+            VERBATIM)
+    add_custom_target(${target}_generate DEPENDS ${stamp})
+
+    add_library(${target} INTERFACE)
+    target_include_directories(${target} INTERFACE ${ARG_OUTPUT_DIR})
+    target_link_libraries(${target} INTERFACE trak)
+    add_dependencies(${target} ${target}_generate)
+endfunction()
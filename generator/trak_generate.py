@@ -0,0 +1,311 @@
+#!/usr/bin/env python3
+"""
+Generates enum classes and shared enum constants from a registry of enums.
+
+The registry lists enums with their underlying type and values, as JSON:
+
+  {
+    "namespace": "gl",
+    "underlying_type": "unsigned int",
+    "enums": [
+      {"name": "AttribMask", "bitfield": true, "values": [{"name": "DEPTH_BUFFER_BIT", "value": "0x100"}, ...]},
+      ...
+    ]
+  }
+
+or as XML:
+
+  <registry namespace="gl" underlying_type="unsigned int">
+    <enum name="AttribMask" bitfield="true">
+      <value name="DEPTH_BUFFER_BIT" value="0x100"/>
+    </enum>
+  </registry>
+
+Each value name becomes a constant in the namespace. A name of one enum is a constant of that enum, and a name
+shared by several enums is a trak::shared_enum of them, or a trak::shared_bitfield if they all are bitfields. The
+types of shared constants are listed in canonical order. Shared names need to have the same value in each enum.
+The enums sharing them may have different underlying types, and the value needs to fit each of them.
+
+The outputs, relative to the output directory, are:
+
+  <ns>/fwd.hpp           opaque declarations of all enums,
+  <ns>/types/<E>.hpp     the definition of the enum E,
+  <ns>/values/<E>.hpp    the constants whose first enum in registry order is E, declaring the enums they use,
+  <ns>/<E>.hpp           the definition of E and the constants convertible to E, including the value headers they
+                         are declared in,
+  <ns>/all.hpp           all constants.
+
+The value headers do not include the definitions of the enums, so adding a value to an enum only recompiles the code
+including the headers of the enums sharing a value with it.
+
+With --monolithic, a single header <ns>/<ns>.hpp holding all enums and constants is generated instead.
+
+Outputs are only written if their content changed, so their timestamps only change if they did, and outputs of
+a previous run which are no longer generated are removed.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+import xml.etree.ElementTree
+
+MANIFEST = '.trak_generated'
+
+
+class RegistryError(Exception):
+    pass
+
+
+class Enum:
+    def __init__(self, name, underlying_type, bitfield, values):
+        self.name = name
+        self.underlying_type = underlying_type
+        self.bitfield = bitfield
+        self.values = values
+
+
+def parse_value(value):
+    return value if isinstance(value, int) else int(str(value), 0)
+
+
+def parse_bool(value):
+    return value if isinstance(value, bool) else str(value).lower() in ('1', 'true', 'yes')
+
+
+def load_registry(path):
+    """Returns the namespace and the enums of the registry at path."""
+    if path.endswith('.xml'):
+        root = xml.etree.ElementTree.parse(path).getroot()
+        data = {
+            'namespace': root.get('namespace'),
+            'underlying_type': root.get('underlying_type'),
+            'enums': [{
+                'name': node.get('name'),
+                'underlying_type': node.get('underlying_type'),
+                'bitfield': node.get('bitfield', 'false'),
+                'values': [{'name': value.get('name'), 'value': value.get('value')} for value in node.findall('value')],
+            } for node in root.findall('enum')],
+        }
+    else:
+        with open(path) as f:
+            data = json.load(f)
+
+    default_type = data.get('underlying_type') or 'unsigned int'
+    enums = []
+    for entry in data.get('enums', []):
+        values = [(value['name'], parse_value(value['value'])) for value in entry.get('values', [])]
+        enums.append(Enum(entry['name'], entry.get('underlying_type') or default_type,
+                          parse_bool(entry.get('bitfield', False)), values))
+    return data.get('namespace'), enums
+
+
+class Constant:
+    def __init__(self, name, value, enums):
+        self.name = name
+        self.value = value
+        self.enums = enums
+
+    def type(self):
+        if len(self.enums) == 1:
+            return self.enums[0].name
+        template = 'shared_bitfield' if all(enum.bitfield for enum in self.enums) else 'shared_enum'
+        return 'trak::%s<%s>' % (template, ', '.join(sorted(enum.name for enum in self.enums)))
+
+
+def collect_constants(enums):
+    """Returns the constants in registry order, each listing the enums sharing its name in registry order."""
+    identifier = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+    types = set()
+    for enum in enums:
+        if not identifier.match(enum.name):
+            raise RegistryError('invalid enum name "%s"' % enum.name)
+        if enum.name in types or enum.name in ('fwd', 'all'):
+            raise RegistryError('duplicate or reserved enum name "%s"' % enum.name)
+        types.add(enum.name)
+
+    constants = {}
+    for enum in enums:
+        seen = set()
+        for name, value in enum.values:
+            if not identifier.match(name):
+                raise RegistryError('invalid value name "%s" in enum %s' % (name, enum.name))
+            if name in seen:
+                raise RegistryError('duplicate value %s in enum %s' % (name, enum.name))
+            seen.add(name)
+            if name in types:
+                raise RegistryError('value %s of enum %s has the name of an enum' % (name, enum.name))
+            constant = constants.get(name)
+            if constant is None:
+                constants[name] = Constant(name, value, [enum])
+                continue
+            if constant.value != value:
+                raise RegistryError('value %s is %d in enum %s, but %d in enum %s'
+                                    % (name, value, enum.name, constant.value, constant.enums[0].name))
+            constant.enums.append(enum)
+    return list(constants.values())
+
+
+def format_value(enum, value):
+    return '0x%x' % value if enum.bitfield and value >= 0 else str(value)
+
+
+def enum_definition(enum, indent):
+    lines = ['%senum class %s : %s {' % (indent, enum.name, enum.underlying_type)]
+    for i, (name, value) in enumerate(enum.values):
+        lines.append('%s    %s = %s%s' % (indent, name, format_value(enum, value), ',' if i + 1 < len(enum.values) else ''))
+    lines.append('%s};' % indent)
+    return lines
+
+
+def constant_definition(constant, indent):
+    return '%sconstexpr inline %s %s = %s::%s;' % (indent, constant.type(), constant.name, constant.enums[0].name, constant.name)
+
+
+def header(namespace, path, source, includes, body):
+    guard = re.sub(r'[^A-Za-z0-9]', '_', path).upper()
+    lines = ['// Generated by trak_generate.py from %s. Do not edit.' % source,
+             '#ifndef %s' % guard, '#define %s' % guard, '']
+    if includes:
+        lines.extend('#include %s' % include for include in includes)
+        lines.append('')
+    if body:
+        lines.append('namespace %s {' % namespace)
+        lines.extend(body)
+        lines.extend(['}', ''])
+    lines.extend(['#endif //%s' % guard, ''])
+    return '\n'.join(lines)
+
+
+def generate_split(namespace, directory, enums, constants, source):
+    """Returns a dictionary of output paths relative to the output directory to their content."""
+    outputs = {}
+    outputs['%s/fwd.hpp' % directory] = header(
+        namespace, '%s/fwd.hpp' % directory, source, ['<cstdint>'],
+        ['    enum class %s : %s;' % (enum.name, enum.underlying_type) for enum in enums])
+
+    for enum in enums:
+        path = '%s/types/%s.hpp' % (directory, enum.name)
+        outputs[path] = header(namespace, path, source, ['<cstdint>'], enum_definition(enum, '    '))
+
+    # Each constant is declared in the value header of its first enum.
+    groups = {enum.name: [] for enum in enums}
+    for constant in constants:
+        groups[constant.enums[0].name].append(constant)
+    # The value headers only declare the enums they use, whose values are cast, such that they do not depend on the
+    # definitions of the enums.
+    for enum in enums:
+        path = '%s/values/%s.hpp' % (directory, enum.name)
+        members = groups[enum.name]
+        used = [other for other in enums if other is enum or any(other in constant.enums for constant in members)]
+        includes = ['<cstdint>']
+        if any(len(constant.enums) > 1 for constant in members):
+            includes.append('<trak/shared_bitfield.hpp>')
+        body = ['    enum class %s : %s;' % (other.name, other.underlying_type) for other in used]
+        if members:
+            body.append('')
+            body.extend('    constexpr inline %s %s = static_cast<%s>(%s);'
+                        % (c.type(), c.name, enum.name, format_value(enum, c.value)) for c in members)
+        outputs[path] = header(namespace, path, source, includes, body)
+
+    for enum in enums:
+        path = '%s/%s.hpp' % (directory, enum.name)
+        owners = []
+        for constant in constants:
+            owner = constant.enums[0].name
+            if enum in constant.enums and owner not in owners:
+                owners.append(owner)
+        includes = ['"%s/types/%s.hpp"' % (directory, enum.name)]
+        includes.extend('"%s/values/%s.hpp"' % (directory, owner) for owner in sorted(owners or [enum.name]))
+        outputs[path] = header(namespace, path, source, includes, [])
+
+    path = '%s/all.hpp' % directory
+    outputs[path] = header(namespace, path, source, ['"%s/%s.hpp"' % (directory, enum.name) for enum in enums], [])
+    return outputs
+
+
+def generate_monolithic(namespace, directory, enums, constants, source):
+    body = []
+    for enum in enums:
+        body.extend(enum_definition(enum, '    '))
+        body.append('')
+    body.extend(constant_definition(constant, '    ') for constant in constants)
+    path = '%s/%s.hpp' % (directory, directory.rsplit('/', 1)[-1])
+    return {path: header(namespace, path, source, ['<cstdint>', '<trak/shared_bitfield.hpp>'], body)}
+
+
+def write_if_changed(path, content):
+    """Writes content to path unless it already holds it, and returns True if it was written."""
+    try:
+        with open(path) as f:
+            if f.read() == content:
+                return False
+    except OSError:
+        pass
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, 'w') as f:
+        f.write(content)
+    return True
+
+
+def write_outputs(directory, outputs, verbose):
+    """Writes the changed outputs, removes the stale outputs of the previous run and returns the written paths."""
+    manifest = os.path.join(directory, MANIFEST)
+    previous = set()
+    if os.path.exists(manifest):
+        with open(manifest) as f:
+            previous = set(line for line in f.read().splitlines() if line)
+
+    written = []
+    for path in sorted(outputs):
+        if write_if_changed(os.path.join(directory, path), outputs[path]):
+            written.append(path)
+    for path in sorted(previous - set(outputs)):
+        full = os.path.join(directory, path)
+        if os.path.exists(full):
+            os.remove(full)
+        if verbose:
+            print('removed %s' % path)
+    write_if_changed(manifest, ''.join('%s\n' % path for path in sorted(outputs)))
+    if verbose:
+        for path in written:
+            print('written %s' % path)
+    return written
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--registry', required=True, help='JSON or XML registry')
+    parser.add_argument('--output', required=True, help='output directory, to be added to the include path')
+    parser.add_argument('--namespace', help='namespace of the generated code, overriding the one of the registry')
+    parser.add_argument('--monolithic', action='store_true', help='generate a single header')
+    parser.add_argument('--list-outputs', action='store_true', help='print the output paths without generating them')
+    parser.add_argument('--verbose', action='store_true', help='print the written and removed outputs')
+    args = parser.parse_args()
+
+    try:
+        namespace, enums = load_registry(args.registry)
+        namespace = args.namespace or namespace
+        if not namespace or not re.match(r'^[A-Za-z_][A-Za-z0-9_]*(::[A-Za-z_][A-Za-z0-9_]*)*$', namespace):
+            raise RegistryError('invalid or missing namespace "%s"' % namespace)
+        constants = collect_constants(enums)
+    except (OSError, ValueError, KeyError, xml.etree.ElementTree.ParseError, RegistryError) as error:
+        sys.stderr.write('%s: error: %s\n' % (args.registry, error))
+        return 1
+
+    directory = namespace.replace('::', '/')
+    source = os.path.basename(args.registry)
+    generate = generate_monolithic if args.monolithic else generate_split
+    outputs = generate(namespace, directory, enums, constants, source)
+
+    if args.list_outputs:
+        for path in sorted(outputs):
+            print(os.path.join(os.path.abspath(args.output), path))
+        return 0
+    write_outputs(args.output, outputs, args.verbose)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,298 @@
+#ifndef TRAK_ATOMIC_SHARED_BITFIELD_HPP
+#define TRAK_ATOMIC_SHARED_BITFIELD_HPP
+
+#include <trak/shared_bitfield.hpp>
+
+#include <atomic>
+#include <type_traits>
+
+namespace trak {
+
+    /**
+     * Represents a shared bitfield which can be modified concurrently from multiple threads without locking,
+     * as long as std::atomic of its underlying type is lock-free.
+     *
+     * Like shared_bitfield, the read-modify-write operations accept any shared bitfield whose types intersect Ts.
+     * The operations setting or toggling bits reject wider bitfields, whose bits beyond this one would be lost.
+     * Each operation takes an optional memory order, defaulting to sequentially consistent ordering.
+     *
+     * @tparam Ts
+     *      List of types the bitfield is a member of.
+     */
+    template<typename... Ts>
+    class atomic_shared_bitfield {
+    public:
+        using value_type = shared_bitfield<Ts...>;
+        using underlying_type = typename value_type::underlying_type;
+
+        static constexpr bool is_always_lock_free = std::atomic<underlying_type>::is_always_lock_free;
+
+        /**
+         * Constructs an atomic bitfield with no bit set.
+         */
+        constexpr atomic_shared_bitfield() noexcept : value_(underlying_type{0}) {}
+
+        /**
+         * Constructs an atomic bitfield from value.
+         *
+         * @param value
+         *      The initial value.
+         */
+        constexpr atomic_shared_bitfield(value_type value) noexcept : value_(static_cast<underlying_type>(value)) {}
+
+        atomic_shared_bitfield(const atomic_shared_bitfield&) = delete;
+        atomic_shared_bitfield& operator=(const atomic_shared_bitfield&) = delete;
+
+        /**
+         * Returns whether the operations on this bitfield are lock-free.
+         */
+        inline bool is_lock_free() const noexcept {
+            return value_.is_lock_free();
+        }
+
+        /**
+         * Atomically loads the value.
+         *
+         * @param order
+         *      The memory order of the load.
+         */
+        inline value_type load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return static_cast<value_type>(value_.load(order));
+        }
+
+        inline operator value_type() const noexcept {
+            return load();
+        }
+
+        /**
+         * Atomically replaces the value by value.
+         *
+         * @param value
+         *      The value to store.
+         * @param order
+         *      The memory order of the store.
+         */
+        inline void store(value_type value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            value_.store(static_cast<underlying_type>(value), order);
+        }
+
+        inline value_type operator=(value_type value) noexcept {
+            store(value);
+            return value;
+        }
+
+        /**
+         * Atomically replaces the value by value and returns the previous value.
+         *
+         * @param value
+         *      The value to store.
+         * @param order
+         *      The memory order of the operation.
+         */
+        inline value_type exchange(value_type value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return static_cast<value_type>(value_.exchange(static_cast<underlying_type>(value), order));
+        }
+
+        /**
+         * Atomically replaces the value by desired if it equals expected. Otherwise, loads the value into expected.
+         * May fail spuriously.
+         *
+         * @return
+         *      \c true if the value was replaced, \c false otherwise.
+         */
+        inline bool compare_exchange_weak(value_type& expected, value_type desired,
+                                          std::memory_order success = std::memory_order_seq_cst,
+                                          std::memory_order failure = std::memory_order_seq_cst) noexcept {
+            auto raw = static_cast<underlying_type>(expected);
+            const auto exchanged = value_.compare_exchange_weak(raw, static_cast<underlying_type>(desired), success, failure);
+            expected = static_cast<value_type>(raw);
+            return exchanged;
+        }
+
+        /**
+         * Atomically replaces the value by desired if it equals expected. Otherwise, loads the value into expected.
+         *
+         * @return
+         *      \c true if the value was replaced, \c false otherwise.
+         */
+        inline bool compare_exchange_strong(value_type& expected, value_type desired,
+                                            std::memory_order success = std::memory_order_seq_cst,
+                                            std::memory_order failure = std::memory_order_seq_cst) noexcept {
+            auto raw = static_cast<underlying_type>(expected);
+            const auto exchanged = value_.compare_exchange_strong(raw, static_cast<underlying_type>(desired), success, failure);
+            expected = static_cast<value_type>(raw);
+            return exchanged;
+        }
+
+        /**
+         * Atomically performs a bit-wise 'or' of the value and rhs, and returns the previous value.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side shared bitfield, which needs to intersect Ts and must not
+         *      be wider than this bitfield.
+         */
+        template<typename... Us>
+        inline auto fetch_or(shared_bitfield<Us...> rhs, std::memory_order order = std::memory_order_seq_cst) noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>
+                && sizeof(typename shared_bitfield<Us...>::underlying_type) <= sizeof(underlying_type)), value_type) {
+            return static_cast<value_type>(value_.fetch_or(static_cast<underlying_type>(detail::underlying_value(rhs)), order));
+        }
+
+        /**
+         * Atomically performs a bit-wise 'and' of the value and rhs, and returns the previous value.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side shared bitfield, which needs to intersect Ts.
+         */
+        template<typename... Us>
+        inline auto fetch_and(shared_bitfield<Us...> rhs, std::memory_order order = std::memory_order_seq_cst) noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), value_type) {
+            return static_cast<value_type>(value_.fetch_and(static_cast<underlying_type>(detail::underlying_value(rhs)), order));
+        }
+
+        /**
+         * Atomically performs a bit-wise 'xor' of the value and rhs, and returns the previous value.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side shared bitfield, which needs to intersect Ts and must not
+         *      be wider than this bitfield.
+         */
+        template<typename... Us>
+        inline auto fetch_xor(shared_bitfield<Us...> rhs, std::memory_order order = std::memory_order_seq_cst) noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>
+                && sizeof(typename shared_bitfield<Us...>::underlying_type) <= sizeof(underlying_type)), value_type) {
+            return static_cast<value_type>(value_.fetch_xor(static_cast<underlying_type>(detail::underlying_value(rhs)), order));
+        }
+
+        /**
+         * Atomically performs a bit-wise 'or' assignment of rhs, and returns the resulting value.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side shared bitfield, which needs to intersect Ts and must not
+         *      be wider than this bitfield.
+         */
+        template<typename... Us>
+        inline auto operator|=(shared_bitfield<Us...> rhs) noexcept -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>
+                && sizeof(typename shared_bitfield<Us...>::underlying_type) <= sizeof(underlying_type)), value_type) {
+            return static_cast<value_type>(static_cast<underlying_type>(static_cast<underlying_type>(fetch_or(rhs)) | static_cast<underlying_type>(detail::underlying_value(rhs))));
+        }
+
+        /**
+         * Atomically performs a bit-wise 'and' assignment of rhs, and returns the resulting value.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side shared bitfield, which needs to intersect Ts.
+         */
+        template<typename... Us>
+        inline auto operator&=(shared_bitfield<Us...> rhs) noexcept -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), value_type) {
+            return static_cast<value_type>(static_cast<underlying_type>(static_cast<underlying_type>(fetch_and(rhs)) & static_cast<underlying_type>(detail::underlying_value(rhs))));
+        }
+
+        /**
+         * Atomically performs a bit-wise 'xor' assignment of rhs, and returns the resulting value.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side shared bitfield, which needs to intersect Ts and must not
+         *      be wider than this bitfield.
+         */
+        template<typename... Us>
+        inline auto operator^=(shared_bitfield<Us...> rhs) noexcept -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>
+                && sizeof(typename shared_bitfield<Us...>::underlying_type) <= sizeof(underlying_type)), value_type) {
+            return static_cast<value_type>(static_cast<underlying_type>(static_cast<underlying_type>(fetch_xor(rhs)) ^ static_cast<underlying_type>(detail::underlying_value(rhs))));
+        }
+
+        /**
+         * Returns \c true if any bit of flags is set. Otherwise, returns \c false.
+         *
+         * @tparam Us
+         *      The list of types of the flags, which needs to intersect Ts.
+         */
+        template<typename... Us>
+        inline auto test(shared_bitfield<Us...> flags, std::memory_order order = std::memory_order_seq_cst) const noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), bool) {
+            return (value_.load(order) & static_cast<underlying_type>(detail::underlying_value(flags))) != 0;
+        }
+
+        /**
+         * Atomically sets the bits of flags and returns \c true if any of them was set before.
+         * Otherwise, returns \c false.
+         *
+         * @tparam Us
+         *      The list of types of the flags, which needs to intersect Ts and must not be wider than this
+         *      bitfield.
+         */
+        template<typename... Us>
+        inline auto test_and_set(shared_bitfield<Us...> flags, std::memory_order order = std::memory_order_seq_cst) noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>
+                && sizeof(typename shared_bitfield<Us...>::underlying_type) <= sizeof(underlying_type)), bool) {
+            const auto mask = static_cast<underlying_type>(detail::underlying_value(flags));
+            return (value_.fetch_or(mask, order) & mask) != 0;
+        }
+
+        /**
+         * Atomically clears the bits of flags and returns \c true if any of them was set before.
+         * Otherwise, returns \c false.
+         *
+         * @tparam Us
+         *      The list of types of the flags, which needs to intersect Ts.
+         */
+        template<typename... Us>
+        inline auto test_and_clear(shared_bitfield<Us...> flags, std::memory_order order = std::memory_order_seq_cst) noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), bool) {
+            const auto mask = static_cast<underlying_type>(detail::underlying_value(flags));
+            return (value_.fetch_and(static_cast<underlying_type>(~mask), order) & mask) != 0;
+        }
+
+#if defined(__cpp_lib_atomic_wait)
+        /**
+         * Blocks until the value differs from old and a notification is received.
+         *
+         * @param old
+         *      The value to wait for a change of.
+         * @param order
+         *      The memory order of the loads.
+         */
+        inline void wait(value_type old, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            value_.wait(static_cast<underlying_type>(old), order);
+        }
+
+        /**
+         * Blocks until any bit of flags is set, and returns the value observed.
+         * Modifying threads need to call notify_one or notify_all after setting the flags.
+         *
+         * @tparam Us
+         *      The list of types of the flags, which needs to intersect Ts.
+         */
+        template<typename... Us>
+        inline auto wait_any(shared_bitfield<Us...> flags, std::memory_order order = std::memory_order_seq_cst) const noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), value_type) {
+            const auto mask = static_cast<underlying_type>(detail::underlying_value(flags));
+            auto value = value_.load(order);
+            while ((value & mask) == 0) {
+                value_.wait(value, order);
+                value = value_.load(order);
+            }
+            return static_cast<value_type>(value);
+        }
+
+        /**
+         * Unblocks at least one thread waiting on this bitfield.
+         */
+        inline void notify_one() noexcept {
+            value_.notify_one();
+        }
+
+        /**
+         * Unblocks all threads waiting on this bitfield.
+         */
+        inline void notify_all() noexcept {
+            value_.notify_all();
+        }
+#endif
+
+    private:
+        std::atomic<underlying_type> value_;
+    };
+}
+
+#endif //TRAK_ATOMIC_SHARED_BITFIELD_HPP
@@ -0,0 +1,232 @@
+#ifndef TRAK_BITFIELD_ALGORITHM_HPP
+#define TRAK_BITFIELD_ALGORITHM_HPP
+
+#include <trak/detail/bitfield_kernels.hpp>
+#include <trak/shared_bitfield.hpp>
+#include <trak/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * Checks whether L and R are shared bitfields sharing at least one type. Provides the member constant
+         * value which is equal to \c true if so. Otherwise, value is \c false.
+         */
+        template<typename L, typename R, typename = void>
+        struct intersecting_bitfields : std::false_type {};
+
+        template<typename L, typename R>
+        struct intersecting_bitfields<L, R, typename std::enable_if<is_shared_bitfield<L>::value && is_shared_bitfield<R>::value>::type>
+                : std::integral_constant<bool, !std::is_same<typename intersect_shared_enum<shared_enum_of_t<L>, shared_enum_of_t<R>>::type, shared_enum<>>::value> {};
+
+        /**
+         * Returns the bytes of the bitfields of values.
+         */
+        template<typename T>
+        inline auto bitfield_bytes(T* values) noexcept {
+            static_assert(std::is_standard_layout<T>::value && sizeof(T) == sizeof(typename T::underlying_type),
+                          "Bitfields need to have the layout of their underlying type");
+            static_assert(sizeof(T) <= sizeof(std::uint64_t), "Bitfields need to be at most 64 bits");
+            using byte = typename std::conditional<std::is_const<T>::value, const unsigned char, unsigned char>::type;
+            return reinterpret_cast<byte*>(values);
+        }
+
+        /**
+         * Returns mask converted to the underlying type of T and repeated over 64 bits, such that it lines up with each
+         * bitfield of T of an 8-byte aligned chunk.
+         */
+        template<typename T, typename M>
+        inline std::uint64_t repeat_bitfield_mask(const M& mask) noexcept {
+            const auto value = static_cast<typename T::underlying_type>(underlying_value(mask));
+            unsigned char bytes[sizeof(std::uint64_t)];
+            for (std::size_t i = 0; i < sizeof(bytes); i += sizeof(value)) {
+                std::memcpy(bytes + i, &value, sizeof(value));
+            }
+            std::uint64_t result;
+            std::memcpy(&result, bytes, sizeof(result));
+            return result;
+        }
+    }
+
+    /**
+     * Performs a bit-wise 'or' assignment of each bitfield of src to the bitfield of dst at the same index.
+     * Only the common prefix of dst and src is processed. The types of src and dst need to intersect, and src must
+     * not be wider than dst. If their underlying types differ in size, the bitfields are converted one by one
+     * instead of processed in bulk.
+     *
+     * The operation is vectorized with the widest instruction set supported by the executing CPU.
+     *
+     * @tparam L
+     *      The shared bitfield type of dst.
+     * @tparam R
+     *      The shared bitfield type of src, which may be const.
+     * @param dst
+     *      The bitfields to assign to.
+     * @param src
+     *      The right-hand side bitfields.
+     */
+    template<typename L, typename R>
+    inline auto bitfield_or(span<L> dst, span<R> src) noexcept -> typename std::enable_if<!std::is_const<L>::value
+            && detail::intersecting_bitfields<L, typename std::remove_const<R>::type>::value && sizeof(R) <= sizeof(L)>::type {
+        const auto size = dst.size() < src.size() ? dst.size() : src.size();
+        if constexpr (sizeof(L) == sizeof(R)) {
+            detail::active_bitfield_kernels().bit_or(detail::bitfield_bytes(dst.data()), detail::bitfield_bytes(src.data()), size * sizeof(L));
+        } else {
+            for (std::size_t i = 0; i < size; ++i) {
+                dst[i] |= src[i];
+            }
+        }
+    }
+
+    /**
+     * Performs a bit-wise 'and' assignment of each bitfield of src to the bitfield of dst at the same index.
+     * Only the common prefix of dst and src is processed. The types of src and dst need to intersect. If their
+     * underlying types differ in size, the bitfields are converted one by one instead of processed in bulk.
+     *
+     * @tparam L
+     *      The shared bitfield type of dst.
+     * @tparam R
+     *      The shared bitfield type of src, which may be const.
+     * @param dst
+     *      The bitfields to assign to.
+     * @param src
+     *      The right-hand side bitfields.
+     */
+    template<typename L, typename R>
+    inline auto bitfield_and(span<L> dst, span<R> src) noexcept -> typename std::enable_if<!std::is_const<L>::value
+            && detail::intersecting_bitfields<L, typename std::remove_const<R>::type>::value>::type {
+        const auto size = dst.size() < src.size() ? dst.size() : src.size();
+        if constexpr (sizeof(L) == sizeof(R)) {
+            detail::active_bitfield_kernels().bit_and(detail::bitfield_bytes(dst.data()), detail::bitfield_bytes(src.data()), size * sizeof(L));
+        } else {
+            for (std::size_t i = 0; i < size; ++i) {
+                dst[i] &= src[i];
+            }
+        }
+    }
+
+    /**
+     * Performs a bit-wise 'xor' assignment of each bitfield of src to the bitfield of dst at the same index.
+     * Only the common prefix of dst and src is processed. The types of src and dst need to intersect, and src must
+     * not be wider than dst. If their underlying types differ in size, the bitfields are converted one by one
+     * instead of processed in bulk.
+     *
+     * @tparam L
+     *      The shared bitfield type of dst.
+     * @tparam R
+     *      The shared bitfield type of src, which may be const.
+     * @param dst
+     *      The bitfields to assign to.
+     * @param src
+     *      The right-hand side bitfields.
+     */
+    template<typename L, typename R>
+    inline auto bitfield_xor(span<L> dst, span<R> src) noexcept -> typename std::enable_if<!std::is_const<L>::value
+            && detail::intersecting_bitfields<L, typename std::remove_const<R>::type>::value && sizeof(R) <= sizeof(L)>::type {
+        const auto size = dst.size() < src.size() ? dst.size() : src.size();
+        if constexpr (sizeof(L) == sizeof(R)) {
+            detail::active_bitfield_kernels().bit_xor(detail::bitfield_bytes(dst.data()), detail::bitfield_bytes(src.data()), size * sizeof(L));
+        } else {
+            for (std::size_t i = 0; i < size; ++i) {
+                dst[i] ^= src[i];
+            }
+        }
+    }
+
+    /**
+     * Returns \c true if any bitfield of values has any bit of mask set. Otherwise, returns \c false.
+     *
+     * @tparam T
+     *      The shared bitfield type of values, which may be const.
+     * @tparam M
+     *      The shared bitfield type of mask, which needs to intersect T.
+     * @param values
+     *      The bitfields to test.
+     * @param mask
+     *      The bits to test for.
+     */
+    template<typename T, typename M>
+    inline auto bitfield_any(span<T> values, const M& mask) noexcept
+            -> typename std::enable_if<detail::intersecting_bitfields<typename std::remove_const<T>::type, M>::value, bool>::type {
+        return detail::active_bitfield_kernels().any(detail::bitfield_bytes(values.data()), values.size() * sizeof(T),
+                                                     detail::repeat_bitfield_mask<typename std::remove_const<T>::type>(mask));
+    }
+
+    /**
+     * Returns \c true if all bitfields of values have all bits of mask set. Otherwise, returns \c false.
+     *
+     * @tparam T
+     *      The shared bitfield type of values, which may be const.
+     * @tparam M
+     *      The shared bitfield type of mask, which needs to intersect T.
+     * @param values
+     *      The bitfields to test.
+     * @param mask
+     *      The bits to test for.
+     */
+    template<typename T, typename M>
+    inline auto bitfield_all(span<T> values, const M& mask) noexcept
+            -> typename std::enable_if<detail::intersecting_bitfields<typename std::remove_const<T>::type, M>::value, bool>::type {
+        return detail::active_bitfield_kernels().all(detail::bitfield_bytes(values.data()), values.size() * sizeof(T),
+                                                     detail::repeat_bitfield_mask<typename std::remove_const<T>::type>(mask));
+    }
+
+    /**
+     * Returns the total number of bits set in values.
+     *
+     * @tparam T
+     *      The shared bitfield type of values, which may be const.
+     * @param values
+     *      The bitfields to count.
+     */
+    template<typename T>
+    inline auto bitfield_count(span<T> values) noexcept
+            -> typename std::enable_if<detail::is_shared_bitfield<typename std::remove_const<T>::type>::value, std::size_t>::type {
+        return detail::active_bitfield_kernels().count(detail::bitfield_bytes(values.data()), values.size() * sizeof(T));
+    }
+
+    /**
+     * Compares the bits of mask of lhs and rhs, and returns the index of the first bitfield differing.
+     * Only the common prefix of lhs and rhs is compared, and its size is returned if no bitfield differs. If the
+     * underlying types of lhs and rhs differ in size, rhs is converted to the one of lhs bitfield by bitfield.
+     *
+     * @tparam L
+     *      The shared bitfield type of lhs, which may be const.
+     * @tparam R
+     *      The shared bitfield type of rhs, which may be const and needs to intersect L.
+     * @tparam M
+     *      The shared bitfield type of mask, which needs to intersect L.
+     * @param lhs
+     *      The left-hand side bitfields.
+     * @param rhs
+     *      The right-hand side bitfields.
+     * @param mask
+     *      The bits to compare.
+     */
+    template<typename L, typename R, typename M>
+    inline auto bitfield_mismatch(span<L> lhs, span<R> rhs, const M& mask) noexcept -> typename std::enable_if<
+            detail::intersecting_bitfields<typename std::remove_const<L>::type, typename std::remove_const<R>::type>::value
+            && detail::intersecting_bitfields<typename std::remove_const<L>::type, M>::value, std::size_t>::type {
+        const auto size = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+        if constexpr (sizeof(L) == sizeof(R)) {
+            return detail::active_bitfield_kernels().mismatch(detail::bitfield_bytes(lhs.data()), detail::bitfield_bytes(rhs.data()),
+                                                              size * sizeof(L), detail::repeat_bitfield_mask<typename std::remove_const<L>::type>(mask)) / sizeof(L);
+        } else {
+            using underlying_type = typename std::remove_const<L>::type::underlying_type;
+            const auto bits = static_cast<underlying_type>(detail::underlying_value(mask));
+            std::size_t i = 0;
+            while (i < size && (detail::underlying_value(lhs[i]) & bits) == (static_cast<underlying_type>(detail::underlying_value(rhs[i])) & bits)) {
+                ++i;
+            }
+            return i;
+        }
+    }
+}
+
+#endif //TRAK_BITFIELD_ALGORITHM_HPP
@@ -0,0 +1,237 @@
+#ifndef TRAK_BITFIELD_FLAGS_HPP
+#define TRAK_BITFIELD_FLAGS_HPP
+
+#include <trak/detail/bits.hpp>
+#include <trak/enum_traits.hpp>
+#include <trak/shared_bitfield.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace trak {
+
+    namespace detail {
+
+        template<typename B, typename = void>
+        struct flag_underlying {};
+
+        template<typename B>
+        struct flag_underlying<B, typename std::enable_if<std::is_enum<B>::value>::type> {
+            using type = typename std::underlying_type<B>::type;
+        };
+
+        template<typename B>
+        struct flag_underlying<B, typename std::enable_if<is_shared_bitfield<B>::value>::type> {
+            using type = typename B::underlying_type;
+        };
+
+        /**
+         * The underlying type of B, being an enum or a shared bitfield. Undefined for other types.
+         */
+        template<typename B>
+        using flag_underlying_t = typename flag_underlying<B>::type;
+
+        /**
+         * Returns the bits of value, zero-extended to 64 bits.
+         */
+        template<typename B>
+        constexpr std::uint64_t flag_bits(B value) noexcept {
+            using underlying_type = flag_underlying_t<B>;
+            static_assert(sizeof(underlying_type) <= sizeof(std::uint64_t), "Bitfields need to be at most 64 bits");
+            return static_cast<std::uint64_t>(static_cast<typename std::make_unsigned<underlying_type>::type>(static_cast<underlying_type>(value)));
+        }
+
+        /**
+         * The bit-wise 'or' of the enumerators of E having exactly one bit set.
+         */
+        template<typename E>
+        inline constexpr std::uint64_t named_flag_mask = [] {
+            std::uint64_t mask = 0;
+            for (auto value : enum_traits<E>::values) {
+                const auto bits = flag_bits(value);
+                mask |= (bits & (bits - 1)) == 0 ? bits : 0;
+            }
+            return mask;
+        }();
+    }
+
+    /**
+     * A range over the bits set in a bitfield value, each yielded as a value of B with exactly that bit set,
+     * in ascending order of the bits. Each step costs a count-trailing-zeros and a clear-lowest-bit operation,
+     * independent of the number of bits cleared.
+     *
+     * @tparam B
+     *      The enum or shared bitfield type.
+     */
+    template<typename B>
+    class flag_range {
+    public:
+        using underlying_type = detail::flag_underlying_t<B>;
+        using value_type = B;
+
+        /**
+         * Iterates the bits set in a value, from the lowest to the highest.
+         */
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = B;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const B*;
+            using reference = B;
+
+            constexpr const_iterator() noexcept = default;
+
+            constexpr B operator*() const noexcept {
+                return static_cast<B>(static_cast<underlying_type>(bits_ & (~bits_ + 1u)));
+            }
+
+            /**
+             * Returns the index of the current bit.
+             */
+            constexpr unsigned int bit() const noexcept {
+                return detail::countr_zero64(bits_);
+            }
+
+            constexpr const_iterator& operator++() noexcept {
+                bits_ &= bits_ - 1;
+                return *this;
+            }
+
+            constexpr const_iterator operator++(int) noexcept {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            constexpr bool operator==(const const_iterator& rhs) const noexcept {
+                return bits_ == rhs.bits_;
+            }
+
+            constexpr bool operator!=(const const_iterator& rhs) const noexcept {
+                return !(*this == rhs);
+            }
+
+        private:
+            friend class flag_range;
+
+            explicit constexpr const_iterator(std::uint64_t bits) noexcept : bits_(bits) {}
+
+            std::uint64_t bits_ = 0;
+        };
+
+        using iterator = const_iterator;
+
+        constexpr flag_range() noexcept = default;
+
+        /**
+         * Constructs the range over the bits set in value.
+         */
+        explicit constexpr flag_range(B value) noexcept : bits_(detail::flag_bits(value)) {}
+
+        constexpr const_iterator begin() const noexcept {
+            return const_iterator(bits_);
+        }
+
+        constexpr const_iterator end() const noexcept {
+            return const_iterator(0);
+        }
+
+        constexpr bool empty() const noexcept {
+            return bits_ == 0;
+        }
+
+        /**
+         * Returns the number of bits set.
+         */
+        constexpr std::size_t size() const noexcept {
+            return detail::popcount64(bits_);
+        }
+
+    private:
+        std::uint64_t bits_ = 0;
+    };
+
+    /**
+     * Returns the range over the bits set in value, each yielded as a value of B.
+     *
+     * @tparam B
+     *      The enum or shared bitfield type.
+     */
+    template<typename B>
+    constexpr inline auto flags_of(B value) noexcept -> decltype(flag_range<B>(value)) {
+        return flag_range<B>(value);
+    }
+
+    /**
+     * Calls f with each bit set in value, as a value of B with exactly that bit set, in ascending order of the bits.
+     *
+     * @tparam B
+     *      The enum or shared bitfield type.
+     * @tparam F
+     *      The function type, invocable with B.
+     */
+    template<typename B, typename F>
+    constexpr inline auto for_each_flag(B value, F&& f) -> decltype(static_cast<void>(detail::flag_bits(value))) {
+        for (auto bits = detail::flag_bits(value); bits != 0; bits &= bits - 1) {
+            f(static_cast<B>(static_cast<detail::flag_underlying_t<B>>(bits & (~bits + 1u))));
+        }
+    }
+
+    /**
+     * The decomposition of a bitfield value into the named flags of E, being its enumerators with exactly one bit
+     * set as described by enum_traits, and the remaining bits.
+     *
+     * @tparam E
+     *      The enum type.
+     */
+    template<typename E>
+    struct flag_decomposition {
+        /**
+         * The named flags set in the value, in ascending order of their bits. Their names are given by name_of.
+         */
+        flag_range<E> named;
+
+        /**
+         * The bits set in the value which are no named flag of E.
+         */
+        E unnamed{};
+    };
+
+    namespace detail {
+
+        template<typename E>
+        constexpr flag_decomposition<E> decompose_flag_bits(std::uint64_t bits) noexcept {
+            using underlying_type = typename std::underlying_type<E>::type;
+            return {flag_range<E>(static_cast<E>(static_cast<underlying_type>(bits & named_flag_mask<E>))),
+                    static_cast<E>(static_cast<underlying_type>(bits & ~named_flag_mask<E>))};
+        }
+    }
+
+    /**
+     * Decomposes value into the named flags of E and the remaining bits.
+     *
+     * @tparam E
+     *      The enum type to decompose into, being the type of value or one of the types of the shared bitfield.
+     * @tparam B
+     *      The enum or shared bitfield type of value.
+     */
+    template<typename E, typename B>
+    constexpr inline auto decompose_flags(B value) noexcept -> typename std::enable_if<std::is_enum<E>::value && (std::is_same<E, B>::value
+            || (detail::is_shared_bitfield<B>::value && std::is_convertible<B, E>::value)), flag_decomposition<E>>::type {
+        return detail::decompose_flag_bits<E>(detail::flag_bits(static_cast<E>(value)));
+    }
+
+    /**
+     * Decomposes value into the named flags of the first type T of the shared bitfield and the remaining bits.
+     */
+    template<typename T, typename... Ts>
+    constexpr inline flag_decomposition<T> decompose_flags(shared_bitfield<T, Ts...> value) noexcept {
+        return detail::decompose_flag_bits<T>(detail::flag_bits(value));
+    }
+}
+
+#endif //TRAK_BITFIELD_FLAGS_HPP
@@ -0,0 +1,435 @@
+#ifndef TRAK_DETAIL_BITFIELD_KERNELS_HPP
+#define TRAK_DETAIL_BITFIELD_KERNELS_HPP
+
+#include <trak/detail/bits.hpp>
+#include <trak/detail/simd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * Kernels of the bulk bitfield operations. The kernels operate on bytes, so they are independent of the
+         * width of the bitfields. Masks are the mask of a single bitfield repeated over 64 bits, such that they line
+         * up with the bitfields of every 8-byte aligned chunk.
+         */
+        struct bitfield_kernels {
+            void (*bit_or)(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept;
+            void (*bit_and)(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept;
+            void (*bit_xor)(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept;
+            bool (*any)(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept;
+            bool (*all)(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept;
+            std::size_t (*count)(const unsigned char* data, std::size_t bytes) noexcept;
+            /** Returns the offset of the first byte differing in the mask, or bytes if there is none. */
+            std::size_t (*mismatch)(const unsigned char* lhs, const unsigned char* rhs, std::size_t bytes, std::uint64_t mask) noexcept;
+        };
+
+        namespace scalar_kernels {
+
+            inline std::uint64_t load64(const unsigned char* data) noexcept {
+                std::uint64_t value;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+
+            inline void store64(unsigned char* data, std::uint64_t value) noexcept {
+                std::memcpy(data, &value, sizeof(value));
+            }
+
+            inline unsigned char mask_byte(std::uint64_t mask, std::size_t index) noexcept {
+                unsigned char bytes[sizeof(mask)];
+                std::memcpy(bytes, &mask, sizeof(mask));
+                return bytes[index % sizeof(mask)];
+            }
+
+            inline void bit_or(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 8 <= bytes; i += 8) {
+                    store64(dst + i, load64(dst + i) | load64(src + i));
+                }
+                for (; i < bytes; ++i) {
+                    dst[i] |= src[i];
+                }
+            }
+
+            inline void bit_and(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 8 <= bytes; i += 8) {
+                    store64(dst + i, load64(dst + i) & load64(src + i));
+                }
+                for (; i < bytes; ++i) {
+                    dst[i] &= src[i];
+                }
+            }
+
+            inline void bit_xor(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 8 <= bytes; i += 8) {
+                    store64(dst + i, load64(dst + i) ^ load64(src + i));
+                }
+                for (; i < bytes; ++i) {
+                    dst[i] ^= src[i];
+                }
+            }
+
+            inline bool any(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept {
+                std::uint64_t result = 0;
+                std::size_t i = 0;
+                for (; i + 8 <= bytes; i += 8) {
+                    result |= load64(data + i) & mask;
+                }
+                for (; i < bytes; ++i) {
+                    result |= data[i] & mask_byte(mask, i);
+                }
+                return result != 0;
+            }
+
+            inline bool all(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept {
+                std::uint64_t missing = 0;
+                std::size_t i = 0;
+                for (; i + 8 <= bytes; i += 8) {
+                    missing |= (load64(data + i) & mask) ^ mask;
+                }
+                for (; i < bytes; ++i) {
+                    missing |= (data[i] & mask_byte(mask, i)) ^ mask_byte(mask, i);
+                }
+                return missing == 0;
+            }
+
+            inline std::size_t count(const unsigned char* data, std::size_t bytes) noexcept {
+                std::size_t result = 0;
+                std::size_t i = 0;
+                for (; i + 8 <= bytes; i += 8) {
+                    result += popcount64(load64(data + i));
+                }
+                for (; i < bytes; ++i) {
+                    result += popcount64(data[i]);
+                }
+                return result;
+            }
+
+            inline std::size_t mismatch(const unsigned char* lhs, const unsigned char* rhs, std::size_t bytes, std::uint64_t mask) noexcept {
+                std::size_t i = 0;
+                while (i + 8 <= bytes && ((load64(lhs + i) ^ load64(rhs + i)) & mask) == 0) {
+                    i += 8;
+                }
+                for (; i < bytes; ++i) {
+                    if ((lhs[i] ^ rhs[i]) & mask_byte(mask, i)) {
+                        return i;
+                    }
+                }
+                return bytes;
+            }
+        }
+
+#if TRAK_SIMD_X86
+        namespace sse2_kernels {
+
+            TRAK_TARGET("sse2") inline __m128i load(const unsigned char* data) noexcept {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            }
+
+            TRAK_TARGET("sse2") inline void store(unsigned char* data, __m128i value) noexcept {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+            }
+
+            TRAK_TARGET("sse2") inline bool is_zero(__m128i value) noexcept {
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128())) == 0xffff;
+            }
+
+            TRAK_TARGET("sse2") inline void bit_or(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 16 <= bytes; i += 16) {
+                    store(dst + i, _mm_or_si128(load(dst + i), load(src + i)));
+                }
+                scalar_kernels::bit_or(dst + i, src + i, bytes - i);
+            }
+
+            TRAK_TARGET("sse2") inline void bit_and(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 16 <= bytes; i += 16) {
+                    store(dst + i, _mm_and_si128(load(dst + i), load(src + i)));
+                }
+                scalar_kernels::bit_and(dst + i, src + i, bytes - i);
+            }
+
+            TRAK_TARGET("sse2") inline void bit_xor(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 16 <= bytes; i += 16) {
+                    store(dst + i, _mm_xor_si128(load(dst + i), load(src + i)));
+                }
+                scalar_kernels::bit_xor(dst + i, src + i, bytes - i);
+            }
+
+            TRAK_TARGET("sse2") inline bool any(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept {
+                const __m128i masks = _mm_set1_epi64x(static_cast<long long>(mask));
+                __m128i result = _mm_setzero_si128();
+                std::size_t i = 0;
+                for (; i + 16 <= bytes; i += 16) {
+                    result = _mm_or_si128(result, _mm_and_si128(load(data + i), masks));
+                }
+                return !is_zero(result) || scalar_kernels::any(data + i, bytes - i, mask);
+            }
+
+            TRAK_TARGET("sse2") inline bool all(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept {
+                const __m128i masks = _mm_set1_epi64x(static_cast<long long>(mask));
+                __m128i missing = _mm_setzero_si128();
+                std::size_t i = 0;
+                for (; i + 16 <= bytes; i += 16) {
+                    missing = _mm_or_si128(missing, _mm_andnot_si128(load(data + i), masks));
+                }
+                return is_zero(missing) && scalar_kernels::all(data + i, bytes - i, mask);
+            }
+
+            TRAK_TARGET("sse2") inline std::size_t mismatch(const unsigned char* lhs, const unsigned char* rhs, std::size_t bytes, std::uint64_t mask) noexcept {
+                const __m128i masks = _mm_set1_epi64x(static_cast<long long>(mask));
+                std::size_t i = 0;
+                while (i + 16 <= bytes && is_zero(_mm_and_si128(_mm_xor_si128(load(lhs + i), load(rhs + i)), masks))) {
+                    i += 16;
+                }
+                return i + scalar_kernels::mismatch(lhs + i, rhs + i, bytes - i, mask);
+            }
+        }
+
+        namespace avx2_kernels {
+
+            TRAK_TARGET("avx2") inline __m256i load(const unsigned char* data) noexcept {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            }
+
+            TRAK_TARGET("avx2") inline void store(unsigned char* data, __m256i value) noexcept {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value);
+            }
+
+            TRAK_TARGET("avx2") inline void bit_or(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 32 <= bytes; i += 32) {
+                    store(dst + i, _mm256_or_si256(load(dst + i), load(src + i)));
+                }
+                scalar_kernels::bit_or(dst + i, src + i, bytes - i);
+            }
+
+            TRAK_TARGET("avx2") inline void bit_and(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 32 <= bytes; i += 32) {
+                    store(dst + i, _mm256_and_si256(load(dst + i), load(src + i)));
+                }
+                scalar_kernels::bit_and(dst + i, src + i, bytes - i);
+            }
+
+            TRAK_TARGET("avx2") inline void bit_xor(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 32 <= bytes; i += 32) {
+                    store(dst + i, _mm256_xor_si256(load(dst + i), load(src + i)));
+                }
+                scalar_kernels::bit_xor(dst + i, src + i, bytes - i);
+            }
+
+            TRAK_TARGET("avx2") inline bool any(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept {
+                const __m256i masks = _mm256_set1_epi64x(static_cast<long long>(mask));
+                std::size_t i = 0;
+                // Test four vectors at a time, so large inputs with a match early on return early.
+                for (; i + 128 <= bytes; i += 128) {
+                    const __m256i result = _mm256_or_si256(
+                            _mm256_or_si256(load(data + i), load(data + i + 32)),
+                            _mm256_or_si256(load(data + i + 64), load(data + i + 96)));
+                    if (!_mm256_testz_si256(result, masks)) {
+                        return true;
+                    }
+                }
+                for (; i + 32 <= bytes; i += 32) {
+                    if (!_mm256_testz_si256(load(data + i), masks)) {
+                        return true;
+                    }
+                }
+                return scalar_kernels::any(data + i, bytes - i, mask);
+            }
+
+            TRAK_TARGET("avx2") inline bool all(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept {
+                const __m256i masks = _mm256_set1_epi64x(static_cast<long long>(mask));
+                __m256i missing = _mm256_setzero_si256();
+                std::size_t i = 0;
+                for (; i + 32 <= bytes; i += 32) {
+                    missing = _mm256_or_si256(missing, _mm256_andnot_si256(load(data + i), masks));
+                }
+                return _mm256_testz_si256(missing, missing) && scalar_kernels::all(data + i, bytes - i, mask);
+            }
+
+            TRAK_TARGET("avx2") inline std::size_t count(const unsigned char* data, std::size_t bytes) noexcept {
+                // Counts the bits of each nibble by table lookup, then sums the bytes of each 64-bit lane.
+                const __m256i lookup = _mm256_setr_epi8(
+                        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+                const __m256i low = _mm256_set1_epi8(0x0f);
+                __m256i sums = _mm256_setzero_si256();
+                std::size_t i = 0;
+                for (; i + 32 <= bytes; i += 32) {
+                    const __m256i value = load(data + i);
+                    const __m256i counts = _mm256_add_epi8(
+                            _mm256_shuffle_epi8(lookup, _mm256_and_si256(value, low)),
+                            _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(value, 4), low)));
+                    sums = _mm256_add_epi64(sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+                }
+                const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+                // Sums the lanes through memory, as the 64-bit extractions are only declared on x86-64.
+                std::uint64_t lanes[2];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), half);
+                return static_cast<std::size_t>(lanes[0] + lanes[1]) + scalar_kernels::count(data + i, bytes - i);
+            }
+
+            TRAK_TARGET("avx2") inline std::size_t mismatch(const unsigned char* lhs, const unsigned char* rhs, std::size_t bytes, std::uint64_t mask) noexcept {
+                const __m256i masks = _mm256_set1_epi64x(static_cast<long long>(mask));
+                std::size_t i = 0;
+                while (i + 32 <= bytes && _mm256_testz_si256(_mm256_xor_si256(load(lhs + i), load(rhs + i)), masks)) {
+                    i += 32;
+                }
+                return i + scalar_kernels::mismatch(lhs + i, rhs + i, bytes - i, mask);
+            }
+        }
+
+        namespace avx512_kernels {
+
+            TRAK_TARGET("avx512f,avx512bw") inline __m512i load(const unsigned char* data) noexcept {
+                return _mm512_loadu_si512(data);
+            }
+
+            TRAK_TARGET("avx512f,avx512bw") inline void store(unsigned char* data, __m512i value) noexcept {
+                _mm512_storeu_si512(data, value);
+            }
+
+            TRAK_TARGET("avx512f,avx512bw") inline void bit_or(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 64 <= bytes; i += 64) {
+                    store(dst + i, _mm512_or_si512(load(dst + i), load(src + i)));
+                }
+                avx2_kernels::bit_or(dst + i, src + i, bytes - i);
+            }
+
+            TRAK_TARGET("avx512f,avx512bw") inline void bit_and(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 64 <= bytes; i += 64) {
+                    store(dst + i, _mm512_and_si512(load(dst + i), load(src + i)));
+                }
+                avx2_kernels::bit_and(dst + i, src + i, bytes - i);
+            }
+
+            TRAK_TARGET("avx512f,avx512bw") inline void bit_xor(unsigned char* dst, const unsigned char* src, std::size_t bytes) noexcept {
+                std::size_t i = 0;
+                for (; i + 64 <= bytes; i += 64) {
+                    store(dst + i, _mm512_xor_si512(load(dst + i), load(src + i)));
+                }
+                avx2_kernels::bit_xor(dst + i, src + i, bytes - i);
+            }
+
+            TRAK_TARGET("avx512f,avx512bw") inline bool any(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept {
+                const __m512i masks = _mm512_set1_epi64(static_cast<long long>(mask));
+                std::size_t i = 0;
+                for (; i + 256 <= bytes; i += 256) {
+                    const __m512i result = _mm512_or_si512(
+                            _mm512_or_si512(load(data + i), load(data + i + 64)),
+                            _mm512_or_si512(load(data + i + 128), load(data + i + 192)));
+                    if (_mm512_test_epi64_mask(result, masks)) {
+                        return true;
+                    }
+                }
+                for (; i + 64 <= bytes; i += 64) {
+                    if (_mm512_test_epi64_mask(load(data + i), masks)) {
+                        return true;
+                    }
+                }
+                return avx2_kernels::any(data + i, bytes - i, mask);
+            }
+
+            TRAK_TARGET("avx512f,avx512bw") inline bool all(const unsigned char* data, std::size_t bytes, std::uint64_t mask) noexcept {
+                const __m512i masks = _mm512_set1_epi64(static_cast<long long>(mask));
+                __m512i missing = _mm512_setzero_si512();
+                std::size_t i = 0;
+                for (; i + 64 <= bytes; i += 64) {
+                    // missing | (masks & ~value), in one instruction.
+                    missing = _mm512_ternarylogic_epi64(missing, load(data + i), masks, 0xf2);
+                }
+                return !_mm512_test_epi64_mask(missing, missing) && avx2_kernels::all(data + i, bytes - i, mask);
+            }
+
+            TRAK_TARGET("avx512f,avx512bw") inline std::size_t count(const unsigned char* data, std::size_t bytes) noexcept {
+                // The unmasked broadcast and reduction of GCC 12 read an uninitialized operand, which -Wuninitialized
+                // reports in optimized builds.
+                const __m512i lookup = _mm512_maskz_broadcast_i32x4(0xffff, _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+                const __m512i low = _mm512_set1_epi8(0x0f);
+                __m512i sums = _mm512_setzero_si512();
+                std::size_t i = 0;
+                for (; i + 64 <= bytes; i += 64) {
+                    const __m512i value = load(data + i);
+                    const __m512i counts = _mm512_add_epi8(
+                            _mm512_shuffle_epi8(lookup, _mm512_and_si512(value, low)),
+                            _mm512_shuffle_epi8(lookup, _mm512_and_si512(_mm512_srli_epi16(value, 4), low)));
+                    sums = _mm512_add_epi64(sums, _mm512_sad_epu8(counts, _mm512_setzero_si512()));
+                }
+                std::uint64_t lanes[8];
+                _mm512_storeu_si512(lanes, sums);
+                std::uint64_t total = 0;
+                for (const auto lane : lanes) {
+                    total += lane;
+                }
+                return static_cast<std::size_t>(total) + avx2_kernels::count(data + i, bytes - i);
+            }
+
+            TRAK_TARGET("avx512f,avx512bw") inline std::size_t mismatch(const unsigned char* lhs, const unsigned char* rhs, std::size_t bytes, std::uint64_t mask) noexcept {
+                const __m512i masks = _mm512_set1_epi64(static_cast<long long>(mask));
+                std::size_t i = 0;
+                while (i + 64 <= bytes && !_mm512_test_epi64_mask(_mm512_xor_si512(load(lhs + i), load(rhs + i)), masks)) {
+                    i += 64;
+                }
+                return i + avx2_kernels::mismatch(lhs + i, rhs + i, bytes - i, mask);
+            }
+        }
+#endif
+
+        /**
+         * Returns the bitfield kernels of the given simd_level, which needs to be supported by the executing CPU.
+         */
+        inline const bitfield_kernels& bitfield_kernels_for(simd_level level) noexcept {
+            static constexpr bitfield_kernels scalar = {
+                    scalar_kernels::bit_or, scalar_kernels::bit_and, scalar_kernels::bit_xor,
+                    scalar_kernels::any, scalar_kernels::all, scalar_kernels::count, scalar_kernels::mismatch};
+#if TRAK_SIMD_X86
+            static constexpr bitfield_kernels sse2 = {
+                    sse2_kernels::bit_or, sse2_kernels::bit_and, sse2_kernels::bit_xor,
+                    sse2_kernels::any, sse2_kernels::all, scalar_kernels::count, sse2_kernels::mismatch};
+            static constexpr bitfield_kernels avx2 = {
+                    avx2_kernels::bit_or, avx2_kernels::bit_and, avx2_kernels::bit_xor,
+                    avx2_kernels::any, avx2_kernels::all, avx2_kernels::count, avx2_kernels::mismatch};
+            static constexpr bitfield_kernels avx512 = {
+                    avx512_kernels::bit_or, avx512_kernels::bit_and, avx512_kernels::bit_xor,
+                    avx512_kernels::any, avx512_kernels::all, avx512_kernels::count, avx512_kernels::mismatch};
+            switch (level) {
+                case simd_level::avx512:
+                    return avx512;
+                case simd_level::avx2:
+                    return avx2;
+                case simd_level::sse2:
+                    return sse2;
+                default:
+                    return scalar;
+            }
+#else
+            static_cast<void>(level);
+            return scalar;
+#endif
+        }
+
+        /**
+         * Returns the bitfield kernels of the highest simd_level supported by the executing CPU.
+         */
+        inline const bitfield_kernels& active_bitfield_kernels() noexcept {
+            static const bitfield_kernels& kernels = bitfield_kernels_for(detect_simd_level());
+            return kernels;
+        }
+    }
+}
+
+#endif //TRAK_DETAIL_BITFIELD_KERNELS_HPP
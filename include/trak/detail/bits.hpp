@@ -0,0 +1,37 @@
+#ifndef TRAK_DETAIL_BITS_HPP
+#define TRAK_DETAIL_BITS_HPP
+
+#include <cstdint>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * Returns the number of bits set in value.
+         */
+        constexpr unsigned int popcount64(std::uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned int>(__builtin_popcountll(value));
+#else
+            value = value - ((value >> 1u) & 0x5555555555555555ull);
+            value = (value & 0x3333333333333333ull) + ((value >> 2u) & 0x3333333333333333ull);
+            value = (value + (value >> 4u)) & 0x0f0f0f0f0f0f0f0full;
+            return static_cast<unsigned int>((value * 0x0101010101010101ull) >> 56u);
+#endif
+        }
+
+        /**
+         * Returns the index of the lowest bit set in value, which must not be zero.
+         */
+        constexpr unsigned int countr_zero64(std::uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned int>(__builtin_ctzll(value));
+#else
+            return popcount64((value & (~value + 1u)) - 1u);
+#endif
+        }
+    }
+}
+
+#endif //TRAK_DETAIL_BITS_HPP
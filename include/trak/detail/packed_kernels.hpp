@@ -0,0 +1,114 @@
+#ifndef TRAK_DETAIL_PACKED_KERNELS_HPP
+#define TRAK_DETAIL_PACKED_KERNELS_HPP
+
+#include <trak/detail/simd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * Kernel unpacking count values of width bits, starting at the value first, from the packed bits of data
+         * into out. The width needs to be at most 24, and data needs to be readable 8 bytes past the last value.
+         */
+        using unpack_kernel = void (*)(const unsigned char* data, std::size_t first, std::size_t count, unsigned int width,
+                                       std::uint32_t* out) noexcept;
+
+        namespace scalar_kernels {
+
+            inline void unpack(const unsigned char* data, std::size_t first, std::size_t count, unsigned int width,
+                               std::uint32_t* out) noexcept {
+                const auto mask = (std::uint64_t{1} << width) - 1;
+                auto bit = static_cast<std::uint64_t>(first) * width;
+                for (std::size_t i = 0; i < count; ++i, bit += width) {
+                    std::uint64_t word;
+                    std::memcpy(&word, data + bit / 8, sizeof(word));
+                    out[i] = static_cast<std::uint32_t>((word >> (bit % 8)) & mask);
+                }
+            }
+        }
+
+#if TRAK_SIMD_X86
+        namespace avx2_kernels {
+
+            /**
+             * Gathers 8 values at a time, each from the 4 bytes containing it, relative to the byte of the first.
+             */
+            TRAK_TARGET("avx2") inline void unpack(const unsigned char* data, std::size_t first, std::size_t count,
+                                                   unsigned int width, std::uint32_t* out) noexcept {
+                const __m256i lanes = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(width)));
+                const __m256i mask = _mm256_set1_epi32(static_cast<int>((1u << width) - 1));
+                const __m256i byte_mask = _mm256_set1_epi32(7);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    const auto bit = static_cast<std::uint64_t>(first + i) * width;
+                    const auto base = reinterpret_cast<const int*>(data + bit / 8);
+                    const __m256i bits = _mm256_add_epi32(lanes, _mm256_set1_epi32(static_cast<int>(bit % 8)));
+                    const __m256i words = _mm256_i32gather_epi32(base, _mm256_srli_epi32(bits, 3), 1);
+                    const __m256i values = _mm256_and_si256(_mm256_srlv_epi32(words, _mm256_and_si256(bits, byte_mask)), mask);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+                }
+                scalar_kernels::unpack(data, first + i, count - i, width, out + i);
+            }
+        }
+
+        namespace avx512_kernels {
+
+            TRAK_TARGET("avx512f,avx512bw") inline void unpack(const unsigned char* data, std::size_t first, std::size_t count,
+                                                               unsigned int width, std::uint32_t* out) noexcept {
+                const __m512i lanes = _mm512_mullo_epi32(
+                        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(static_cast<int>(width)));
+                const __m512i mask = _mm512_set1_epi32(static_cast<int>((1u << width) - 1));
+                const __m512i byte_mask = _mm512_set1_epi32(7);
+                // The unmasked gather and shifts of GCC 12 read an uninitialized operand, which -Wuninitialized
+                // reports in optimized builds. The zeroed gather destination also breaks its dependency on the
+                // previous iteration.
+                const __mmask16 all = 0xffff;
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    const auto bit = static_cast<std::uint64_t>(first + i) * width;
+                    const __m512i bits = _mm512_add_epi32(lanes, _mm512_set1_epi32(static_cast<int>(bit % 8)));
+                    const __m512i words = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), all, _mm512_maskz_srli_epi32(all, bits, 3),
+                                                                      data + bit / 8, 1);
+                    const __m512i values = _mm512_and_si512(_mm512_maskz_srlv_epi32(all, words, _mm512_and_si512(bits, byte_mask)), mask);
+                    _mm512_storeu_si512(out + i, values);
+                }
+                avx2_kernels::unpack(data, first + i, count - i, width, out + i);
+            }
+        }
+#endif
+
+        /**
+         * Returns the unpack kernel of the given simd_level, which needs to be supported by the executing CPU.
+         */
+        inline unpack_kernel unpack_kernel_for(simd_level level) noexcept {
+#if TRAK_SIMD_X86
+            switch (level) {
+                case simd_level::avx512:
+                    return avx512_kernels::unpack;
+                case simd_level::avx2:
+                    return avx2_kernels::unpack;
+                default:
+                    return scalar_kernels::unpack;
+            }
+#else
+            static_cast<void>(level);
+            return scalar_kernels::unpack;
+#endif
+        }
+
+        /**
+         * Returns the unpack kernel of the highest simd_level supported by the executing CPU.
+         */
+        inline unpack_kernel active_unpack_kernel() noexcept {
+            static const unpack_kernel kernel = unpack_kernel_for(detect_simd_level());
+            return kernel;
+        }
+    }
+}
+
+#endif //TRAK_DETAIL_PACKED_KERNELS_HPP
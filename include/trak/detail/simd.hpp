@@ -0,0 +1,57 @@
+#ifndef TRAK_DETAIL_SIMD_HPP
+#define TRAK_DETAIL_SIMD_HPP
+
+/**
+ * TRAK_SIMD_X86 is 1 if x86 SIMD kernels are compiled, which requires GCC or Clang for per-function target
+ * attributes. Define TRAK_NO_SIMD to compile the scalar kernels only.
+ */
+#if !defined(TRAK_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TRAK_SIMD_X86 1
+#include <immintrin.h>
+#define TRAK_TARGET(isa) __attribute__((target(isa)))
+#else
+#define TRAK_SIMD_X86 0
+#define TRAK_TARGET(isa)
+#endif
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * The instruction set extensions kernels are selected for, in ascending order.
+         */
+        enum class simd_level {
+            scalar,
+            sse2,
+            avx2,
+            avx512
+        };
+
+        /**
+         * Returns the highest simd_level supported by the executing CPU. The CPU is queried once.
+         */
+        inline simd_level detect_simd_level() noexcept {
+#if TRAK_SIMD_X86
+            static const simd_level level = [] {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+                    return simd_level::avx512;
+                }
+                if (__builtin_cpu_supports("avx2")) {
+                    return simd_level::avx2;
+                }
+                if (__builtin_cpu_supports("sse2")) {
+                    return simd_level::sse2;
+                }
+                return simd_level::scalar;
+            }();
+            return level;
+#else
+            return simd_level::scalar;
+#endif
+        }
+    }
+}
+
+#endif //TRAK_DETAIL_SIMD_HPP
@@ -0,0 +1,50 @@
+#ifndef TRAK_DETAIL_TYPE_NAME_HPP
+#define TRAK_DETAIL_TYPE_NAME_HPP
+
+#include <string_view>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * Extracts the name of the template argument from the signature of type_name.
+         */
+        constexpr std::string_view parse_type_name(std::string_view signature) noexcept {
+#if defined(__clang__) || defined(__GNUC__)
+            // GCC: "... [with T = ns::A; ...]", Clang: "... [T = ns::A]"
+            const auto start = signature.find("T = ");
+            if (start == std::string_view::npos) {
+                return {};
+            }
+            auto name = signature.substr(start + 4);
+            return name.substr(0, name.find_first_of(";]"));
+#elif defined(_MSC_VER)
+            // MSVC: "... type_name<enum ns::A>(void)"
+            const auto start = signature.find("type_name<");
+            const auto end = signature.rfind(">(");
+            if (start == std::string_view::npos || end == std::string_view::npos) {
+                return {};
+            }
+            auto name = signature.substr(start + 10, end - start - 10);
+            return name.substr(0, 5) == "enum " ? name.substr(5) : name;
+#else
+            return {};
+#endif
+        }
+
+        /**
+         * Returns the qualified name of T.
+         */
+        template<typename T>
+        constexpr std::string_view type_name() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            return parse_type_name(__FUNCSIG__);
+#else
+            return parse_type_name(__PRETTY_FUNCTION__);
+#endif
+        }
+    }
+}
+
+#endif //TRAK_DETAIL_TYPE_NAME_HPP
@@ -0,0 +1,340 @@
+#ifndef TRAK_DETAIL_VALIDATE_KERNELS_HPP
+#define TRAK_DETAIL_VALIDATE_KERNELS_HPP
+
+#include <trak/detail/bits.hpp>
+#include <trak/detail/simd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * The largest number of intervals of valid values checked by the vectorized kernels.
+         */
+        constexpr std::size_t max_validate_intervals = 8;
+
+        /**
+         * Kernels validating unsigned values of type U. Valid values either lie in one of the intervals
+         * [first[i], first[i] + extent[i]], with wrap-around arithmetic, or have no bit of invalid set.
+         */
+        template<typename U>
+        struct validate_kernels {
+            /** Returns the index of the first value outside all intervals, or count if there is none. */
+            std::size_t (*first_outside)(const U* data, std::size_t count, const U* first, const U* extent, std::size_t intervals) noexcept;
+            /** Returns the index of the first value with a bit of invalid set, or count if there is none. */
+            std::size_t (*first_with_bits)(const U* data, std::size_t count, U invalid) noexcept;
+        };
+
+        namespace scalar_kernels {
+
+            template<typename U>
+            inline std::size_t first_outside(const U* data, std::size_t count, const U* first, const U* extent, std::size_t intervals) noexcept {
+                for (std::size_t i = 0; i < count; ++i) {
+                    bool valid = false;
+                    for (std::size_t k = 0; k < intervals; ++k) {
+                        valid |= static_cast<U>(data[i] - first[k]) <= extent[k];
+                    }
+                    if (!valid) {
+                        return i;
+                    }
+                }
+                return count;
+            }
+
+            template<typename U>
+            inline std::size_t first_with_bits(const U* data, std::size_t count, U invalid) noexcept {
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (data[i] & invalid) {
+                        return i;
+                    }
+                }
+                return count;
+            }
+        }
+
+#if TRAK_SIMD_X86
+        namespace sse2_kernels {
+
+            template<typename U>
+            TRAK_TARGET("sse2") inline __m128i set1(U value) noexcept {
+                if constexpr (sizeof(U) == 1) {
+                    return _mm_set1_epi8(static_cast<char>(value));
+                } else if constexpr (sizeof(U) == 2) {
+                    return _mm_set1_epi16(static_cast<short>(value));
+                } else if constexpr (sizeof(U) == 4) {
+                    return _mm_set1_epi32(static_cast<int>(value));
+                } else {
+                    return _mm_set1_epi64x(static_cast<long long>(value));
+                }
+            }
+
+            template<typename U>
+            TRAK_TARGET("sse2") inline __m128i sub(__m128i lhs, __m128i rhs) noexcept {
+                if constexpr (sizeof(U) == 1) {
+                    return _mm_sub_epi8(lhs, rhs);
+                } else if constexpr (sizeof(U) == 2) {
+                    return _mm_sub_epi16(lhs, rhs);
+                } else {
+                    return _mm_sub_epi32(lhs, rhs);
+                }
+            }
+
+            template<typename U>
+            TRAK_TARGET("sse2") inline __m128i cmpgt(__m128i lhs, __m128i rhs) noexcept {
+                if constexpr (sizeof(U) == 1) {
+                    return _mm_cmpgt_epi8(lhs, rhs);
+                } else if constexpr (sizeof(U) == 2) {
+                    return _mm_cmpgt_epi16(lhs, rhs);
+                } else {
+                    return _mm_cmpgt_epi32(lhs, rhs);
+                }
+            }
+
+            /**
+             * Compares unsigned distances to the extents as signed integers by flipping their sign bits, which
+             * needs no unsigned comparison instructions. 64-bit values use the scalar kernel, lacking a 64-bit
+             * comparison in SSE2.
+             */
+            template<typename U>
+            TRAK_TARGET("sse2") inline std::size_t first_outside(const U* data, std::size_t count, const U* first, const U* extent, std::size_t intervals) noexcept {
+                if constexpr (sizeof(U) == 8) {
+                    return scalar_kernels::first_outside(data, count, first, extent, intervals);
+                } else {
+                    constexpr std::size_t lanes = 16 / sizeof(U);
+                    const __m128i sign = set1<U>(static_cast<U>(U{1} << (8 * sizeof(U) - 1)));
+                    __m128i firsts[max_validate_intervals];
+                    __m128i extents[max_validate_intervals];
+                    for (std::size_t k = 0; k < intervals; ++k) {
+                        firsts[k] = set1<U>(first[k]);
+                        extents[k] = _mm_xor_si128(set1<U>(extent[k]), sign);
+                    }
+                    std::size_t i = 0;
+                    for (; i + lanes <= count; i += lanes) {
+                        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                        __m128i outside = _mm_set1_epi8(-1);
+                        for (std::size_t k = 0; k < intervals; ++k) {
+                            outside = _mm_and_si128(outside, cmpgt<U>(_mm_xor_si128(sub<U>(value, firsts[k]), sign), extents[k]));
+                        }
+                        if (const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(outside))) {
+                            return i + countr_zero64(mask) / sizeof(U);
+                        }
+                    }
+                    return i + scalar_kernels::first_outside(data + i, count - i, first, extent, intervals);
+                }
+            }
+
+            template<typename U>
+            TRAK_TARGET("sse2") inline std::size_t first_with_bits(const U* data, std::size_t count, U invalid) noexcept {
+                constexpr std::size_t lanes = 16 / sizeof(U);
+                const __m128i invalids = set1<U>(invalid);
+                std::size_t i = 0;
+                for (; i + lanes <= count; i += lanes) {
+                    const __m128i bits = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), invalids);
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) != 0xffff) {
+                        break;
+                    }
+                }
+                return i + scalar_kernels::first_with_bits(data + i, count - i, invalid);
+            }
+        }
+
+        namespace avx2_kernels {
+
+            template<typename U>
+            TRAK_TARGET("avx2") inline __m256i set1(U value) noexcept {
+                if constexpr (sizeof(U) == 1) {
+                    return _mm256_set1_epi8(static_cast<char>(value));
+                } else if constexpr (sizeof(U) == 2) {
+                    return _mm256_set1_epi16(static_cast<short>(value));
+                } else if constexpr (sizeof(U) == 4) {
+                    return _mm256_set1_epi32(static_cast<int>(value));
+                } else {
+                    return _mm256_set1_epi64x(static_cast<long long>(value));
+                }
+            }
+
+            template<typename U>
+            TRAK_TARGET("avx2") inline __m256i sub(__m256i lhs, __m256i rhs) noexcept {
+                if constexpr (sizeof(U) == 1) {
+                    return _mm256_sub_epi8(lhs, rhs);
+                } else if constexpr (sizeof(U) == 2) {
+                    return _mm256_sub_epi16(lhs, rhs);
+                } else if constexpr (sizeof(U) == 4) {
+                    return _mm256_sub_epi32(lhs, rhs);
+                } else {
+                    return _mm256_sub_epi64(lhs, rhs);
+                }
+            }
+
+            template<typename U>
+            TRAK_TARGET("avx2") inline __m256i cmpgt(__m256i lhs, __m256i rhs) noexcept {
+                if constexpr (sizeof(U) == 1) {
+                    return _mm256_cmpgt_epi8(lhs, rhs);
+                } else if constexpr (sizeof(U) == 2) {
+                    return _mm256_cmpgt_epi16(lhs, rhs);
+                } else if constexpr (sizeof(U) == 4) {
+                    return _mm256_cmpgt_epi32(lhs, rhs);
+                } else {
+                    return _mm256_cmpgt_epi64(lhs, rhs);
+                }
+            }
+
+            template<typename U>
+            TRAK_TARGET("avx2") inline std::size_t first_outside(const U* data, std::size_t count, const U* first, const U* extent, std::size_t intervals) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(U);
+                const __m256i sign = set1<U>(static_cast<U>(U{1} << (8 * sizeof(U) - 1)));
+                __m256i firsts[max_validate_intervals];
+                __m256i extents[max_validate_intervals];
+                for (std::size_t k = 0; k < intervals; ++k) {
+                    firsts[k] = set1<U>(first[k]);
+                    extents[k] = _mm256_xor_si256(set1<U>(extent[k]), sign);
+                }
+                std::size_t i = 0;
+                for (; i + lanes <= count; i += lanes) {
+                    const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                    __m256i outside = _mm256_set1_epi8(-1);
+                    for (std::size_t k = 0; k < intervals; ++k) {
+                        outside = _mm256_and_si256(outside, cmpgt<U>(_mm256_xor_si256(sub<U>(value, firsts[k]), sign), extents[k]));
+                    }
+                    if (!_mm256_testz_si256(outside, outside)) {
+                        const auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(outside));
+                        return i + countr_zero64(mask) / sizeof(U);
+                    }
+                }
+                return i + sse2_kernels::first_outside(data + i, count - i, first, extent, intervals);
+            }
+
+            template<typename U>
+            TRAK_TARGET("avx2") inline std::size_t first_with_bits(const U* data, std::size_t count, U invalid) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(U);
+                const __m256i invalids = set1<U>(invalid);
+                std::size_t i = 0;
+                // Test four vectors at a time, locating the exact value only once a vector fails.
+                for (; i + 4 * lanes <= count; i += 4 * lanes) {
+                    const auto* block = reinterpret_cast<const __m256i*>(data + i);
+                    const __m256i bits = _mm256_or_si256(
+                            _mm256_or_si256(_mm256_loadu_si256(block), _mm256_loadu_si256(block + 1)),
+                            _mm256_or_si256(_mm256_loadu_si256(block + 2), _mm256_loadu_si256(block + 3)));
+                    if (!_mm256_testz_si256(bits, invalids)) {
+                        break;
+                    }
+                }
+                return i + scalar_kernels::first_with_bits(data + i, count - i, invalid);
+            }
+        }
+
+        namespace avx512_kernels {
+
+            template<typename U>
+            TRAK_TARGET("avx512f,avx512bw") inline __m512i set1(U value) noexcept {
+                if constexpr (sizeof(U) == 1) {
+                    return _mm512_set1_epi8(static_cast<char>(value));
+                } else if constexpr (sizeof(U) == 2) {
+                    return _mm512_set1_epi16(static_cast<short>(value));
+                } else if constexpr (sizeof(U) == 4) {
+                    return _mm512_set1_epi32(static_cast<int>(value));
+                } else {
+                    return _mm512_set1_epi64(static_cast<long long>(value));
+                }
+            }
+
+            /**
+             * Returns a mask of the values of value - first being greater than extent as unsigned integers.
+             */
+            template<typename U>
+            TRAK_TARGET("avx512f,avx512bw") inline std::uint64_t outside(__m512i value, __m512i first, __m512i extent) noexcept {
+                if constexpr (sizeof(U) == 1) {
+                    return _mm512_cmpgt_epu8_mask(_mm512_sub_epi8(value, first), extent);
+                } else if constexpr (sizeof(U) == 2) {
+                    return _mm512_cmpgt_epu16_mask(_mm512_sub_epi16(value, first), extent);
+                } else if constexpr (sizeof(U) == 4) {
+                    return _mm512_cmpgt_epu32_mask(_mm512_sub_epi32(value, first), extent);
+                } else {
+                    return _mm512_cmpgt_epu64_mask(_mm512_sub_epi64(value, first), extent);
+                }
+            }
+
+            template<typename U>
+            TRAK_TARGET("avx512f,avx512bw") inline std::size_t first_outside(const U* data, std::size_t count, const U* first, const U* extent, std::size_t intervals) noexcept {
+                constexpr std::size_t lanes = 64 / sizeof(U);
+                __m512i firsts[max_validate_intervals];
+                __m512i extents[max_validate_intervals];
+                for (std::size_t k = 0; k < intervals; ++k) {
+                    firsts[k] = set1<U>(first[k]);
+                    extents[k] = set1<U>(extent[k]);
+                }
+                std::size_t i = 0;
+                for (; i + lanes <= count; i += lanes) {
+                    const __m512i value = _mm512_loadu_si512(data + i);
+                    std::uint64_t mask = ~std::uint64_t{0};
+                    for (std::size_t k = 0; k < intervals; ++k) {
+                        mask &= outside<U>(value, firsts[k], extents[k]);
+                    }
+                    if (mask) {
+                        return i + countr_zero64(mask);
+                    }
+                }
+                return i + avx2_kernels::first_outside(data + i, count - i, first, extent, intervals);
+            }
+
+            template<typename U>
+            TRAK_TARGET("avx512f,avx512bw") inline std::size_t first_with_bits(const U* data, std::size_t count, U invalid) noexcept {
+                constexpr std::size_t lanes = 64 / sizeof(U);
+                const __m512i invalids = set1<U>(invalid);
+                std::size_t i = 0;
+                for (; i + 4 * lanes <= count; i += 4 * lanes) {
+                    const __m512i bits = _mm512_or_si512(
+                            _mm512_or_si512(_mm512_loadu_si512(data + i), _mm512_loadu_si512(data + i + lanes)),
+                            _mm512_or_si512(_mm512_loadu_si512(data + i + 2 * lanes), _mm512_loadu_si512(data + i + 3 * lanes)));
+                    if (_mm512_test_epi64_mask(bits, invalids)) {
+                        break;
+                    }
+                }
+                return i + avx2_kernels::first_with_bits(data + i, count - i, invalid);
+            }
+        }
+#endif
+
+        /**
+         * Returns the validation kernels of the given simd_level, which needs to be supported by the executing CPU.
+         */
+        template<typename U>
+        inline const validate_kernels<U>& validate_kernels_for(simd_level level) noexcept {
+            static_assert(std::is_unsigned<U>::value, "U is not an unsigned integer");
+            static constexpr validate_kernels<U> scalar = {scalar_kernels::first_outside<U>, scalar_kernels::first_with_bits<U>};
+#if TRAK_SIMD_X86
+            static constexpr validate_kernels<U> sse2 = {sse2_kernels::first_outside<U>, sse2_kernels::first_with_bits<U>};
+            static constexpr validate_kernels<U> avx2 = {avx2_kernels::first_outside<U>, avx2_kernels::first_with_bits<U>};
+            static constexpr validate_kernels<U> avx512 = {avx512_kernels::first_outside<U>, avx512_kernels::first_with_bits<U>};
+            switch (level) {
+                case simd_level::avx512:
+                    return avx512;
+                case simd_level::avx2:
+                    return avx2;
+                case simd_level::sse2:
+                    return sse2;
+                default:
+                    return scalar;
+            }
+#else
+            static_cast<void>(level);
+            return scalar;
+#endif
+        }
+
+        /**
+         * Returns the validation kernels of the highest simd_level supported by the executing CPU.
+         */
+        template<typename U>
+        inline const validate_kernels<U>& active_validate_kernels() noexcept {
+            static const validate_kernels<U>& kernels = validate_kernels_for<U>(detect_simd_level());
+            return kernels;
+        }
+    }
+}
+
+#endif //TRAK_DETAIL_VALIDATE_KERNELS_HPP
@@ -0,0 +1,187 @@
+#ifndef TRAK_DISPATCH_HPP
+#define TRAK_DISPATCH_HPP
+
+#include <trak/enum_indexer.hpp>
+#include <trak/enum_reflection.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * The fallback of dispatch if none is given, returning a value-initialized result.
+         */
+        template<typename R>
+        struct default_dispatch_fallback {
+            template<typename E>
+            constexpr R operator()(E) const noexcept {
+                if constexpr (!std::is_void<R>::value) {
+                    return R{};
+                }
+            }
+        };
+
+        /**
+         * The common result type of invoking F with the integral constant of each enumerator of E.
+         */
+        template<typename E, typename F, typename = std::make_index_sequence<enum_reflection<E>::size>>
+        struct dispatch_result;
+
+        template<typename E, typename F, std::size_t... Is>
+        struct dispatch_result<E, F, std::index_sequence<Is...>> {
+            using type = typename std::common_type<
+                    typename std::invoke_result<F&, std::integral_constant<E, enum_reflection<E>::values[Is]>>::type...>::type;
+        };
+
+        template<typename E, typename F>
+        struct dispatch_result<E, F, std::index_sequence<>> {
+            using type = void;
+        };
+
+        template<typename R, typename E, E V, typename F, typename G>
+        constexpr R dispatch_case(F& handler, G&, E) {
+            return static_cast<R>(handler(std::integral_constant<E, V>{}));
+        }
+
+        template<typename R, typename E, typename F, typename G>
+        constexpr R dispatch_fallback(F&, G& fallback, E value) {
+            return static_cast<R>(fallback(value));
+        }
+
+        /**
+         * Checks whether dispatching on E uses a jump table, being the case if E has at least 4 enumerators
+         * and its value range is at most 3 times its number of enumerators. Otherwise, a binary search tree
+         * of comparisons is used.
+         */
+        template<typename E>
+        struct uses_dispatch_table {
+            using underlying_type = typename std::underlying_type<E>::type;
+            static constexpr std::size_t size = enum_reflection<E>::size;
+
+            static constexpr std::uint64_t range = size == 0 ? 0
+                    : static_cast<std::uint64_t>(static_cast<underlying_type>(enum_reflection<E>::values[size - 1]))
+                      - static_cast<std::uint64_t>(static_cast<underlying_type>(enum_reflection<E>::values[0])) + 1;
+
+            static constexpr bool value = size >= 4 && range <= 3 * static_cast<std::uint64_t>(size);
+        };
+
+        /**
+         * Jump table with an entry for each value from the smallest to the largest enumerator of E. Values
+         * without enumerator invoke the fallback.
+         */
+        template<typename E, typename R, typename F, typename G>
+        struct dispatch_table {
+            using underlying_type = typename std::underlying_type<E>::type;
+            using entry = R (*)(F&, G&, E);
+
+            static constexpr std::uint64_t min = static_cast<std::uint64_t>(static_cast<underlying_type>(enum_reflection<E>::values[0]));
+            static constexpr std::size_t size = static_cast<std::size_t>(uses_dispatch_table<E>::range);
+
+            template<std::size_t I>
+            static constexpr entry make_entry() noexcept {
+                constexpr auto value = static_cast<E>(static_cast<underlying_type>(min + I));
+                if constexpr (enum_reflection<E>::index_of(value) < enum_reflection<E>::size) {
+                    return &dispatch_case<R, E, value, F, G>;
+                } else {
+                    return &dispatch_fallback<R, E, F, G>;
+                }
+            }
+
+            template<std::size_t... Is>
+            static constexpr std::array<entry, size> make_entries(std::index_sequence<Is...>) noexcept {
+                return {{make_entry<Is>()...}};
+            }
+
+            static constexpr std::array<entry, size> entries = make_entries(std::make_index_sequence<size>{});
+
+            static constexpr R invoke(E value, F& handler, G& fallback) {
+                const auto index = static_cast<std::uint64_t>(static_cast<underlying_type>(value)) - min;
+                return index < size ? entries[index](handler, fallback, value) : dispatch_fallback<R>(handler, fallback, value);
+            }
+        };
+
+        /**
+         * Binary search tree over the enumerators of E with the indices [First, Last) in enum_reflection<E>::values.
+         */
+        template<typename E, typename R, std::size_t First, std::size_t Last, typename F, typename G>
+        constexpr R dispatch_tree(E value, F& handler, G& fallback) {
+            using underlying_type = typename std::underlying_type<E>::type;
+            if constexpr (Last - First == 0) {
+                return dispatch_fallback<R>(handler, fallback, value);
+            } else if constexpr (Last - First == 1) {
+                constexpr auto candidate = enum_reflection<E>::values[First];
+                return value == candidate
+                        ? dispatch_case<R, E, candidate>(handler, fallback, value)
+                        : dispatch_fallback<R>(handler, fallback, value);
+            } else {
+                constexpr auto middle = First + (Last - First) / 2;
+                constexpr auto pivot = static_cast<underlying_type>(enum_reflection<E>::values[middle]);
+                return static_cast<underlying_type>(value) < pivot
+                        ? dispatch_tree<E, R, First, middle>(value, handler, fallback)
+                        : dispatch_tree<E, R, middle, Last>(value, handler, fallback);
+            }
+        }
+    }
+
+    /**
+     * Invokes handler with std::integral_constant<E, value>, so each enumerator is handled by a separate
+     * specialization of handler. Values without enumerator invoke fallback with the value instead.
+     *
+     * Enums whose enumerators are dense dispatch through a jump table, others through a binary search tree
+     * of comparisons. Shared enums are dispatched on E, being their first type unless given explicitly.
+     *
+     * @tparam E
+     *      The enum type to dispatch on.
+     * @tparam F
+     *      The type of the handler.
+     * @tparam G
+     *      The type of the fallback.
+     * @param value
+     *      The value to dispatch on.
+     * @param handler
+     *      The handler invoked with the integral constant of each enumerator.
+     * @param fallback
+     *      The handler invoked with values without enumerator.
+     * @return
+     *      The result of the handler, converted to the common result type of all enumerators.
+     */
+    template<typename E, typename F, typename G, typename std::enable_if<std::is_enum<E>::value, int>::type = 0>
+    constexpr inline auto dispatch(E value, F&& handler, G&& fallback) -> typename detail::dispatch_result<E, F>::type {
+        using result = typename detail::dispatch_result<E, F>::type;
+        using handler_type = typename std::remove_reference<F>::type;
+        using fallback_type = typename std::remove_reference<G>::type;
+        if constexpr (detail::uses_dispatch_table<E>::value) {
+            return detail::dispatch_table<E, result, handler_type, fallback_type>::invoke(value, handler, fallback);
+        } else {
+            return detail::dispatch_tree<E, result, 0, enum_reflection<E>::size>(value, handler, fallback);
+        }
+    }
+
+    /**
+     * Invokes handler with std::integral_constant<E, value>. Values without enumerator return a
+     * value-initialized result.
+     */
+    template<typename E, typename F, typename std::enable_if<std::is_enum<E>::value, int>::type = 0>
+    constexpr inline auto dispatch(E value, F&& handler) -> typename detail::dispatch_result<E, F>::type {
+        detail::default_dispatch_fallback<typename detail::dispatch_result<E, F>::type> fallback;
+        return dispatch<E>(value, std::forward<F>(handler), fallback);
+    }
+
+    /**
+     * Dispatches a shared enum on its first type.
+     */
+    template<typename T, typename F, typename... G, typename std::enable_if<detail::is_shared_enum<T>::value, int>::type = 0>
+    constexpr inline auto dispatch(const T& value, F&& handler, G&&... fallback)
+            -> typename detail::dispatch_result<typename detail::index_enum_type<T>::type, F>::type {
+        using enum_type = typename detail::index_enum_type<T>::type;
+        return dispatch<enum_type>(static_cast<enum_type>(value), std::forward<F>(handler), std::forward<G>(fallback)...);
+    }
+}
+
+#endif //TRAK_DISPATCH_HPP
@@ -0,0 +1,432 @@
+#ifndef TRAK_DYNAMIC_SHARED_ENUM_HPP
+#define TRAK_DYNAMIC_SHARED_ENUM_HPP
+
+#include <trak/detail/type_name.hpp>
+#include <trak/dispatch.hpp>
+#include <trak/shared_bitfield.hpp>
+#include <trak/shared_enum.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/**
+ * The number of enum and shared enum types whose descriptions are kept for the conversions and visitation of
+ * dynamic_shared_enum. Types registered beyond it only convert to themselves.
+ */
+#ifndef TRAK_DYNAMIC_ENUM_MAX_TYPES
+#define TRAK_DYNAMIC_ENUM_MAX_TYPES 4096
+#endif
+
+namespace trak {
+
+    class dynamic_shared_enum;
+
+    namespace detail {
+
+        template<typename T, typename = void>
+        struct dynamic_enum_key {};
+
+        template<typename T>
+        struct dynamic_enum_key<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+            using type = T;
+            using underlying_type = typename std::underlying_type<T>::type;
+        };
+
+        template<typename T>
+        struct dynamic_enum_key<T, typename std::enable_if<is_shared_enum<T>::value>::type> {
+            using type = shared_enum_of_t<T>;
+            using underlying_type = typename T::underlying_type;
+        };
+
+        /**
+         * The type identifying T in a dynamic shared enum, being T for enums and the shared enum of the types of
+         * T for shared enums and shared bitfields. Undefined for other types.
+         */
+        template<typename T>
+        using dynamic_enum_key_t = typename dynamic_enum_key<T>::type;
+
+        /**
+         * Describes a type stored in a dynamic shared enum.
+         */
+        struct dynamic_enum_type {
+            std::uint32_t id;
+            std::string_view name;
+
+            /**
+             * Whether the type is a shared enum, whose types are given by the ids of members.
+             */
+            bool shared;
+            const std::uint32_t* members;
+            std::size_t size;
+
+            /**
+             * Returns \c true if the enum with the given id is the type or one of the types of the shared enum.
+             */
+            bool contains(std::uint32_t enum_id) const noexcept {
+                if (!shared) {
+                    return id == enum_id;
+                }
+                for (std::size_t i = 0; i < size; ++i) {
+                    if (members[i] == enum_id) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        };
+
+        /**
+         * The number of assigned type ids plus one, the id 0 being the one of empty dynamic shared enums.
+         */
+        inline std::atomic<std::uint32_t> dynamic_enum_type_count{1};
+
+        /**
+         * The registered types by id, or \c nullptr for ids whose registration is in progress.
+         */
+        inline std::atomic<const dynamic_enum_type*> dynamic_enum_types[TRAK_DYNAMIC_ENUM_MAX_TYPES];
+
+        /**
+         * Returns the registered type of id, or \c nullptr if there is none.
+         */
+        inline const dynamic_enum_type* find_dynamic_enum_type(std::uint32_t id) noexcept {
+            return id < TRAK_DYNAMIC_ENUM_MAX_TYPES ? dynamic_enum_types[id].load(std::memory_order_acquire) : nullptr;
+        }
+
+        /**
+         * A type description publishing itself in the registry on construction.
+         */
+        struct registered_dynamic_enum_type : dynamic_enum_type {
+            explicit registered_dynamic_enum_type(const dynamic_enum_type& type) noexcept : dynamic_enum_type(type) {
+                if (id < TRAK_DYNAMIC_ENUM_MAX_TYPES) {
+                    dynamic_enum_types[id].store(this, std::memory_order_release);
+                }
+            }
+        };
+
+        template<typename T>
+        const dynamic_enum_type& dynamic_enum_type_of() noexcept;
+
+        /**
+         * Returns the id of the enum or shared enum T, assigning the next free id on the first call.
+         */
+        template<typename T>
+        inline std::uint32_t dynamic_enum_id() noexcept {
+            return dynamic_enum_type_of<T>().id;
+        }
+
+        template<typename E>
+        struct dynamic_enum_members {
+            static dynamic_enum_type make() noexcept {
+                return {dynamic_enum_type_count.fetch_add(1, std::memory_order_relaxed), type_name<E>(), false, nullptr, 0};
+            }
+        };
+
+        template<typename... Ts>
+        struct dynamic_enum_members<shared_enum<Ts...>> {
+            static dynamic_enum_type make() noexcept {
+                static const std::array<std::uint32_t, sizeof...(Ts)> members{{dynamic_enum_id<Ts>()...}};
+                return {dynamic_enum_type_count.fetch_add(1, std::memory_order_relaxed), type_name<shared_enum<Ts...>>(),
+                        true, members.data(), members.size()};
+            }
+        };
+
+        /**
+         * Returns the description of the enum or shared enum T, registering it on the first call.
+         */
+        template<typename T>
+        inline const dynamic_enum_type& dynamic_enum_type_of() noexcept {
+            static const registered_dynamic_enum_type type(dynamic_enum_members<T>::make());
+            return type;
+        }
+
+        template<typename E>
+        struct dynamic_enum_conversion {
+            static bool from(const dynamic_enum_type& type) noexcept {
+                return type.contains(dynamic_enum_id<E>());
+            }
+        };
+
+        /**
+         * A value of a shared enum converts to a shared enum of a subset of its types, and a value of an enum to the
+         * shared enums having it as one of their types.
+         */
+        template<typename... Ts>
+        struct dynamic_enum_conversion<shared_enum<Ts...>> {
+            static bool from(const dynamic_enum_type& type) noexcept {
+                return type.shared
+                        ? (type.contains(dynamic_enum_id<Ts>()) && ...)
+                        : ((type.id == dynamic_enum_id<Ts>()) || ...);
+            }
+        };
+
+        /**
+         * Returns \c true if a value stored with the given type id converts to T.
+         */
+        template<typename T>
+        inline bool dynamic_enum_converts(std::uint32_t id) noexcept {
+            using key = dynamic_enum_key_t<T>;
+            if (id == dynamic_enum_id<key>()) {
+                return true;
+            }
+            const auto* type = find_dynamic_enum_type(id);
+            return type != nullptr && dynamic_enum_conversion<key>::from(*type);
+        }
+    }
+
+    /**
+     * An 8-byte value of any enum, shared enum or shared bitfield, storing a compact id of its type and its value,
+     * for example to put values of unrelated enums into a single queue.
+     *
+     * Type ids are assigned in the order the types are first used within a process, so they must not be persisted.
+     * The value converts back to its type, and to the other types it converts to as a shared enum. Shared bitfields
+     * are stored as the shared enum of their types. The underlying types need to be at most 32 bits.
+     */
+    class dynamic_shared_enum {
+    public:
+        /**
+         * Constructs an empty value, which converts to no type.
+         */
+        constexpr dynamic_shared_enum() noexcept = default;
+
+        /**
+         * Constructs the value of the enum or shared enum T.
+         */
+        template<typename T, typename = detail::dynamic_enum_key_t<T>>
+        dynamic_shared_enum(T value) noexcept
+                : type_(detail::dynamic_enum_id<detail::dynamic_enum_key_t<T>>()), value_(to_bits(value)) {}
+
+        /**
+         * Returns \c true if the value is empty.
+         */
+        constexpr bool empty() const noexcept {
+            return type_ == 0;
+        }
+
+        /**
+         * Returns the id of the stored type, or 0 if the value is empty.
+         */
+        constexpr std::uint32_t type_id() const noexcept {
+            return type_;
+        }
+
+        /**
+         * Returns the bits of the stored value, extended to 32 bits by the signedness of its underlying type.
+         */
+        constexpr std::uint32_t raw() const noexcept {
+            return value_;
+        }
+
+        /**
+         * Returns the qualified name of the stored type, or an empty string if the value is empty or its type is not
+         * kept in the registry.
+         */
+        std::string_view type_name() const noexcept {
+            const auto* type = detail::find_dynamic_enum_type(type_);
+            return type != nullptr ? type->name : std::string_view{};
+        }
+
+        /**
+         * Returns \c true if the stored value converts to T, being its type, one of the types of its shared enum,
+         * or a shared enum of such types.
+         */
+        template<typename T>
+        bool is() const noexcept {
+            return detail::dynamic_enum_converts<T>(type_);
+        }
+
+        /**
+         * Returns the stored value as T if it converts to T. Otherwise, returns an empty optional.
+         *
+         * @tparam T
+         *      The enum, shared enum or shared bitfield type to convert to.
+         */
+        template<typename T>
+        std::optional<T> as() const noexcept {
+            if (!is<T>()) {
+                return std::nullopt;
+            }
+            return from_bits<T>(value_);
+        }
+
+        /**
+         * Returns the stored value as T without checking its type.
+         */
+        template<typename T>
+        constexpr T unchecked_as() const noexcept {
+            return from_bits<T>(value_);
+        }
+
+        /**
+         * Returns \c true if both values have the same type and value.
+         */
+        friend constexpr bool operator==(const dynamic_shared_enum& lhs, const dynamic_shared_enum& rhs) noexcept {
+            return lhs.type_ == rhs.type_ && lhs.value_ == rhs.value_;
+        }
+
+        friend constexpr bool operator!=(const dynamic_shared_enum& lhs, const dynamic_shared_enum& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+    private:
+        /**
+         * Extends the value to 32 bits by the signedness of its underlying type, as the value may be read as a type
+         * of another width, for example a wider type of a shared enum stored in the narrowest one.
+         */
+        template<typename T>
+        static constexpr std::uint32_t to_bits(T value) noexcept {
+            using underlying_type = typename detail::dynamic_enum_key<T>::underlying_type;
+            static_assert(sizeof(underlying_type) <= sizeof(std::uint32_t), "The underlying type needs to be at most 32 bits");
+            using extended_type = typename std::conditional<std::is_signed<underlying_type>::value, std::int32_t, std::uint32_t>::type;
+            return static_cast<std::uint32_t>(static_cast<extended_type>(static_cast<underlying_type>(value)));
+        }
+
+        template<typename T>
+        static constexpr T from_bits(std::uint32_t bits) noexcept {
+            using underlying_type = typename detail::dynamic_enum_key<T>::underlying_type;
+            return T(static_cast<underlying_type>(static_cast<typename std::make_unsigned<underlying_type>::type>(bits)));
+        }
+
+        std::uint32_t type_ = 0;
+        std::uint32_t value_ = 0;
+    };
+
+    namespace detail {
+
+        /**
+         * Maps the type ids of dynamic shared enums onto the index of the first of Ts their values convert to, or
+         * sizeof...(Ts) if there is none.
+         *
+         * The indices of the types registered so far are cached in an immutable snapshot, which is replaced when a
+         * type registered later is visited. Readers only load the current snapshot, which is constant-initialized,
+         * so visiting does not check for the initialization of a local static.
+         */
+        template<typename... Ts>
+        struct dynamic_visit_table {
+            static_assert(sizeof...(Ts) < 65535, "Too many types to visit");
+
+            /**
+             * The indices of the type ids [0, count). Replaced snapshots are kept, as readers may still use them.
+             */
+            struct snapshot {
+                std::uint32_t count;
+                std::unique_ptr<std::uint16_t[]> indices;
+                std::unique_ptr<const snapshot> previous;
+            };
+
+            static inline std::atomic<const snapshot*> current{nullptr};
+            static inline std::mutex mutex;
+
+            static std::uint16_t compute(std::uint32_t id) noexcept {
+                std::uint16_t index = 0;
+                static_cast<void>(((dynamic_enum_converts<Ts>(id) || (++index, false)) || ...));
+                return index;
+            }
+
+            static std::uint16_t index(std::uint32_t id) {
+                const auto* snapshot = current.load(std::memory_order_acquire);
+                if (snapshot != nullptr && id < snapshot->count) {
+                    return snapshot->indices[id];
+                }
+                return rebuild(id);
+            }
+
+            static std::uint16_t rebuild(std::uint32_t id) {
+                // Only the types up to the first one whose registration is in progress are cached.
+                std::uint32_t count = 1;
+                while (count < TRAK_DYNAMIC_ENUM_MAX_TYPES && find_dynamic_enum_type(count) != nullptr) {
+                    ++count;
+                }
+                if (id >= count) {
+                    return compute(id);
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                const auto* last = current.load(std::memory_order_relaxed);
+                if (last == nullptr || last->count < count) {
+                    auto next = new snapshot{count, std::make_unique<std::uint16_t[]>(count), std::unique_ptr<const snapshot>(last)};
+                    for (std::uint32_t i = 0; i < count; ++i) {
+                        next->indices[i] = compute(i);
+                    }
+                    current.store(next, std::memory_order_release);
+                    last = next;
+                }
+                return last->indices[id];
+            }
+        };
+
+        template<typename R, typename T, typename F, typename G>
+        R visit_case(F& handler, G&, const dynamic_shared_enum& value) {
+            return static_cast<R>(handler(value.template unchecked_as<T>()));
+        }
+
+        template<typename R, typename F, typename G>
+        R visit_fallback(F&, G& fallback, const dynamic_shared_enum& value) {
+            return static_cast<R>(fallback(value));
+        }
+    }
+
+    /**
+     * Invokes handler with the value converted to the first of Ts it converts to, or fallback with the value if it
+     * converts to none of them, for example because it is empty.
+     *
+     * The type id is mapped onto the index of the type to convert to by a table, which is followed by an indirect
+     * call through a jump table of the cases.
+     *
+     * @tparam Ts
+     *      The enum, shared enum or shared bitfield types to visit.
+     * @param value
+     *      The value to visit.
+     * @param handler
+     *      The handler invoked with a value of one of Ts.
+     * @param fallback
+     *      The handler invoked with the dynamic shared enum otherwise.
+     * @return
+     *      The result of the handler, converted to the common result type of all Ts.
+     */
+    template<typename... Ts, typename F, typename G>
+    inline auto visit(const dynamic_shared_enum& value, F&& handler, G&& fallback)
+            -> typename std::common_type<typename std::invoke_result<F&, Ts>::type...>::type {
+        using result = typename std::common_type<typename std::invoke_result<F&, Ts>::type...>::type;
+        using handler_type = typename std::remove_reference<F>::type;
+        using fallback_type = typename std::remove_reference<G>::type;
+        using entry = result (*)(handler_type&, fallback_type&, const dynamic_shared_enum&);
+        static constexpr entry entries[] = {&detail::visit_case<result, Ts, handler_type, fallback_type>...,
+                                            &detail::visit_fallback<result, handler_type, fallback_type>};
+        return entries[detail::dynamic_visit_table<Ts...>::index(value.type_id())](handler, fallback, value);
+    }
+
+    /**
+     * Invokes handler with the value converted to the first of Ts it converts to. Otherwise, returns a
+     * value-initialized result.
+     */
+    template<typename... Ts, typename F>
+    inline auto visit(const dynamic_shared_enum& value, F&& handler)
+            -> typename std::common_type<typename std::invoke_result<F&, Ts>::type...>::type {
+        detail::default_dispatch_fallback<typename std::common_type<typename std::invoke_result<F&, Ts>::type...>::type> fallback;
+        return visit<Ts...>(value, std::forward<F>(handler), fallback);
+    }
+}
+
+namespace std {
+
+    /**
+     * Hashes a dynamic shared enum as its type id and value.
+     */
+    template<>
+    struct hash<trak::dynamic_shared_enum> {
+        std::size_t operator()(const trak::dynamic_shared_enum& value) const noexcept {
+            return hash<std::uint64_t>()(static_cast<std::uint64_t>(value.type_id()) << 32u | value.raw());
+        }
+    };
+}
+
+#endif //TRAK_DYNAMIC_SHARED_ENUM_HPP
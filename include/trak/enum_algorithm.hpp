@@ -0,0 +1,200 @@
+#ifndef TRAK_ENUM_ALGORITHM_HPP
+#define TRAK_ENUM_ALGORITHM_HPP
+
+#include <trak/enum_indexer.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace trak {
+
+    /**
+     * The ranges of a sequence grouped by enum_indexer index of a key, as returned by counting_sort and
+     * partition_by_enum. Elements whose key has no index are grouped last.
+     *
+     * @tparam E
+     *      The enum type of the keys.
+     */
+    template<typename E>
+    class enum_buckets {
+    public:
+        using indexer = enum_indexer<E>;
+
+        /**
+         * @param offsets
+         *      The offset of the first element of each index, followed by the offset of the elements
+         *      without index and the size of the sequence.
+         */
+        explicit enum_buckets(std::vector<std::size_t> offsets) noexcept : offsets_(std::move(offsets)) {}
+
+        /**
+         * Returns the offset of the first element with the given key.
+         */
+        std::size_t first(E key) const noexcept {
+            return offsets_[indexer::index(key)];
+        }
+
+        /**
+         * Returns the offset past the last element with the given key.
+         */
+        std::size_t last(E key) const noexcept {
+            return offsets_[indexer::index(key) + 1];
+        }
+
+        /**
+         * Returns the number of elements with the given key.
+         */
+        std::size_t count(E key) const noexcept {
+            return last(key) - first(key);
+        }
+
+        /**
+         * Returns the offset of the first element whose key has no index.
+         */
+        std::size_t unindexed() const noexcept {
+            return offsets_[indexer::size];
+        }
+
+    private:
+        std::vector<std::size_t> offsets_;
+    };
+
+    namespace detail {
+
+        struct identity_key {
+            template<typename T>
+            constexpr T&& operator()(T&& value) const noexcept {
+                return std::forward<T>(value);
+            }
+        };
+
+        /**
+         * The enum type indexing the keys returned by Key for the elements of It.
+         */
+        template<typename It, typename Key>
+        using enum_key_t = typename index_enum_type<typename std::decay<
+                typename std::invoke_result<Key&, typename std::iterator_traits<It>::reference>::type>::type>::type;
+
+        /**
+         * Returns the offsets of the buckets of each index of E, followed by the bucket of the keys without
+         * index and the size of the sequence.
+         */
+        template<typename E, typename It, typename Key>
+        std::vector<std::size_t> count_enum_keys(It first, It last, Key& key) {
+            std::vector<std::size_t> offsets(enum_indexer<E>::size + 2, 0);
+            for (auto it = first; it != last; ++it) {
+                ++offsets[enum_indexer<E>::index(static_cast<E>(key(*it))) + 1];
+            }
+            for (std::size_t i = 1; i < offsets.size(); ++i) {
+                offsets[i] += offsets[i - 1];
+            }
+            return offsets;
+        }
+    }
+
+    /**
+     * Sorts the elements of [first, last) by the index of their key in linear time, preserving the order of
+     * elements with equal keys. Elements whose key has no index are moved to the end.
+     *
+     * @tparam RandomIt
+     *      The random access iterator type of the sequence.
+     * @tparam Key
+     *      The type of the function returning the enum or shared enum key of an element.
+     * @param first
+     *      The beginning of the sequence.
+     * @param last
+     *      The end of the sequence.
+     * @param key
+     *      The function returning the key of an element.
+     * @return
+     *      The range of each key in the sorted sequence.
+     */
+    template<typename RandomIt, typename Key>
+    auto counting_sort(RandomIt first, RandomIt last, Key key) -> enum_buckets<detail::enum_key_t<RandomIt, Key>> {
+        using enum_type = detail::enum_key_t<RandomIt, Key>;
+        using value_type = typename std::iterator_traits<RandomIt>::value_type;
+        auto offsets = detail::count_enum_keys<enum_type>(first, last, key);
+        auto next = offsets;
+        const auto size = static_cast<std::size_t>(last - first);
+
+        if constexpr (std::is_default_constructible<value_type>::value) {
+            std::vector<value_type> sorted(size);
+            for (auto it = first; it != last; ++it) {
+                sorted[next[enum_indexer<enum_type>::index(static_cast<enum_type>(key(*it)))]++] = std::move(*it);
+            }
+            std::move(sorted.begin(), sorted.end(), first);
+        } else {
+            std::vector<std::size_t> order(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                order[next[enum_indexer<enum_type>::index(static_cast<enum_type>(key(first[i])))]++] = i;
+            }
+            std::vector<value_type> sorted;
+            sorted.reserve(size);
+            for (auto i : order) {
+                sorted.push_back(std::move(first[i]));
+            }
+            std::move(sorted.begin(), sorted.end(), first);
+        }
+        return enum_buckets<enum_type>(std::move(offsets));
+    }
+
+    /**
+     * Sorts the enum or shared enum values of [first, last) by their index in linear time.
+     */
+    template<typename RandomIt>
+    auto counting_sort(RandomIt first, RandomIt last) {
+        return counting_sort(first, last, detail::identity_key{});
+    }
+
+    /**
+     * Groups the elements of [first, last) by the index of their key in linear time, in place and without
+     * preserving the order of elements with equal keys. Elements whose key has no index are moved to the end.
+     *
+     * @tparam RandomIt
+     *      The random access iterator type of the sequence.
+     * @tparam Key
+     *      The type of the function returning the enum or shared enum key of an element.
+     * @param first
+     *      The beginning of the sequence.
+     * @param last
+     *      The end of the sequence.
+     * @param key
+     *      The function returning the key of an element.
+     * @return
+     *      The range of each key in the grouped sequence.
+     */
+    template<typename RandomIt, typename Key>
+    auto partition_by_enum(RandomIt first, RandomIt last, Key key) -> enum_buckets<detail::enum_key_t<RandomIt, Key>> {
+        using enum_type = detail::enum_key_t<RandomIt, Key>;
+        auto offsets = detail::count_enum_keys<enum_type>(first, last, key);
+        auto next = offsets;
+
+        // Swaps each misplaced element into the next free slot of its bucket.
+        for (std::size_t bucket = 0; bucket + 1 < offsets.size(); ++bucket) {
+            while (next[bucket] < offsets[bucket + 1]) {
+                auto& value = first[next[bucket]];
+                const auto target = enum_indexer<enum_type>::index(static_cast<enum_type>(key(value)));
+                if (target == bucket) {
+                    ++next[bucket];
+                } else {
+                    using std::swap;
+                    swap(value, first[next[target]++]);
+                }
+            }
+        }
+        return enum_buckets<enum_type>(std::move(offsets));
+    }
+
+    /**
+     * Groups the enum or shared enum values of [first, last) by their index in linear time.
+     */
+    template<typename RandomIt>
+    auto partition_by_enum(RandomIt first, RandomIt last) {
+        return partition_by_enum(first, last, detail::identity_key{});
+    }
+}
+
+#endif //TRAK_ENUM_ALGORITHM_HPP
@@ -0,0 +1,366 @@
+#ifndef TRAK_ENUM_HASH_INDEXER_HPP
+#define TRAK_ENUM_HASH_INDEXER_HPP
+
+#include <trak/enum_indexer.hpp>
+#include <trak/enum_traits.hpp>
+#include <trak/shared_enum.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * Returns the smallest number of bits holding the values [0, count), being at least 1.
+         */
+        constexpr unsigned int hash_bits(std::size_t count) noexcept {
+            unsigned int bits = 1;
+            while ((std::size_t{1} << bits) < count) {
+                ++bits;
+            }
+            return bits;
+        }
+
+        /**
+         * The smallest unsigned integer type holding max.
+         */
+        template<std::size_t Max>
+        using hash_index_t = typename std::conditional<Max <= 0xFF, std::uint8_t,
+                typename std::conditional<Max <= 0xFFFF, std::uint16_t, std::uint32_t>::type>::type;
+
+        /**
+         * The integer type of the given size and signedness.
+         */
+        template<std::size_t Size, bool Signed>
+        using sized_integer_t = typename std::conditional<Size == 1, typename std::conditional<Signed, std::int8_t, std::uint8_t>::type,
+                typename std::conditional<Size == 2, typename std::conditional<Signed, std::int16_t, std::uint16_t>::type,
+                typename std::conditional<Size == 4, typename std::conditional<Signed, std::int32_t, std::uint32_t>::type,
+                typename std::conditional<Signed, std::int64_t, std::uint64_t>::type>::type>::type>::type;
+
+        /**
+         * The narrowest integer type representing the values of each of the integer types Us, independent of their
+         * order. Only 64-bit unsigned types combined with signed types have none, in which case it is std::int64_t.
+         */
+        template<typename... Us>
+        struct hash_key_type {
+            static constexpr std::size_t unsigned_size = [] {
+                std::size_t size = 0;
+                for (auto value : {(std::is_signed<Us>::value ? std::size_t{0} : sizeof(Us))...}) {
+                    size = value > size ? value : size;
+                }
+                return size;
+            }();
+
+            static constexpr std::size_t signed_size = [] {
+                std::size_t size = 0;
+                for (auto value : {(std::is_signed<Us>::value ? sizeof(Us) : std::size_t{0})...}) {
+                    size = value > size ? value : size;
+                }
+                return size;
+            }();
+
+            // Unsigned values need a signed type of twice their width to be represented along negative values.
+            static constexpr std::size_t size = signed_size == 0 ? unsigned_size
+                    : unsigned_size >= signed_size ? (unsigned_size < 8 ? unsigned_size * 2 : 8) : signed_size;
+
+            using type = sized_integer_t<size, (signed_size > 0)>;
+        };
+
+        /**
+         * Returns the next odd multiplier of the sequence of state, advancing state.
+         */
+        constexpr std::uint64_t next_hash_multiplier(std::uint64_t& state) noexcept {
+            state += 0x9E3779B97F4A7C15ull;
+            auto bits = state;
+            bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ull;
+            bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBull;
+            return (bits ^ (bits >> 31)) | 1;
+        }
+
+        /**
+         * A collision-free hash table of N distinct keys of the integer type K, mapping the i-th key to i and each
+         * other value to N.
+         *
+         * A key selects a bucket by a multiplicative hash, and its slot is a second multiplicative hash displaced
+         * by the bucket, so a lookup takes two multiplications, two table loads and a comparison, without branches.
+         * The table has at least a fifth of its slots free, and two slots per bucket on average.
+         */
+        template<typename K, std::size_t N>
+        struct perfect_hash_table {
+            static constexpr unsigned int slot_bits = hash_bits(N + N / 4 + 1);
+            static constexpr std::size_t slot_count = std::size_t{1} << slot_bits;
+            static constexpr unsigned int bucket_bits = slot_bits > 1 ? slot_bits - 1 : 1;
+            static constexpr std::size_t bucket_count = std::size_t{1} << bucket_bits;
+
+            using index_type = hash_index_t<N>;
+            using displacement_type = hash_index_t<slot_count - 1>;
+
+            struct slot {
+                K key{};
+                index_type index = static_cast<index_type>(N);
+            };
+
+            std::uint64_t bucket_multiplier = 0;
+            std::uint64_t slot_multiplier = 0;
+            std::array<displacement_type, bucket_count> displacements{};
+            std::array<slot, slot_count> slots{};
+            bool found = false;
+
+            static constexpr std::size_t bucket_of(std::uint64_t bits, std::uint64_t multiplier) noexcept {
+                return static_cast<std::size_t>((bits * multiplier) >> (64 - bucket_bits));
+            }
+
+            static constexpr std::size_t hash_of(std::uint64_t bits, std::uint64_t multiplier) noexcept {
+                return static_cast<std::size_t>((bits * multiplier) >> (64 - slot_bits));
+            }
+
+            /**
+             * Returns the index of key, or N if key is none of the keys.
+             */
+            constexpr std::size_t find(K key) const noexcept {
+                const auto bits = static_cast<std::uint64_t>(key);
+                const auto bucket = bucket_of(bits, bucket_multiplier);
+                const auto& entry = slots[(hash_of(bits, slot_multiplier) + displacements[bucket]) & (slot_count - 1)];
+                // Selects N by a mask, which compilers would otherwise turn into a branch around the load of the index.
+                const auto mismatch = std::size_t{0} - static_cast<std::size_t>(entry.key != key);
+                return (entry.index & ~mismatch) | (N & mismatch);
+            }
+        };
+
+        /**
+         * Places the keys of each bucket with the displacement moving all of them to free slots, from the largest
+         * bucket to the smallest, and returns \c true if each bucket has one.
+         */
+        template<typename K, std::size_t N>
+        constexpr bool place_perfect_hash(perfect_hash_table<K, N>& table, const std::array<K, N>& keys) noexcept {
+            using table_type = perfect_hash_table<K, N>;
+
+            std::array<std::size_t, N> buckets{};
+            std::array<std::size_t, N> hashes{};
+            std::array<std::size_t, table_type::bucket_count + 1> offsets{};
+            for (std::size_t i = 0; i < N; ++i) {
+                const auto bits = static_cast<std::uint64_t>(keys[i]);
+                buckets[i] = table_type::bucket_of(bits, table.bucket_multiplier);
+                hashes[i] = table_type::hash_of(bits, table.slot_multiplier);
+                ++offsets[buckets[i] + 1];
+            }
+
+            // Sorts the buckets by descending size, and their keys by bucket, both by counting.
+            std::array<std::size_t, N + 2> by_size{};
+            for (std::size_t bucket = 0; bucket < table_type::bucket_count; ++bucket) {
+                ++by_size[N - offsets[bucket + 1]];
+            }
+            for (std::size_t i = 1; i < by_size.size(); ++i) {
+                by_size[i] += by_size[i - 1];
+            }
+            std::array<std::size_t, table_type::bucket_count> order{};
+            for (auto bucket = table_type::bucket_count; bucket-- > 0;) {
+                order[--by_size[N - offsets[bucket + 1]]] = bucket;
+            }
+            for (std::size_t bucket = 0; bucket < table_type::bucket_count; ++bucket) {
+                offsets[bucket + 1] += offsets[bucket];
+            }
+            auto next = offsets;
+            std::array<std::size_t, N> members{};
+            for (std::size_t i = 0; i < N; ++i) {
+                members[next[buckets[i]]++] = i;
+            }
+
+            std::array<bool, table_type::slot_count> used{};
+            for (auto bucket : order) {
+                const auto first = offsets[bucket];
+                const auto last = offsets[bucket + 1];
+                if (first == last) {
+                    break;
+                }
+                std::size_t displacement = 0;
+                for (; displacement < table_type::slot_count; ++displacement) {
+                    bool fits = true;
+                    for (auto i = first; i < last && fits; ++i) {
+                        const auto slot = (hashes[members[i]] + displacement) & (table_type::slot_count - 1);
+                        fits = !used[slot];
+                        for (auto k = first; k < i && fits; ++k) {
+                            fits = ((hashes[members[k]] + displacement) & (table_type::slot_count - 1)) != slot;
+                        }
+                    }
+                    if (fits) {
+                        break;
+                    }
+                }
+                if (displacement == table_type::slot_count) {
+                    return false;
+                }
+                table.displacements[bucket] = static_cast<typename table_type::displacement_type>(displacement);
+                for (auto i = first; i < last; ++i) {
+                    const auto slot = (hashes[members[i]] + displacement) & (table_type::slot_count - 1);
+                    used[slot] = true;
+                    table.slots[slot].key = keys[members[i]];
+                    table.slots[slot].index = static_cast<typename table_type::index_type>(members[i]);
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Returns the perfect hash table of the distinct keys, trying fixed sequences of multipliers until the
+         * keys of each bucket can be placed. The result is the same for each compilation.
+         */
+        template<typename K, std::size_t N>
+        constexpr perfect_hash_table<K, N> make_perfect_hash(const std::array<K, N>& keys) noexcept {
+            std::uint64_t state = 0;
+            for (int attempt = 0; attempt < 256; ++attempt) {
+                perfect_hash_table<K, N> table;
+                table.bucket_multiplier = next_hash_multiplier(state);
+                table.slot_multiplier = next_hash_multiplier(state);
+                if (place_perfect_hash(table, keys)) {
+                    table.found = true;
+                    return table;
+                }
+            }
+            return {};
+        }
+
+        /**
+         * The distinct values of Es as underlying values of type K, sorted ascending. representable is \c false
+         * if a value is out of the range of K.
+         */
+        template<typename K, typename... Es>
+        struct hash_index_keys {
+            static constexpr std::size_t total = (std::size_t{0} + ... + enum_traits<Es>::size);
+
+            static constexpr bool representable = ([] {
+                for (auto value : enum_traits<Es>::values) {
+                    if (!common_value_range<K>::contains(static_cast<typename std::underlying_type<Es>::type>(value))) {
+                        return false;
+                    }
+                }
+                return true;
+            }() && ...);
+
+            static constexpr std::array<K, total> sorted = [] {
+                std::array<K, total> sorted{};
+                std::size_t size = 0;
+                ([&] {
+                    for (auto value : enum_traits<Es>::values) {
+                        sorted[size++] = static_cast<K>(static_cast<typename std::underlying_type<Es>::type>(value));
+                    }
+                }(), ...);
+                // The values of each enum are sorted already, so only interleaved values move.
+                for (std::size_t i = 1; i < total; ++i) {
+                    for (auto k = i; k > 0 && sorted[k] < sorted[k - 1]; --k) {
+                        const auto value = sorted[k];
+                        sorted[k] = sorted[k - 1];
+                        sorted[k - 1] = value;
+                    }
+                }
+                return sorted;
+            }();
+
+            static constexpr std::size_t size = [] {
+                std::size_t size = 0;
+                for (std::size_t i = 0; i < total; ++i) {
+                    size += i == 0 || sorted[i] != sorted[i - 1];
+                }
+                return size;
+            }();
+
+            static constexpr std::array<K, size> values = [] {
+                std::array<K, size> values{};
+                std::size_t size = 0;
+                for (std::size_t i = 0; i < total; ++i) {
+                    if (i == 0 || sorted[i] != sorted[i - 1]) {
+                        values[size++] = sorted[i];
+                    }
+                }
+                return values;
+            }();
+        };
+
+        template<typename T, bool = std::is_enum<T>::value>
+        struct enum_hash_keys {
+            using key_type = typename std::underlying_type<T>::type;
+            using type = hash_index_keys<key_type, T>;
+
+            template<typename U>
+            static constexpr bool member = false;
+        };
+
+        template<typename T>
+        struct enum_hash_keys<T, false> : enum_hash_keys<shared_enum_of_t<T>> {};
+
+        template<typename T, typename... Ts>
+        struct enum_hash_keys<shared_enum<T, Ts...>, false> {
+            using key_type = typename hash_key_type<typename std::underlying_type<T>::type, typename std::underlying_type<Ts>::type...>::type;
+            using type = hash_index_keys<key_type, T, Ts...>;
+
+            template<typename U>
+            static constexpr bool member = (std::is_same<U, Ts>::value || ...);
+        };
+    }
+
+    /**
+     * Maps the values of the enum T, or the union of the values of the types of the shared enum T, onto the dense
+     * indices [0, size) in ascending order of the values, using a perfect hash table built at compile time. Values
+     * between them have no index, so sparse enums, for example with values like 0x8B30 and 0x9100, are indexed
+     * without a table spanning their range.
+     *
+     * The values are the ones of enum_traits, so enums with values outside the range scanned by enum_reflection
+     * declare them by specializing enum_traits. A lookup takes two multiplications, two table loads and a
+     * comparison, without branches.
+     *
+     * Specialize enum_indexer by deriving from this template to use it for enum_map, enum_set and the other
+     * containers indexed by enum_indexer.
+     *
+     * The values of the types of a shared enum are hashed as an integer type representing each of them, so the
+     * order of the types does not matter. The values are returned as the first type, like by the other indexers.
+     *
+     * @tparam T
+     *      The enum or shared enum type.
+     */
+    template<typename T>
+    struct enum_hash_indexer {
+        using enum_type = typename detail::index_enum_type<T>::type;
+        using underlying_type = typename std::underlying_type<enum_type>::type;
+
+    private:
+        using key_type = typename detail::enum_hash_keys<T>::key_type;
+        using keys = typename detail::enum_hash_keys<T>::type;
+
+        static_assert(keys::representable, "The values of all types of T need to be representable in one integer type");
+
+        static constexpr auto table = detail::make_perfect_hash<key_type>(keys::values);
+
+        static_assert(table.found, "No perfect hash was found for the values of T");
+
+    public:
+        static constexpr std::size_t size = keys::size;
+
+        /**
+         * Returns the index of value, or size if value is none of the values.
+         */
+        static constexpr std::size_t index(enum_type value) noexcept {
+            return table.find(static_cast<key_type>(static_cast<underlying_type>(value)));
+        }
+
+        /**
+         * Returns the index of value of another type of the shared enum T, or size if value is none of the values.
+         */
+        template<typename U>
+        static constexpr auto index(U value) noexcept -> TRAK_RETURN_IF((detail::enum_hash_keys<T>::template member<U>), std::size_t) {
+            return table.find(static_cast<key_type>(static_cast<typename std::underlying_type<U>::type>(value)));
+        }
+
+        /**
+         * Returns the value of index, which needs to be less than size, converted to the first type.
+         */
+        static constexpr enum_type value(std::size_t index) noexcept {
+            return static_cast<enum_type>(keys::values[index]);
+        }
+    };
+}
+
+#endif //TRAK_ENUM_HASH_INDEXER_HPP
@@ -0,0 +1,97 @@
+#ifndef TRAK_ENUM_INDEXER_HPP
+#define TRAK_ENUM_INDEXER_HPP
+
+#include <trak/enum_reflection.hpp>
+#include <trak/shared_enum.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * The largest value range of an enum indexed by enum_range_indexer.
+ */
+#ifndef TRAK_ENUM_INDEX_MAX_RANGE
+#define TRAK_ENUM_INDEX_MAX_RANGE 65536
+#endif
+
+namespace trak {
+
+    /**
+     * Maps the values from the smallest to the largest enumerator of E onto the indices [0, size). The index
+     * of a value is its distance to the smallest enumerator, so values between enumerators have an index too.
+     *
+     * @tparam E
+     *      The enum type.
+     */
+    template<typename E>
+    struct enum_range_indexer {
+        static_assert(std::is_enum<E>::value, "E is not an enum");
+
+        using underlying_type = typename std::underlying_type<E>::type;
+
+        static constexpr std::uint64_t min = enum_reflection<E>::size == 0
+                ? 0 : static_cast<std::uint64_t>(static_cast<underlying_type>(enum_reflection<E>::values[0]));
+        static constexpr std::uint64_t range = enum_reflection<E>::size == 0
+                ? 0 : static_cast<std::uint64_t>(static_cast<underlying_type>(enum_reflection<E>::values[enum_reflection<E>::size - 1])) - min + 1;
+
+        static_assert(range <= TRAK_ENUM_INDEX_MAX_RANGE, "The value range of E is too large, specialize trak::enum_indexer, for example with trak::enum_hash_indexer");
+
+        static constexpr std::size_t size = static_cast<std::size_t>(range);
+
+        /**
+         * Returns the index of value, or size if value is out of range.
+         */
+        static constexpr std::size_t index(E value) noexcept {
+            const auto index = static_cast<std::uint64_t>(static_cast<underlying_type>(value)) - min;
+            return index < range ? static_cast<std::size_t>(index) : size;
+        }
+
+        /**
+         * Returns the value of index, which needs to be less than size.
+         */
+        static constexpr E value(std::size_t index) noexcept {
+            return static_cast<E>(static_cast<underlying_type>(min + index));
+        }
+    };
+
+    /**
+     * Maps the values of E used as keys of enum_map and enum_set onto the indices [0, size).
+     *
+     * Provides the static member constant size, the static member function index, returning the index of a
+     * value or size if the value has none, and the static member function value, being the inverse of index.
+     *
+     * Specialize this template to change the indexing of an enum, for example by deriving from enum_hash_indexer for
+     * sparse enums. By default, enum_range_indexer is used.
+     *
+     * @tparam E
+     *      The enum type.
+     */
+    template<typename E>
+    struct enum_indexer : enum_range_indexer<E> {};
+
+    namespace detail {
+
+        /**
+         * Provides the public member typedef type, being the enum indexing values of T. This is T for enums,
+         * and the first type of shared enums.
+         */
+        template<typename T, bool = std::is_enum<T>::value>
+        struct index_enum_type {
+            using type = T;
+        };
+
+        template<typename T>
+        struct index_enum_type<T, false> {
+            static_assert(is_shared_enum<T>::value, "T is neither an enum nor a shared enum");
+            using type = typename index_enum_type<shared_enum_of_t<T>>::type;
+        };
+
+        template<typename T, typename... Ts>
+        struct index_enum_type<shared_enum<T, Ts...>, false> {
+            using type = T;
+        };
+    }
+}
+
+#endif //TRAK_ENUM_INDEXER_HPP
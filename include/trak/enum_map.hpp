@@ -0,0 +1,113 @@
+#ifndef TRAK_ENUM_MAP_HPP
+#define TRAK_ENUM_MAP_HPP
+
+#include <trak/enum_indexer.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace trak {
+
+    /**
+     * Associates a value of type V with each key of the enum E, stored in a flat array indexed by enum_indexer.
+     * Lookups compute the index of the key and never allocate. Shared enums are accepted as keys, as they are
+     * implicitly convertible to E.
+     *
+     * Every key of the indexer has a value, being value-initialized unless assigned.
+     *
+     * @tparam E
+     *      The enum type of the keys.
+     * @tparam V
+     *      The type of the values.
+     */
+    template<typename E, typename V>
+    class enum_map {
+        static_assert(std::is_enum<E>::value, "E is not an enum");
+
+    public:
+        using key_type = E;
+        using mapped_type = V;
+        using indexer = enum_indexer<E>;
+        using iterator = V*;
+        using const_iterator = const V*;
+
+        /**
+         * Returns the number of keys, being the number of indices of the indexer.
+         */
+        static constexpr std::size_t size() noexcept {
+            return indexer::size;
+        }
+
+        /**
+         * Returns \c true if key has a value in this map. Otherwise, returns \c false.
+         */
+        static constexpr bool contains(E key) noexcept {
+            return indexer::index(key) < indexer::size;
+        }
+
+        /**
+         * Returns the key of the value at index.
+         */
+        static constexpr E key_at(std::size_t index) noexcept {
+            return indexer::value(index);
+        }
+
+        /**
+         * Returns the value of key, which needs to be contained in this map.
+         */
+        constexpr V& operator[](E key) noexcept {
+            return values_[indexer::index(key)];
+        }
+
+        constexpr const V& operator[](E key) const noexcept {
+            return values_[indexer::index(key)];
+        }
+
+        /**
+         * Returns a pointer to the value of key, or \c nullptr if key is not contained in this map.
+         */
+        constexpr V* find(E key) noexcept {
+            const auto index = indexer::index(key);
+            return index < indexer::size ? values_.data() + index : nullptr;
+        }
+
+        constexpr const V* find(E key) const noexcept {
+            const auto index = indexer::index(key);
+            return index < indexer::size ? values_.data() + index : nullptr;
+        }
+
+        /**
+         * Assigns value to the values of all keys.
+         */
+        constexpr void fill(const V& value) {
+            for (auto& v : values_) {
+                v = value;
+            }
+        }
+
+        /**
+         * Returns an iterator to the values, in the order of their indices.
+         */
+        constexpr iterator begin() noexcept {
+            return values_.data();
+        }
+
+        constexpr const_iterator begin() const noexcept {
+            return values_.data();
+        }
+
+        constexpr iterator end() noexcept {
+            return values_.data() + indexer::size;
+        }
+
+        constexpr const_iterator end() const noexcept {
+            return values_.data() + indexer::size;
+        }
+
+    private:
+        std::array<V, indexer::size> values_{};
+    };
+}
+
+#endif //TRAK_ENUM_MAP_HPP
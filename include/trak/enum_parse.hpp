@@ -0,0 +1,236 @@
+#ifndef TRAK_ENUM_PARSE_HPP
+#define TRAK_ENUM_PARSE_HPP
+
+#include <trak/enum_reflection.hpp>
+#include <trak/shared_enum.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * Returns the 64-bit FNV-1a hash of name.
+         */
+        constexpr std::uint64_t hash_name(std::string_view name) noexcept {
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            for (auto c : name) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        /**
+         * Returns the hash displaced by seed, mixed by the splitmix64 finalizer.
+         */
+        constexpr std::uint64_t displace_hash(std::uint64_t hash, std::uint64_t seed) noexcept {
+            hash += seed * 0x9e3779b97f4a7c15ull;
+            hash = (hash ^ (hash >> 30u)) * 0xbf58476d1ce4e5b9ull;
+            hash = (hash ^ (hash >> 27u)) * 0x94d049bb133111ebull;
+            return hash ^ (hash >> 31u);
+        }
+
+        /**
+         * The enumerators shared by T and all types of Ts, being the enumerators of T for which each type of Ts
+         * has an enumerator of the same name and value.
+         *
+         * Provides the static member constants size, names and values.
+         */
+        template<typename T, typename... Ts>
+        struct shared_enumerators {
+            using underlying_type = typename shared_enum<T, Ts...>::underlying_type;
+
+            static constexpr bool is_shared(std::size_t index) noexcept {
+                if constexpr (sizeof...(Ts) == 0) {
+                    return true;
+                } else {
+                    const auto value = static_cast<typename std::underlying_type<T>::type>(enum_reflection<T>::values[index]);
+                    return ((name_of(static_cast<Ts>(value)) == enum_reflection<T>::names[index]) && ...);
+                }
+            }
+
+            static constexpr std::size_t size = [] {
+                std::size_t size = 0;
+                for (std::size_t i = 0; i < enum_reflection<T>::size; ++i) {
+                    size += is_shared(i);
+                }
+                return size;
+            }();
+
+            static constexpr std::array<std::size_t, size> indices = [] {
+                std::array<std::size_t, size> indices{};
+                std::size_t n = 0;
+                for (std::size_t i = 0; i < enum_reflection<T>::size; ++i) {
+                    if (is_shared(i)) {
+                        indices[n++] = i;
+                    }
+                }
+                return indices;
+            }();
+
+            static constexpr std::array<std::string_view, size> names = [] {
+                std::array<std::string_view, size> names{};
+                for (std::size_t i = 0; i < size; ++i) {
+                    names[i] = enum_reflection<T>::names[indices[i]];
+                }
+                return names;
+            }();
+
+            static constexpr std::array<underlying_type, size> values = [] {
+                std::array<underlying_type, size> values{};
+                for (std::size_t i = 0; i < size; ++i) {
+                    values[i] = static_cast<underlying_type>(enum_reflection<T>::values[indices[i]]);
+                }
+                return values;
+            }();
+        };
+
+        /**
+         * Minimal perfect hash of the names of Enumerators, built at compile time using hash and displace.
+         *
+         * The FNV-1a hash of a name selects a bucket, whose seed displaces the hash onto a slot. The slots are a
+         * permutation of the enumerators, so a lookup hashes the name once and performs a single string comparison.
+         *
+         * @tparam Enumerators
+         *      The enumerators, providing the static member constants size and names.
+         */
+        template<typename Enumerators>
+        struct name_hash {
+            static constexpr std::size_t size = Enumerators::size;
+            static constexpr std::size_t buckets = size > 0 ? size : 1;
+            static constexpr std::uint32_t max_seed = 1u << 16u;
+
+            struct table {
+                bool valid = true;
+                std::array<std::uint32_t, buckets> seeds{};
+                std::array<std::size_t, size> entries{};
+            };
+
+            static constexpr table build() noexcept {
+                table result{};
+                std::array<std::uint64_t, size> hashes{};
+                std::array<std::size_t, buckets + 1> offsets{};
+                for (std::size_t i = 0; i < size; ++i) {
+                    hashes[i] = hash_name(Enumerators::names[i]);
+                    ++offsets[hashes[i] % buckets + 1];
+                }
+
+                // Sort the enumerators by bucket.
+                std::size_t largest = 0;
+                for (std::size_t b = 0; b < buckets; ++b) {
+                    largest = offsets[b + 1] > largest ? offsets[b + 1] : largest;
+                    offsets[b + 1] += offsets[b];
+                }
+                std::array<std::size_t, size> members{};
+                std::array<std::size_t, buckets> filled{};
+                for (std::size_t i = 0; i < size; ++i) {
+                    const auto b = hashes[i] % buckets;
+                    members[offsets[b] + filled[b]++] = i;
+                }
+
+                // Place the buckets in descending order of their size, searching a seed for each.
+                std::array<bool, size> occupied{};
+                std::array<std::size_t, size> slots{};
+                for (auto count = largest; count > 0; --count) {
+                    for (std::size_t b = 0; b < buckets; ++b) {
+                        if (offsets[b + 1] - offsets[b] != count) {
+                            continue;
+                        }
+                        std::uint32_t seed = 1;
+                        for (; seed < max_seed; ++seed) {
+                            bool placed = true;
+                            for (std::size_t k = 0; k < count && placed; ++k) {
+                                slots[k] = displace_hash(hashes[members[offsets[b] + k]], seed) % size;
+                                placed = !occupied[slots[k]];
+                                for (std::size_t l = 0; l < k && placed; ++l) {
+                                    placed = slots[l] != slots[k];
+                                }
+                            }
+                            if (placed) {
+                                break;
+                            }
+                        }
+                        if (seed == max_seed) {
+                            result.valid = false;
+                            return result;
+                        }
+                        result.seeds[b] = seed;
+                        for (std::size_t k = 0; k < count; ++k) {
+                            occupied[slots[k]] = true;
+                            result.entries[slots[k]] = members[offsets[b] + k];
+                        }
+                    }
+                }
+                return result;
+            }
+
+            static constexpr table value = build();
+            static_assert(value.valid, "No perfect hash of the enumerator names was found");
+
+            /**
+             * Returns the index of the enumerator named name, or size if there is none.
+             */
+            static constexpr std::size_t find(std::string_view name) noexcept {
+                if constexpr (size == 0) {
+                    return size;
+                } else {
+                    const auto hash = hash_name(name);
+                    const auto entry = value.entries[displace_hash(hash, value.seeds[hash % buckets]) % size];
+                    return Enumerators::names[entry] == name ? entry : size;
+                }
+            }
+        };
+
+        /**
+         * Invalid specification.
+         */
+        template<typename>
+        struct shared_enumerators_of {};
+
+        template<typename... Ts>
+        struct shared_enumerators_of<shared_enum<Ts...>> {
+            using type = shared_enumerators<Ts...>;
+        };
+
+        template<typename T, bool = std::is_enum<T>::value>
+        struct parse_traits {
+            using enumerators = typename shared_enumerators_of<shared_enum_of_t<T>>::type;
+        };
+
+        template<typename T>
+        struct parse_traits<T, true> {
+            using enumerators = shared_enumerators<T>;
+        };
+    }
+
+    /**
+     * Parses the name of an enumerator of T, where T is an enum or a shared enum. The names of a shared enum are
+     * the names its types have in common, with the same value in each type.
+     *
+     * The lookup uses a minimal perfect hash of all names built at compile time and never allocates.
+     *
+     * @tparam T
+     *      The enum or shared enum type to parse.
+     * @param name
+     *      The name to parse.
+     * @return
+     *      The value named name, or an empty optional if T has no enumerator of that name.
+     */
+    template<typename T>
+    constexpr inline std::optional<T> parse(std::string_view name) noexcept {
+        using enumerators = typename detail::parse_traits<T>::enumerators;
+        const auto index = detail::name_hash<enumerators>::find(name);
+        if (index == enumerators::size) {
+            return std::nullopt;
+        }
+        return static_cast<T>(enumerators::values[index]);
+    }
+}
+
+#endif //TRAK_ENUM_PARSE_HPP
@@ -0,0 +1,335 @@
+#ifndef TRAK_ENUM_REFLECTION_HPP
+#define TRAK_ENUM_REFLECTION_HPP
+
+#include <trak/shared_enum.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/**
+ * The smallest value scanned for enumerators, unless enum_range is specialized for the enum.
+ */
+#ifndef TRAK_ENUM_RANGE_MIN
+#define TRAK_ENUM_RANGE_MIN -128
+#endif
+
+/**
+ * The largest value scanned for enumerators, unless enum_range is specialized for the enum.
+ */
+#ifndef TRAK_ENUM_RANGE_MAX
+#define TRAK_ENUM_RANGE_MAX 127
+#endif
+
+namespace trak {
+
+    /**
+     * Describes the values scanned for enumerators of E. Each scanned value costs one template instantiation,
+     * which bounds the compile cost of reflecting E.
+     *
+     * Specialize this template to change the scanned range of an enum. If flags is \c true, zero and each
+     * single bit of the underlying type are scanned instead of the range [min, max].
+     *
+     * @tparam E
+     *      The enum type.
+     */
+    template<typename E>
+    struct enum_range {
+        static constexpr long long min = TRAK_ENUM_RANGE_MIN;
+        static constexpr long long max = TRAK_ENUM_RANGE_MAX;
+        static constexpr bool flags = false;
+    };
+
+    namespace detail {
+
+        constexpr bool is_identifier_start(char c) noexcept {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        }
+
+        /**
+         * Extracts the enumerator name of the template argument from the signature of enum_value_name.
+         * Returns an empty string if the argument is not a named enumerator.
+         */
+        constexpr std::string_view parse_enum_value_name(std::string_view signature) noexcept {
+#if defined(__clang__) || defined(__GNUC__)
+            // GCC: "... [with auto V = A::First; ...]", Clang: "... [V = A::First]"
+            const auto start = signature.find("V = ");
+            if (start == std::string_view::npos) {
+                return {};
+            }
+            auto token = signature.substr(start + 4);
+            token = token.substr(0, token.find_first_of(";]"));
+#elif defined(_MSC_VER)
+            // MSVC: "... enum_value_name<A::First>(void)"
+            const auto end = signature.rfind(">(");
+            if (end == std::string_view::npos) {
+                return {};
+            }
+            auto token = signature.substr(0, end);
+            token = token.substr(token.find_last_of("<,") + 1);
+#else
+            auto token = std::string_view{};
+#endif
+            // Values without enumerator are printed as a cast, e.g. "(A)5".
+            if (token.empty() || token.front() == '(') {
+                return {};
+            }
+            const auto separator = token.rfind(':');
+            const auto name = separator == std::string_view::npos ? token : token.substr(separator + 1);
+            return !name.empty() && is_identifier_start(name.front()) ? name : std::string_view{};
+        }
+
+        /**
+         * Returns the name of the enumerator V, or an empty string if V is not a named enumerator.
+         */
+        template<auto V>
+        constexpr std::string_view enum_value_name() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            return parse_enum_value_name(__FUNCSIG__);
+#else
+            return parse_enum_value_name(__PRETTY_FUNCTION__);
+#endif
+        }
+
+        /**
+         * Whether the enum E has a fixed underlying type, which only list-initialization from it detects.
+         */
+        template<typename E, typename = void>
+        struct has_fixed_underlying_type : std::false_type {};
+
+        template<typename E>
+        struct has_fixed_underlying_type<E, std::void_t<decltype(E{std::declval<typename std::underlying_type<E>::type>()})>> : std::true_type {};
+
+        /**
+         * The values scanned for enumerators of E, clamped to the range of its underlying type.
+         *
+         * E needs a fixed underlying type: the values of other enums are only those of their enumerators' bits,
+         * so casting any other scanned value is not a constant expression.
+         */
+        template<typename E>
+        struct enum_scan {
+            static_assert(has_fixed_underlying_type<E>::value, "Reflection requires an enum with a fixed underlying type, e.g. enum E : int");
+
+            using underlying_type = typename std::underlying_type<E>::type;
+            using unsigned_type = typename std::make_unsigned<underlying_type>::type;
+
+            static constexpr long long type_min = std::is_signed<underlying_type>::value
+                    ? static_cast<long long>(std::numeric_limits<underlying_type>::min()) : 0;
+            static constexpr long long type_max = static_cast<unsigned long long>(std::numeric_limits<underlying_type>::max())
+                    > static_cast<unsigned long long>(std::numeric_limits<long long>::max())
+                    ? std::numeric_limits<long long>::max() : static_cast<long long>(std::numeric_limits<underlying_type>::max());
+
+            static constexpr long long min = enum_range<E>::min < type_min ? type_min : enum_range<E>::min;
+            static constexpr long long max = enum_range<E>::max > type_max ? type_max : enum_range<E>::max;
+
+            static constexpr std::size_t size = enum_range<E>::flags
+                    ? std::numeric_limits<unsigned_type>::digits + 1
+                    : (max >= min ? static_cast<std::size_t>(max - min) + 1 : 0);
+
+            /**
+             * Returns the I-th scanned value.
+             */
+            template<std::size_t I>
+            static constexpr E value() noexcept {
+                if constexpr (enum_range<E>::flags) {
+                    return static_cast<E>(I == 0 ? unsigned_type{0} : static_cast<unsigned_type>(unsigned_type{1} << (I - 1)));
+                } else {
+                    return static_cast<E>(min + static_cast<long long>(I));
+                }
+            }
+
+            template<std::size_t... Is>
+            static constexpr std::array<std::string_view, sizeof...(Is)> names(std::index_sequence<Is...>) noexcept {
+                return {{enum_value_name<value<Is>()>()...}};
+            }
+
+            template<std::size_t... Is>
+            static constexpr std::array<E, sizeof...(Is)> values(std::index_sequence<Is...>) noexcept {
+                return {{value<Is>()...}};
+            }
+        };
+
+        /**
+         * The names of all scanned values of E, with an empty name for values without enumerator.
+         */
+        template<typename E>
+        inline constexpr auto scanned_enum_names = enum_scan<E>::names(std::make_index_sequence<enum_scan<E>::size>{});
+
+        template<typename E>
+        inline constexpr auto scanned_enum_values = enum_scan<E>::values(std::make_index_sequence<enum_scan<E>::size>{});
+
+        template<typename E>
+        constexpr std::size_t count_enumerators() noexcept {
+            std::size_t count = 0;
+            for (const auto& name : scanned_enum_names<E>) {
+                count += !name.empty();
+            }
+            return count;
+        }
+
+        template<typename E>
+        constexpr std::size_t count_name_chars() noexcept {
+            std::size_t count = 0;
+            for (const auto& name : scanned_enum_names<E>) {
+                count += name.empty() ? 0 : name.size() + 1;
+            }
+            return count;
+        }
+
+        /**
+         * Returns the indices of the scanned enumerators of E, ordered by their underlying value.
+         */
+        template<typename E>
+        constexpr std::array<std::size_t, count_enumerators<E>()> sorted_enumerators() noexcept {
+            using underlying_type = typename std::underlying_type<E>::type;
+            std::array<std::size_t, count_enumerators<E>()> indices{};
+            std::size_t size = 0;
+            for (std::size_t i = 0; i < scanned_enum_names<E>.size(); ++i) {
+                if (scanned_enum_names<E>[i].empty()) {
+                    continue;
+                }
+                // Only the flags scan of a signed type is not ordered, so insertion sort is cheap.
+                std::size_t j = size++;
+                const auto value = static_cast<underlying_type>(scanned_enum_values<E>[i]);
+                for (; j > 0 && static_cast<underlying_type>(scanned_enum_values<E>[indices[j - 1]]) > value; --j) {
+                    indices[j] = indices[j - 1];
+                }
+                indices[j] = i;
+            }
+            return indices;
+        }
+
+        /**
+         * The null-terminated names of all enumerators of E, stored contiguously in ascending order of their values.
+         */
+        template<typename E>
+        inline constexpr auto enum_name_chars = [] {
+            std::array<char, count_name_chars<E>()> chars{};
+            std::size_t offset = 0;
+            for (auto index : sorted_enumerators<E>()) {
+                for (auto c : scanned_enum_names<E>[index]) {
+                    chars[offset++] = c;
+                }
+                chars[offset++] = '\0';
+            }
+            return chars;
+        }();
+    }
+
+    /**
+     * Provides compile-time reflection of the enumerators of the enum E, found by scanning the values
+     * described by enum_range.
+     *
+     * Provides the static member constants size, being the number of enumerators, values, being the
+     * enumerators in ascending order, names, being their names, and dense, being \c true if the values
+     * are consecutive. The names are views into a single static array of characters.
+     *
+     * @tparam E
+     *      The enum type.
+     */
+    template<typename E>
+    struct enum_reflection {
+        static_assert(std::is_enum<E>::value, "E is not an enum");
+
+        using underlying_type = typename std::underlying_type<E>::type;
+
+        static constexpr std::size_t size = detail::count_enumerators<E>();
+
+        static constexpr std::array<E, size> values = [] {
+            std::array<E, size> values{};
+            std::size_t i = 0;
+            for (auto index : detail::sorted_enumerators<E>()) {
+                values[i++] = detail::scanned_enum_values<E>[index];
+            }
+            return values;
+        }();
+
+        static constexpr std::array<std::string_view, size> names = [] {
+            std::array<std::string_view, size> names{};
+            std::size_t offset = 0;
+            std::size_t i = 0;
+            for (auto index : detail::sorted_enumerators<E>()) {
+                const auto length = detail::scanned_enum_names<E>[index].size();
+                names[i++] = std::string_view(detail::enum_name_chars<E>.data() + offset, length);
+                offset += length + 1;
+            }
+            return names;
+        }();
+
+        static constexpr bool dense = size == 0 || static_cast<std::uint64_t>(static_cast<underlying_type>(values[size - 1]))
+                - static_cast<std::uint64_t>(static_cast<underlying_type>(values[0])) == size - 1;
+
+        /**
+         * Returns the index of value in values, or size if value is not an enumerator.
+         * The lookup is O(1) for dense enums and a binary search otherwise.
+         *
+         * @param value
+         *      The value to look up.
+         * @return
+         *      The index of value.
+         */
+        static constexpr std::size_t index_of(E value) noexcept {
+            if constexpr (size == 0) {
+                return 0;
+            } else if constexpr (dense) {
+                const auto index = static_cast<std::uint64_t>(static_cast<underlying_type>(value))
+                        - static_cast<std::uint64_t>(static_cast<underlying_type>(values[0]));
+                return index < size ? static_cast<std::size_t>(index) : size;
+            } else {
+                std::size_t first = 0;
+                std::size_t count = size;
+                while (count > 0) {
+                    const auto step = count / 2;
+                    if (static_cast<underlying_type>(values[first + step]) < static_cast<underlying_type>(value)) {
+                        first += step + 1;
+                        count -= step + 1;
+                    } else {
+                        count = step;
+                    }
+                }
+                return first < size && values[first] == value ? first : size;
+            }
+        }
+    };
+
+    /**
+     * Returns the name of the enumerator value, or an empty string if value is not an enumerator.
+     * The returned view points into static read-only data.
+     *
+     * @tparam E
+     *      The enum type.
+     * @param value
+     *      The value to look up.
+     * @return
+     *      The name of value.
+     */
+    template<typename E>
+    constexpr inline auto name_of(E value) noexcept -> typename std::enable_if<std::is_enum<E>::value, std::string_view>::type {
+        const auto index = enum_reflection<E>::index_of(value);
+        return index < enum_reflection<E>::size ? enum_reflection<E>::names[index] : std::string_view{};
+    }
+
+    /**
+     * Returns the name of the shared enum value, being its name in the first of Ts having an enumerator of
+     * that value, or an empty string if none has. The returned view points into static read-only data.
+     *
+     * @tparam Ts
+     *      The list of types of the shared enum.
+     * @param value
+     *      The value to look up.
+     * @return
+     *      The name of value.
+     */
+    template<typename... Ts>
+    constexpr inline std::string_view name_of(const shared_enum<Ts...>& value) noexcept {
+        std::string_view name;
+        static_cast<void>(((name = name_of(static_cast<Ts>(value)), !name.empty()) || ...));
+        return name;
+    }
+}
+
+#endif //TRAK_ENUM_REFLECTION_HPP
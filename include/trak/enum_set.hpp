@@ -0,0 +1,255 @@
+#ifndef TRAK_ENUM_SET_HPP
+#define TRAK_ENUM_SET_HPP
+
+#include <trak/detail/bits.hpp>
+#include <trak/enum_indexer.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace trak {
+
+    /**
+     * A set of keys of the enum E, stored as a bitset with one bit per index of enum_indexer. Membership tests
+     * and modifications are branch-free and never allocate. Shared enums are accepted as keys, as they are
+     * implicitly convertible to E.
+     *
+     * Keys without index are never contained, and inserting them has no effect.
+     *
+     * @tparam E
+     *      The enum type of the keys.
+     */
+    template<typename E>
+    class enum_set {
+        static_assert(std::is_enum<E>::value, "E is not an enum");
+
+        static constexpr std::size_t word_bits = 64;
+        static constexpr std::size_t word_count = enum_indexer<E>::size > 0 ? (enum_indexer<E>::size + word_bits - 1) / word_bits : 1;
+
+        /**
+         * Returns the word of key and the bit of key in that word, or no bit if key has no index.
+         */
+        static constexpr std::pair<std::size_t, std::uint64_t> locate(E key) noexcept {
+            const auto index = enum_indexer<E>::index(key);
+            const auto valid = index < enum_indexer<E>::size;
+            return {valid ? index / word_bits : 0, static_cast<std::uint64_t>(valid) << (index % word_bits)};
+        }
+
+    public:
+        using key_type = E;
+        using value_type = E;
+        using indexer = enum_indexer<E>;
+
+        /**
+         * Iterates the keys of a set in the order of their indices.
+         */
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = E;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const E*;
+            using reference = E;
+
+            constexpr const_iterator() noexcept = default;
+
+            constexpr E operator*() const noexcept {
+                return indexer::value(word_ * word_bits + detail::countr_zero64(bits_));
+            }
+
+            constexpr const_iterator& operator++() noexcept {
+                bits_ &= bits_ - 1;
+                skip_empty();
+                return *this;
+            }
+
+            constexpr const_iterator operator++(int) noexcept {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            constexpr bool operator==(const const_iterator& rhs) const noexcept {
+                return word_ == rhs.word_ && bits_ == rhs.bits_;
+            }
+
+            constexpr bool operator!=(const const_iterator& rhs) const noexcept {
+                return !(*this == rhs);
+            }
+
+        private:
+            friend class enum_set;
+
+            constexpr const_iterator(const enum_set* set, std::size_t word) noexcept
+                    : set_(set), word_(word), bits_(word < word_count ? set->words_[word] : 0) {
+                skip_empty();
+            }
+
+            constexpr void skip_empty() noexcept {
+                while (bits_ == 0 && word_ < word_count) {
+                    ++word_;
+                    bits_ = word_ < word_count ? set_->words_[word_] : 0;
+                }
+            }
+
+            const enum_set* set_ = nullptr;
+            std::size_t word_ = word_count;
+            std::uint64_t bits_ = 0;
+        };
+
+        using iterator = const_iterator;
+
+        /**
+         * Constructs an empty set.
+         */
+        constexpr enum_set() noexcept = default;
+
+        /**
+         * Constructs a set containing keys.
+         *
+         * @param keys
+         *      The keys to insert.
+         */
+        constexpr enum_set(std::initializer_list<E> keys) noexcept {
+            for (auto key : keys) {
+                insert(key);
+            }
+        }
+
+        /**
+         * Returns the maximum number of keys, being the number of indices of the indexer.
+         */
+        static constexpr std::size_t capacity() noexcept {
+            return indexer::size;
+        }
+
+        /**
+         * Returns \c true if key is contained in this set. Otherwise, returns \c false.
+         */
+        constexpr bool contains(E key) const noexcept {
+            const auto [word, bit] = locate(key);
+            return (words_[word] & bit) != 0;
+        }
+
+        /**
+         * Inserts key and returns \c true if it was not contained before. Otherwise, returns \c false.
+         */
+        constexpr bool insert(E key) noexcept {
+            const auto [word, bit] = locate(key);
+            const auto inserted = (words_[word] & bit) == 0 && bit != 0;
+            words_[word] |= bit;
+            return inserted;
+        }
+
+        /**
+         * Erases key and returns \c true if it was contained before. Otherwise, returns \c false.
+         */
+        constexpr bool erase(E key) noexcept {
+            const auto [word, bit] = locate(key);
+            const auto erased = (words_[word] & bit) != 0;
+            words_[word] &= ~bit;
+            return erased;
+        }
+
+        /**
+         * Erases all keys.
+         */
+        constexpr void clear() noexcept {
+            for (auto& word : words_) {
+                word = 0;
+            }
+        }
+
+        /**
+         * Returns the number of keys contained.
+         */
+        constexpr std::size_t size() const noexcept {
+            std::size_t size = 0;
+            for (auto word : words_) {
+                size += detail::popcount64(word);
+            }
+            return size;
+        }
+
+        constexpr bool empty() const noexcept {
+            std::uint64_t any = 0;
+            for (auto word : words_) {
+                any |= word;
+            }
+            return any == 0;
+        }
+
+        constexpr const_iterator begin() const noexcept {
+            return const_iterator(this, 0);
+        }
+
+        constexpr const_iterator end() const noexcept {
+            return const_iterator(this, word_count);
+        }
+
+        /**
+         * Inserts all keys of rhs.
+         */
+        constexpr enum_set& operator|=(const enum_set& rhs) noexcept {
+            for (std::size_t i = 0; i < word_count; ++i) {
+                words_[i] |= rhs.words_[i];
+            }
+            return *this;
+        }
+
+        /**
+         * Erases all keys not contained in rhs.
+         */
+        constexpr enum_set& operator&=(const enum_set& rhs) noexcept {
+            for (std::size_t i = 0; i < word_count; ++i) {
+                words_[i] &= rhs.words_[i];
+            }
+            return *this;
+        }
+
+        /**
+         * Erases all keys contained in rhs.
+         */
+        constexpr enum_set& operator-=(const enum_set& rhs) noexcept {
+            for (std::size_t i = 0; i < word_count; ++i) {
+                words_[i] &= ~rhs.words_[i];
+            }
+            return *this;
+        }
+
+        friend constexpr enum_set operator|(enum_set lhs, const enum_set& rhs) noexcept {
+            return lhs |= rhs;
+        }
+
+        friend constexpr enum_set operator&(enum_set lhs, const enum_set& rhs) noexcept {
+            return lhs &= rhs;
+        }
+
+        friend constexpr enum_set operator-(enum_set lhs, const enum_set& rhs) noexcept {
+            return lhs -= rhs;
+        }
+
+        friend constexpr bool operator==(const enum_set& lhs, const enum_set& rhs) noexcept {
+            for (std::size_t i = 0; i < word_count; ++i) {
+                if (lhs.words_[i] != rhs.words_[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend constexpr bool operator!=(const enum_set& lhs, const enum_set& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+    private:
+        std::array<std::uint64_t, word_count> words_{};
+    };
+}
+
+#endif //TRAK_ENUM_SET_HPP
@@ -0,0 +1,384 @@
+#ifndef TRAK_ENUM_TRAITS_HPP
+#define TRAK_ENUM_TRAITS_HPP
+
+#include <trak/detail/validate_kernels.hpp>
+#include <trak/enum_reflection.hpp>
+#include <trak/shared_bitfield.hpp>
+#include <trak/shared_enum.hpp>
+#include <trak/span.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * The valid values of E as sorted array.
+         *
+         * @tparam E
+         *      The enum type.
+         * @tparam Flags
+         *      Whether each combination of the bits of the values is valid.
+         * @tparam Values
+         *      Provides the static member array values of E, sorted by their underlying value.
+         */
+        template<typename E, bool Flags, typename Values>
+        struct enum_traits_base {
+            static_assert(std::is_enum<E>::value, "E is not an enum");
+
+            using underlying_type = typename std::underlying_type<E>::type;
+
+            static constexpr bool flags = Flags;
+            static constexpr auto values = Values::values;
+            static constexpr std::size_t size = values.size();
+
+            static constexpr underlying_type min = size == 0 ? underlying_type{} : static_cast<underlying_type>(values[0]);
+            static constexpr underlying_type max = size == 0 ? underlying_type{} : static_cast<underlying_type>(values[size - 1]);
+
+            /**
+             * The bit-wise 'or' of all values.
+             */
+            static constexpr underlying_type mask = [] {
+                underlying_type mask{};
+                for (auto value : values) {
+                    mask = static_cast<underlying_type>(mask | static_cast<underlying_type>(value));
+                }
+                return mask;
+            }();
+
+            /**
+             * Returns \c true if value is valid, being one of values, or having only bits of mask set for flags.
+             */
+            static constexpr bool contains(underlying_type value) noexcept {
+                if constexpr (flags) {
+                    return (value & ~mask) == 0;
+                } else {
+                    std::size_t first = 0;
+                    std::size_t count = size;
+                    while (count > 0) {
+                        const auto step = count / 2;
+                        if (static_cast<underlying_type>(values[first + step]) < value) {
+                            first += step + 1;
+                            count -= step + 1;
+                        } else {
+                            count = step;
+                        }
+                    }
+                    return first < size && static_cast<underlying_type>(values[first]) == value;
+                }
+            }
+        };
+
+        template<typename E, E... Vs>
+        struct sorted_enum_values {
+            using underlying_type = typename std::underlying_type<E>::type;
+
+            static constexpr std::array<E, sizeof...(Vs)> values = [] {
+                std::array<E, sizeof...(Vs)> values{{Vs...}};
+                for (std::size_t i = 1; i < values.size(); ++i) {
+                    for (auto k = i; k > 0 && static_cast<underlying_type>(values[k]) < static_cast<underlying_type>(values[k - 1]); --k) {
+                        const auto value = values[k];
+                        values[k] = values[k - 1];
+                        values[k - 1] = value;
+                    }
+                }
+                return values;
+            }();
+        };
+    }
+
+    /**
+     * The enum traits of E detected by enum_reflection. E is a set of flags if enum_range<E>::flags is \c true.
+     *
+     * @tparam E
+     *      The enum type.
+     */
+    template<typename E>
+    struct detected_enum_traits : detail::enum_traits_base<E, enum_range<E>::flags, enum_reflection<E>> {};
+
+    /**
+     * Enum traits of E declaring its valid values explicitly, for example if they are outside the range scanned
+     * by enum_reflection.
+     *
+     * @tparam E
+     *      The enum type.
+     * @tparam Vs
+     *      The valid values.
+     */
+    template<typename E, E... Vs>
+    struct declared_enum_traits : detail::enum_traits_base<E, false, detail::sorted_enum_values<E, Vs...>> {};
+
+    /**
+     * Enum traits of the flags E declaring its valid bits explicitly. Each combination of Vs is valid.
+     *
+     * @tparam E
+     *      The enum type.
+     * @tparam Vs
+     *      The valid flags.
+     */
+    template<typename E, E... Vs>
+    struct declared_flag_traits : detail::enum_traits_base<E, true, detail::sorted_enum_values<E, Vs...>> {};
+
+    /**
+     * Describes the valid values of E used to validate raw values.
+     *
+     * Provides the static member array values, sorted by their underlying value, the static member constants size,
+     * min, max, mask, being the bit-wise 'or' of all values, and flags, being \c true if each combination of the
+     * bits of mask is valid, and the static member function contains, checking a raw value.
+     *
+     * Specialize this template by deriving from declared_enum_traits or declared_flag_traits to declare the values
+     * of an enum once. By default, detected_enum_traits is used.
+     *
+     * @tparam E
+     *      The enum type.
+     */
+    template<typename E>
+    struct enum_traits : detected_enum_traits<E> {};
+
+    namespace detail {
+
+        /**
+         * The valid values of a non-flags enum as intervals of consecutive values.
+         */
+        template<typename U, std::size_t N>
+        struct value_intervals {
+            std::array<U, N> first{};
+            std::array<U, N> extent{};
+            std::size_t size = 0;
+        };
+
+        /**
+         * Returns the intervals of the first count values, which need to be sorted.
+         */
+        template<typename U, std::size_t N>
+        constexpr value_intervals<U, N> make_value_intervals(const std::array<U, N>& values, std::size_t count) noexcept {
+            value_intervals<U, N> intervals;
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto value = values[i];
+                if (intervals.size > 0 && static_cast<U>(value - intervals.first[intervals.size - 1]) <= intervals.extent[intervals.size - 1] + 1u) {
+                    intervals.extent[intervals.size - 1] = static_cast<U>(value - intervals.first[intervals.size - 1]);
+                } else {
+                    intervals.first[intervals.size] = value;
+                    intervals.extent[intervals.size] = 0;
+                    ++intervals.size;
+                }
+            }
+            return intervals;
+        }
+
+        template<typename Validator, typename U>
+        inline std::size_t validate_each(const U* data, std::size_t count) noexcept {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!Validator::contains(static_cast<typename Validator::underlying_type>(data[i]))) {
+                    return i;
+                }
+            }
+            return count;
+        }
+
+        /**
+         * Validates raw values of T, being an enum, shared enum or shared bitfield.
+         *
+         * Values of shared enums need to be valid for each of their types, like the enumerators parsed by
+         * parse. Values of shared bitfields need to have only bits valid for each of their types.
+         */
+        template<typename T, typename = void>
+        struct value_validator;
+
+        /**
+         * Returns \c true if the raw value is valid for each of the types Ts, whose underlying types may differ.
+         */
+        template<typename... Ts, typename U>
+        constexpr bool contains_for_each(U value) noexcept {
+            return common_value_range<typename enum_traits<Ts>::underlying_type...>::contains(value)
+                    && (enum_traits<Ts>::contains(static_cast<typename enum_traits<Ts>::underlying_type>(value)) && ...);
+        }
+
+        /**
+         * Returns the intervals of the values of type U valid for each of the types T and Ts.
+         */
+        template<typename U, typename T, typename... Ts>
+        constexpr auto make_value_intervals() noexcept {
+            using unsigned_type = typename std::make_unsigned<U>::type;
+            std::array<unsigned_type, enum_traits<T>::size> values{};
+            std::size_t count = 0;
+            for (auto value : enum_traits<T>::values) {
+                const auto raw = static_cast<typename enum_traits<T>::underlying_type>(value);
+                if (contains_for_each<T, Ts...>(raw)) {
+                    values[count++] = static_cast<unsigned_type>(static_cast<U>(raw));
+                }
+            }
+            return make_value_intervals(values, count);
+        }
+
+        /**
+         * The first of the types Ts which is not a set of flags, or the last type if all are.
+         */
+        template<typename T, typename... Ts>
+        struct enumerated_type {
+            using type = T;
+        };
+
+        template<typename T, typename U, typename... Ts>
+        struct enumerated_type<T, U, Ts...>
+                : std::conditional<enum_traits<T>::flags, enumerated_type<U, Ts...>, enumerated_type<T>>::type {};
+
+        /**
+         * Returns the bits of U valid for each of the flags Ts. As each combination of valid bits is valid, a raw
+         * value is valid if it has no other bits, even if the types differ in width or signedness.
+         */
+        template<typename U, typename... Ts>
+        constexpr typename std::make_unsigned<U>::type make_flags_mask() noexcept {
+            using unsigned_type = typename std::make_unsigned<U>::type;
+            unsigned_type mask = 0;
+            for (int bit = 0; bit < std::numeric_limits<unsigned_type>::digits; ++bit) {
+                const auto value = static_cast<unsigned_type>(unsigned_type{1} << bit);
+                if (contains_for_each<Ts...>(static_cast<U>(value))) {
+                    mask = static_cast<unsigned_type>(mask | value);
+                }
+            }
+            return mask;
+        }
+
+        /**
+         * Validates raw values of the shared enum of the types Ts. If all types are sets of flags, the bits valid
+         * for each type are checked as a mask. Otherwise the values of the first other type valid for each type
+         * are computed at compile time and checked as intervals.
+         */
+        template<typename U, typename... Ts>
+        struct enum_value_validator {
+            using underlying_type = U;
+            using unsigned_type = typename std::make_unsigned<underlying_type>::type;
+
+            static constexpr bool contains(underlying_type value) noexcept {
+                return contains_for_each<Ts...>(value);
+            }
+
+            static std::size_t validate(const unsigned_type* data, std::size_t count) noexcept {
+                if constexpr ((enum_traits<Ts>::flags && ...)) {
+                    static constexpr auto mask = make_flags_mask<U, Ts...>();
+                    return active_validate_kernels<unsigned_type>().first_with_bits(data, count, static_cast<unsigned_type>(~mask));
+                } else {
+                    static constexpr auto intervals = make_value_intervals<U, typename enumerated_type<Ts...>::type, Ts...>();
+                    if constexpr (intervals.size <= max_validate_intervals) {
+                        return active_validate_kernels<unsigned_type>().first_outside(
+                                data, count, intervals.first.data(), intervals.extent.data(), intervals.size);
+                    } else {
+                        return validate_each<enum_value_validator>(data, count);
+                    }
+                }
+            }
+        };
+
+        /**
+         * Validates raw values of the shared bitfield of the types Ts, being valid if they have only bits set
+         * which are valid for each type.
+         */
+        template<typename U, typename... Ts>
+        struct bitfield_value_validator {
+            using underlying_type = U;
+            using unsigned_type = typename std::make_unsigned<underlying_type>::type;
+
+            static constexpr unsigned_type mask = (static_cast<unsigned_type>(enum_traits<Ts>::mask) & ...);
+
+            static constexpr bool contains(underlying_type value) noexcept {
+                return (static_cast<unsigned_type>(value) & static_cast<unsigned_type>(~mask)) == 0;
+            }
+
+            static std::size_t validate(const unsigned_type* data, std::size_t count) noexcept {
+                return active_validate_kernels<unsigned_type>().first_with_bits(data, count, static_cast<unsigned_type>(~mask));
+            }
+        };
+
+        template<typename, bool>
+        struct shared_value_validator {};
+
+        template<typename... Ts>
+        struct shared_value_validator<shared_enum<Ts...>, false> {
+            using type = enum_value_validator<typename shared_enum<Ts...>::underlying_type, Ts...>;
+        };
+
+        template<typename... Ts>
+        struct shared_value_validator<shared_enum<Ts...>, true> {
+            using type = bitfield_value_validator<typename shared_enum<Ts...>::underlying_type, Ts...>;
+        };
+
+        template<typename T>
+        struct value_validator<T, typename std::enable_if<std::is_enum<T>::value>::type>
+                : enum_value_validator<typename std::underlying_type<T>::type, T> {};
+
+        template<typename T>
+        struct value_validator<T, typename std::enable_if<is_shared_enum<T>::value>::type>
+                : shared_value_validator<shared_enum_of_t<T>, is_shared_bitfield<T>::value>::type {};
+    }
+
+    /**
+     * Returns \c true if value is a valid raw value of T.
+     *
+     * @tparam T
+     *      The enum, shared enum or shared bitfield type.
+     */
+    template<typename T>
+    constexpr inline bool is_valid_value(typename detail::value_validator<T>::underlying_type value) noexcept {
+        return detail::value_validator<T>::contains(value);
+    }
+
+    /**
+     * Converts the raw value to T if it is valid. Unlike the explicit constructors from the underlying type,
+     * untrusted values are checked against enum_traits.
+     *
+     * @tparam T
+     *      The enum, shared enum or shared bitfield type.
+     * @param value
+     *      The raw value.
+     * @return
+     *      The value as T, or an empty optional if value is not valid.
+     */
+    template<typename T>
+    constexpr inline std::optional<T> checked_cast(typename detail::value_validator<T>::underlying_type value) noexcept {
+        if (!detail::value_validator<T>::contains(value)) {
+            return std::nullopt;
+        }
+        if constexpr (std::is_enum<T>::value) {
+            return static_cast<T>(value);
+        } else {
+            return T(value);
+        }
+    }
+
+    /**
+     * Validates raw values of T in bulk, using the widest instruction set supported by the executing CPU.
+     *
+     * The valid values of enums are checked as up to 8 intervals of consecutive values, and the valid values of
+     * flags and shared bitfields as a mask. Enums with more intervals are checked per value.
+     *
+     * @tparam T
+     *      The enum, shared enum or shared bitfield type.
+     * @param values
+     *      The raw values.
+     * @return
+     *      The index of the first invalid value, or values.size() if all are valid.
+     */
+    template<typename T>
+    inline std::size_t validate(span<const typename detail::value_validator<T>::underlying_type> values) noexcept {
+        using unsigned_type = typename detail::value_validator<T>::unsigned_type;
+        return detail::value_validator<T>::validate(reinterpret_cast<const unsigned_type*>(values.data()), values.size());
+    }
+
+    /**
+     * Validates values of T constructed without checks, for example viewed in place with view_enum_stream.
+     */
+    template<typename T, typename std::enable_if<std::is_enum<T>::value || detail::is_shared_enum<T>::value, int>::type = 0>
+    inline std::size_t validate(span<const T> values) noexcept {
+        using unsigned_type = typename detail::value_validator<T>::unsigned_type;
+        return detail::value_validator<T>::validate(reinterpret_cast<const unsigned_type*>(values.data()), values.size());
+    }
+}
+
+#endif //TRAK_ENUM_TRAITS_HPP
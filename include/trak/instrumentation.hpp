@@ -0,0 +1,239 @@
+#ifndef TRAK_INSTRUMENTATION_HPP
+#define TRAK_INSTRUMENTATION_HPP
+
+#include <trak/detail/type_name.hpp>
+#include <trak/enum_reflection.hpp>
+#include <trak/shared_enum.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace trak {
+
+    /**
+     * The counts of the instrumentation events of one enum value, summed over all threads.
+     */
+    struct instrument_record {
+        /**
+         * The qualified name of the enum type.
+         */
+        std::string_view type;
+
+        /**
+         * The name of the enumerator, or an empty string for the values which are no enumerators.
+         */
+        std::string_view name;
+
+        /**
+         * The value of the enumerator, or 0 for the values which are no enumerators.
+         */
+        long long value = 0;
+
+        /**
+         * The number of conversions of shared enums to the enum type with this value.
+         */
+        std::uint64_t conversions = 0;
+
+        /**
+         * The number of equality comparisons of shared enums with this value, counted for the enum type
+         * compared to, or the first common type of two shared enums.
+         */
+        std::uint64_t comparisons = 0;
+    };
+
+    namespace detail {
+
+        constexpr std::size_t cache_line_size = 64;
+        constexpr std::size_t counters_per_line = cache_line_size / sizeof(std::uint64_t);
+
+        /**
+         * Counters of one cache line, such that the counters of different threads never share a line.
+         */
+        struct alignas(cache_line_size) padded_counters {
+            std::atomic<std::uint64_t> counts[counters_per_line];
+        };
+
+        /**
+         * Describes an instrumented enum type for the report.
+         */
+        struct instrument_type {
+            std::string_view name;
+
+            /**
+             * The number of enumerators. The values which are no enumerators share the counter at index size.
+             */
+            std::size_t size;
+            std::string_view (*name_at)(std::size_t index) noexcept;
+            long long (*value_at)(std::size_t index) noexcept;
+        };
+
+        template<typename E>
+        std::string_view instrument_name_at(std::size_t index) noexcept {
+            return enum_reflection<E>::names[index];
+        }
+
+        template<typename E>
+        long long instrument_value_at(std::size_t index) noexcept {
+            return static_cast<long long>(static_cast<typename std::underlying_type<E>::type>(enum_reflection<E>::values[index]));
+        }
+
+        template<typename E>
+        inline constexpr instrument_type instrument_type_of{
+                type_name<E>(), enum_reflection<E>::size, &instrument_name_at<E>, &instrument_value_at<E>};
+
+        /**
+         * The counters of one thread for one enum type, being the counters of each event for each enumerator
+         * followed by the counter of the values which are no enumerators. Only the owning thread increments them.
+         */
+        struct instrument_block {
+            const instrument_type* type;
+            std::size_t size;
+            std::unique_ptr<padded_counters[]> lines;
+
+            explicit instrument_block(const instrument_type& type)
+                    : type(&type), size(2 * (type.size + 1)),
+                      lines(new padded_counters[(size + counters_per_line - 1) / counters_per_line]) {
+                for (std::size_t i = 0; i < size; ++i) {
+                    counter(i).store(0, std::memory_order_relaxed);
+                }
+            }
+
+            std::atomic<std::uint64_t>& counter(std::size_t index) noexcept {
+                return lines[index / counters_per_line].counts[index % counters_per_line];
+            }
+        };
+
+        /**
+         * Owns the blocks of all threads. Blocks outlive their threads, so the counts of finished threads are
+         * reported too.
+         */
+        struct instrument_registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<instrument_block>> blocks;
+        };
+
+        /**
+         * Returns the registry, which is never destroyed, so threads may count events during static destruction.
+         */
+        inline instrument_registry& get_instrument_registry() {
+            static auto* registry = new instrument_registry;
+            return *registry;
+        }
+
+        inline instrument_block* register_instrument_block(const instrument_type& type) {
+            auto& registry = get_instrument_registry();
+            auto block = std::make_unique<instrument_block>(type);
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.blocks.push_back(std::move(block));
+            return registry.blocks.back().get();
+        }
+
+        /**
+         * Counts the event in the block of the calling thread. The counter is only written by this thread, so it
+         * is incremented by a relaxed load and store instead of a locked read-modify-write.
+         */
+        template<typename E>
+        inline void instrument(instrument_event event, E value) noexcept {
+            static thread_local instrument_block* block = nullptr;
+            if (block == nullptr) {
+                block = register_instrument_block(instrument_type_of<E>);
+            }
+            const auto index = static_cast<std::size_t>(event) * (enum_reflection<E>::size + 1) + enum_reflection<E>::index_of(value);
+            auto& counter = block->counter(index);
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Merges the counters of all threads into a report, holding a record for each enum value with events,
+     * sorted by type name and value. Empty unless TRAK_INSTRUMENT is 1.
+     */
+    inline std::vector<instrument_record> instrument_report() {
+        std::vector<instrument_record> records;
+        auto& registry = detail::get_instrument_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto& block : registry.blocks) {
+            const auto& type = *block->type;
+            for (std::size_t index = 0; index <= type.size; ++index) {
+                const auto conversions = block->counter(index).load(std::memory_order_relaxed);
+                const auto comparisons = block->counter(type.size + 1 + index).load(std::memory_order_relaxed);
+                if (conversions == 0 && comparisons == 0) {
+                    continue;
+                }
+                instrument_record record;
+                record.type = type.name;
+                if (index < type.size) {
+                    record.name = type.name_at(index);
+                    record.value = type.value_at(index);
+                }
+                record.conversions = conversions;
+                record.comparisons = comparisons;
+                records.push_back(record);
+            }
+        }
+
+        // Sorts the records of the values which are no enumerators last, and merges the records of all threads.
+        std::sort(records.begin(), records.end(), [](const instrument_record& lhs, const instrument_record& rhs) {
+            if (lhs.type != rhs.type) {
+                return lhs.type < rhs.type;
+            }
+            if (lhs.name.empty() != rhs.name.empty()) {
+                return rhs.name.empty();
+            }
+            return lhs.value < rhs.value;
+        });
+        std::size_t size = 0;
+        for (const auto& record : records) {
+            if (size > 0 && records[size - 1].type == record.type && records[size - 1].name == record.name) {
+                records[size - 1].conversions += record.conversions;
+                records[size - 1].comparisons += record.comparisons;
+            } else {
+                records[size++] = record;
+            }
+        }
+        records.resize(size);
+        return records;
+    }
+
+    /**
+     * Resets the counters of all threads. Events counted concurrently may be lost or survive the reset.
+     */
+    inline void reset_instrument_counters() {
+        auto& registry = detail::get_instrument_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto& block : registry.blocks) {
+            for (std::size_t i = 0; i < block->size; ++i) {
+                block->counter(i).store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Writes the report as tab-separated lines of type, enumerator, value, conversions and comparisons, the
+     * enumerator of values which are no enumerators being '?'.
+     *
+     * @return
+     *      \c true if the report was written, \c false on an output error.
+     */
+    inline bool write_instrument_report(std::FILE* file) {
+        bool written = std::fprintf(file, "type\tenumerator\tvalue\tconversions\tcomparisons\n") >= 0;
+        for (const auto& record : instrument_report()) {
+            const auto name = record.name.empty() ? std::string_view("?") : record.name;
+            written = written && std::fprintf(file, "%.*s\t%.*s\t%lld\t%llu\t%llu\n",
+                    static_cast<int>(record.type.size()), record.type.data(), static_cast<int>(name.size()), name.data(),
+                    record.value, static_cast<unsigned long long>(record.conversions),
+                    static_cast<unsigned long long>(record.comparisons)) >= 0;
+        }
+        return written;
+    }
+}
+
+#endif //TRAK_INSTRUMENTATION_HPP
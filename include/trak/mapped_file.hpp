@@ -0,0 +1,108 @@
+#ifndef TRAK_MAPPED_FILE_HPP
+#define TRAK_MAPPED_FILE_HPP
+
+#include <trak/serialization.hpp>
+#include <trak/span.hpp>
+
+#include <cstddef>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TRAK_HAS_MAPPED_FILE 1
+#else
+#define TRAK_HAS_MAPPED_FILE 0
+#endif
+
+namespace trak {
+
+#if TRAK_HAS_MAPPED_FILE
+
+    /**
+     * A read-only memory mapping of a file. Enum streams in native byte order are read in place with
+     * view_enum_stream, the mapping being page aligned.
+     */
+    class mapped_file {
+    public:
+        mapped_file() = default;
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept : data_(other.data_), size_(other.size_) {
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept {
+            if (this != &other) {
+                close();
+                data_ = other.data_;
+                size_ = other.size_;
+                other.data_ = nullptr;
+                other.size_ = 0;
+            }
+            return *this;
+        }
+
+        ~mapped_file() {
+            close();
+        }
+
+        /**
+         * Maps the file at path, unmapping the previous file.
+         */
+        stream_error open(const char* path) noexcept {
+            close();
+            const int fd = ::open(path, O_RDONLY);
+            if (fd < 0) {
+                return stream_error::io;
+            }
+            struct stat status {};
+            if (::fstat(fd, &status) != 0) {
+                ::close(fd);
+                return stream_error::io;
+            }
+            const auto size = static_cast<std::size_t>(status.st_size);
+            if (size > 0) {
+                void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data == MAP_FAILED) {
+                    ::close(fd);
+                    return stream_error::io;
+                }
+                data_ = static_cast<const unsigned char*>(data);
+                size_ = size;
+            }
+            ::close(fd);
+            return stream_error::none;
+        }
+
+        /**
+         * Unmaps the file.
+         */
+        void close() noexcept {
+            if (data_ != nullptr) {
+                ::munmap(const_cast<unsigned char*>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+
+        /**
+         * Returns the bytes of the file.
+         */
+        span<const unsigned char> bytes() const noexcept {
+            return span<const unsigned char>(data_, size_);
+        }
+
+    private:
+        const unsigned char* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+#endif
+}
+
+#endif //TRAK_MAPPED_FILE_HPP
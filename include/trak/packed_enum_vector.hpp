@@ -0,0 +1,170 @@
+#ifndef TRAK_PACKED_ENUM_VECTOR_HPP
+#define TRAK_PACKED_ENUM_VECTOR_HPP
+
+#include <trak/detail/packed_kernels.hpp>
+#include <trak/enum_indexer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace trak {
+
+    namespace detail {
+
+        /**
+         * Returns the number of bits needed to store the indices [0, size).
+         */
+        constexpr unsigned int packed_width(std::size_t size) noexcept {
+            unsigned int width = 1;
+            while (width < 64 && (std::uint64_t{1} << width) < size) {
+                ++width;
+            }
+            return width;
+        }
+    }
+
+    /**
+     * A vector of enum or shared enum values, each stored with the minimum number of bits to represent its index
+     * in enum_indexer. The values need to have an index.
+     *
+     * Values are accessed by value rather than by reference. Bulk unpacking is vectorized with the widest
+     * instruction set supported by the executing CPU.
+     *
+     * @tparam T
+     *      The enum or shared enum type of the values. Shared enums are indexed by their first type.
+     */
+    template<typename T>
+    class packed_enum_vector {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using enum_type = typename detail::index_enum_type<T>::type;
+        using indexer = enum_indexer<enum_type>;
+
+        /**
+         * The number of bits stored per value.
+         */
+        static constexpr unsigned int width = detail::packed_width(indexer::size);
+        static_assert(width <= 24, "The indices of T are too large to be packed");
+
+        /**
+         * Constructs an empty vector.
+         */
+        packed_enum_vector() = default;
+
+        /**
+         * Returns the number of values.
+         */
+        size_type size() const noexcept {
+            return size_;
+        }
+
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        /**
+         * Returns the number of bytes allocated for the packed values.
+         */
+        size_type memory_usage() const noexcept {
+            return bytes_.capacity();
+        }
+
+        /**
+         * Reserves memory for at least size values.
+         */
+        void reserve(size_type size) {
+            bytes_.reserve(byte_size(size));
+        }
+
+        /**
+         * Removes all values.
+         */
+        void clear() noexcept {
+            bytes_.clear();
+            size_ = 0;
+        }
+
+        /**
+         * Appends value.
+         */
+        void push_back(T value) {
+            bytes_.resize(byte_size(size_ + 1));
+            store(size_++, value);
+        }
+
+        /**
+         * Returns the value at index, which needs to be less than size.
+         */
+        T operator[](size_type index) const noexcept {
+            const auto bit = static_cast<std::uint64_t>(index) * width;
+            std::uint64_t word;
+            std::memcpy(&word, bytes_.data() + bit / 8, sizeof(word));
+            return to_value(static_cast<std::size_t>((word >> (bit % 8)) & mask));
+        }
+
+        /**
+         * Replaces the value at index, which needs to be less than size.
+         */
+        void set(size_type index, T value) noexcept {
+            store(index, value);
+        }
+
+        /**
+         * Unpacks count values starting at first into out. The range needs to be within size.
+         */
+        void unpack(size_type first, size_type count, T* out) const noexcept {
+            constexpr size_type chunk = 256;
+            std::uint32_t indices[chunk];
+            const auto kernel = detail::active_unpack_kernel();
+            for (size_type i = 0; i < count; i += chunk) {
+                const auto n = count - i < chunk ? count - i : chunk;
+                kernel(bytes_.data(), first + i, n, width, indices);
+                for (size_type k = 0; k < n; ++k) {
+                    out[i + k] = to_value(indices[k]);
+                }
+            }
+        }
+
+        /**
+         * Returns all values unpacked into a vector.
+         */
+        std::vector<T> unpack() const {
+            std::vector<T> values(size_, to_value(0));
+            unpack(0, size_, values.data());
+            return values;
+        }
+
+    private:
+        static constexpr std::uint64_t mask = (std::uint64_t{1} << width) - 1;
+
+        /**
+         * Returns the number of bytes to store size values, including padding for 8-byte accesses.
+         */
+        static constexpr size_type byte_size(size_type size) noexcept {
+            return (static_cast<std::uint64_t>(size) * width + 7) / 8 + sizeof(std::uint64_t);
+        }
+
+        static T to_value(std::size_t index) noexcept {
+            return static_cast<T>(indexer::value(index));
+        }
+
+        void store(size_type index, T value) noexcept {
+            const auto bit = static_cast<std::uint64_t>(index) * width;
+            auto* data = bytes_.data() + bit / 8;
+            std::uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            const auto packed = static_cast<std::uint64_t>(indexer::index(static_cast<enum_type>(value))) & mask;
+            word = (word & ~(mask << (bit % 8))) | (packed << (bit % 8));
+            std::memcpy(data, &word, sizeof(word));
+        }
+
+        std::vector<unsigned char> bytes_;
+        size_type size_ = 0;
+    };
+}
+
+#endif //TRAK_PACKED_ENUM_VECTOR_HPP
@@ -0,0 +1,491 @@
+#ifndef TRAK_SERIALIZATION_HPP
+#define TRAK_SERIALIZATION_HPP
+
+#include <trak/detail/type_name.hpp>
+#include <trak/shared_bitfield.hpp>
+#include <trak/shared_enum.hpp>
+#include <trak/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace trak {
+
+    /**
+     * The byte order of the values of an enum stream.
+     */
+    enum class endian : std::uint8_t {
+        little,
+        big,
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        native = big
+#else
+        native = little
+#endif
+    };
+
+    /**
+     * The result of reading or writing an enum stream.
+     */
+    enum class stream_error {
+        none,
+        /** The file could not be opened, read or written. */
+        io,
+        /** The data ends before the header or the values recorded in the header. */
+        truncated,
+        /** The data does not start with an enum stream header of a supported version. */
+        format,
+        /** The values are of a different type. */
+        type,
+        /** The values have a different width than the type. */
+        width,
+        /** The values are not stored in native byte order, so they cannot be read in place. */
+        endianness,
+        /** The values are not aligned for their type, so they cannot be read in place. */
+        alignment
+    };
+
+    /**
+     * The header preceding the values of an enum stream. The fields of the header are stored little-endian, and
+     * the values start at the first byte after the header, being aligned for values up to 8 bytes wide.
+     */
+    struct stream_header {
+        static constexpr char magic_value[8] = {'T', 'R', 'A', 'K', 'E', 'N', 'U', 'M'};
+        static constexpr std::uint16_t current_version = 1;
+        static constexpr std::size_t size = 32;
+
+        std::uint16_t version = current_version;
+        /** The byte order of the values. */
+        endian order = endian::native;
+        /** The width of each value in bytes. */
+        std::uint8_t width = 0;
+        /** The hash of the value type, see stream_type_id. */
+        std::uint64_t type_id = 0;
+        /** The number of values. */
+        std::uint64_t count = 0;
+    };
+
+    /**
+     * The name identifying the enum E in the type identity of enum streams.
+     *
+     * By default, it is the qualified name of E as reflected by the compiler, which differs between compilers,
+     * for example for enums in anonymous namespaces. Streams of such enums can only be read by builds of the same
+     * compiler. Specialize this template with a stable value to exchange streams between compilers, or to keep
+     * reading them after renaming E.
+     *
+     * @tparam E
+     *      The enum type.
+     */
+    template<typename E>
+    struct stream_type_name {
+        static constexpr std::string_view value = detail::type_name<E>();
+    };
+
+    namespace detail {
+
+        constexpr std::uint64_t hash_bytes(std::uint64_t hash, std::string_view bytes) noexcept {
+            for (auto c : bytes) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        template<typename T, typename = void>
+        struct stream_type_traits {
+            static_assert(std::is_enum<T>::value, "T is neither an enum, shared enum nor shared bitfield");
+            using underlying_type = typename std::underlying_type<T>::type;
+
+            static constexpr std::uint64_t id = hash_bytes(hash_bytes(0xcbf29ce484222325ull, "enum:"), stream_type_name<T>::value);
+        };
+
+        template<typename... Ts>
+        constexpr std::uint64_t hash_type_names(std::string_view kind) noexcept {
+            auto hash = hash_bytes(0xcbf29ce484222325ull, kind);
+            static_cast<void>(((hash = hash_bytes(hash_bytes(hash, stream_type_name<Ts>::value), ",")), ...));
+            return hash;
+        }
+
+        template<typename>
+        struct stream_type_ids {};
+
+        template<typename... Ts>
+        struct stream_type_ids<shared_enum<Ts...>> {
+            static constexpr std::uint64_t shared_enum_id = hash_type_names<Ts...>("shared_enum:");
+            static constexpr std::uint64_t shared_bitfield_id = hash_type_names<Ts...>("shared_bitfield:");
+        };
+
+        template<typename T>
+        struct stream_type_traits<T, typename std::enable_if<is_shared_enum<T>::value>::type> {
+            static_assert(std::is_standard_layout<T>::value && sizeof(T) == sizeof(typename T::underlying_type),
+                          "Shared enums need to have the layout of their underlying type");
+            using underlying_type = typename T::underlying_type;
+
+            static constexpr std::uint64_t id = is_shared_bitfield<T>::value
+                    ? stream_type_ids<shared_enum_of_t<T>>::shared_bitfield_id
+                    : stream_type_ids<shared_enum_of_t<T>>::shared_enum_id;
+        };
+
+        template<typename U>
+        inline U byteswap(U value) noexcept {
+            static_assert(std::is_integral<U>::value, "U is not an integer");
+            if constexpr (sizeof(U) == 1) {
+                return value;
+            } else {
+                unsigned char bytes[sizeof(U)];
+                std::memcpy(bytes, &value, sizeof(U));
+                for (std::size_t i = 0; i < sizeof(U) / 2; ++i) {
+                    std::swap(bytes[i], bytes[sizeof(U) - 1 - i]);
+                }
+                std::memcpy(&value, bytes, sizeof(U));
+                return value;
+            }
+        }
+
+        /**
+         * Reverses the byte order of each of the count values of width bytes at data.
+         */
+        template<typename U>
+        inline void byteswap_values(unsigned char* data, std::size_t count) noexcept {
+            for (std::size_t i = 0; i < count; ++i) {
+                U value;
+                std::memcpy(&value, data + i * sizeof(U), sizeof(U));
+                value = byteswap(value);
+                std::memcpy(data + i * sizeof(U), &value, sizeof(U));
+            }
+        }
+
+        inline void store_le(unsigned char* data, std::uint64_t value, std::size_t bytes) noexcept {
+            for (std::size_t i = 0; i < bytes; ++i) {
+                data[i] = static_cast<unsigned char>(value >> (8 * i));
+            }
+        }
+
+        inline std::uint64_t load_le(const unsigned char* data, std::size_t bytes) noexcept {
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < bytes; ++i) {
+                value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        struct file_closer {
+            void operator()(std::FILE* file) const noexcept {
+                std::fclose(file);
+            }
+        };
+
+        using file_handle = std::unique_ptr<std::FILE, file_closer>;
+    }
+
+    /**
+     * The type identity of T recorded in the header of an enum stream, being a hash of the kind of T and the
+     * stream_type_name of its enum types.
+     */
+    template<typename T>
+    inline constexpr std::uint64_t stream_type_id = detail::stream_type_traits<T>::id;
+
+    /**
+     * Encodes header into the stream_header::size bytes of data.
+     */
+    inline void encode_stream_header(const stream_header& header, unsigned char* data) noexcept {
+        std::memset(data, 0, stream_header::size);
+        std::memcpy(data, stream_header::magic_value, sizeof(stream_header::magic_value));
+        detail::store_le(data + 8, header.version, 2);
+        data[10] = static_cast<unsigned char>(header.order);
+        data[11] = header.width;
+        detail::store_le(data + 16, header.type_id, 8);
+        detail::store_le(data + 24, header.count, 8);
+    }
+
+    /**
+     * Decodes the header of the stream_header::size bytes of data into header.
+     */
+    inline stream_error decode_stream_header(const unsigned char* data, stream_header& header) noexcept {
+        if (std::memcmp(data, stream_header::magic_value, sizeof(stream_header::magic_value)) != 0) {
+            return stream_error::format;
+        }
+        header.version = static_cast<std::uint16_t>(detail::load_le(data + 8, 2));
+        if (header.version != stream_header::current_version || data[10] > static_cast<unsigned char>(endian::big)) {
+            return stream_error::format;
+        }
+        header.order = static_cast<endian>(data[10]);
+        header.width = data[11];
+        header.type_id = detail::load_le(data + 16, 8);
+        header.count = detail::load_le(data + 24, 8);
+        return stream_error::none;
+    }
+
+    /**
+     * Checks whether header describes values of type T.
+     */
+    template<typename T>
+    inline stream_error check_stream_header(const stream_header& header) noexcept {
+        if (header.type_id != stream_type_id<T>) {
+            return stream_error::type;
+        }
+        if (header.width != sizeof(typename detail::stream_type_traits<T>::underlying_type)) {
+            return stream_error::width;
+        }
+        return stream_error::none;
+    }
+
+    /**
+     * Returns the values of the enum stream in bytes without copying them, e.g. from a memory-mapped file.
+     * The values need to be in native byte order, and bytes needs to be aligned for T, which a memory-mapped file
+     * or a buffer allocated with new is.
+     *
+     * @tparam T
+     *      The enum, shared enum or shared bitfield type of the values.
+     * @param bytes
+     *      The encoded enum stream.
+     * @param values
+     *      Assigned the values of the stream on success.
+     * @return
+     *      stream_error::none on success. Otherwise, the reason the values cannot be viewed.
+     */
+    template<typename T>
+    inline stream_error view_enum_stream(span<const unsigned char> bytes, span<const T>& values) noexcept {
+        stream_header header;
+        if (bytes.size() < stream_header::size) {
+            return stream_error::truncated;
+        }
+        if (const auto error = decode_stream_header(bytes.data(), header); error != stream_error::none) {
+            return error;
+        }
+        if (const auto error = check_stream_header<T>(header); error != stream_error::none) {
+            return error;
+        }
+        if (header.order != endian::native) {
+            return stream_error::endianness;
+        }
+        if ((bytes.size() - stream_header::size) / sizeof(T) < header.count) {
+            return stream_error::truncated;
+        }
+        if (reinterpret_cast<std::uintptr_t>(bytes.data() + stream_header::size) % alignof(T) != 0) {
+            return stream_error::alignment;
+        }
+        values = span<const T>(reinterpret_cast<const T*>(bytes.data() + stream_header::size), static_cast<std::size_t>(header.count));
+        return stream_error::none;
+    }
+
+    /**
+     * Writes values of type T to an enum stream file through a buffer. The number of values is written to the
+     * header when the writer is closed.
+     *
+     * @tparam T
+     *      The enum, shared enum or shared bitfield type of the values.
+     */
+    template<typename T>
+    class enum_stream_writer {
+        using underlying_type = typename detail::stream_type_traits<T>::underlying_type;
+
+    public:
+        /**
+         * @param order
+         *      The byte order to write the values in.
+         * @param buffer_size
+         *      The number of values buffered before writing to the file.
+         */
+        explicit enum_stream_writer(endian order = endian::native, std::size_t buffer_size = 1u << 14u)
+                : order_(order), buffer_(new unsigned char[buffer_size * sizeof(T)]), buffer_size_(buffer_size) {}
+
+        enum_stream_writer(const enum_stream_writer&) = delete;
+        enum_stream_writer& operator=(const enum_stream_writer&) = delete;
+
+        ~enum_stream_writer() {
+            close();
+        }
+
+        /**
+         * Creates the file at path, replacing an existing file, and writes the header.
+         */
+        stream_error open(const char* path) {
+            close();
+            file_.reset(std::fopen(path, "wb"));
+            if (!file_) {
+                return error_ = stream_error::io;
+            }
+            count_ = 0;
+            buffered_ = 0;
+            error_ = stream_error::none;
+            return write_header();
+        }
+
+        /**
+         * Appends values to the stream.
+         */
+        stream_error write(span<const T> values) {
+            for (std::size_t i = 0; i < values.size() && error_ == stream_error::none;) {
+                const auto n = values.size() - i < buffer_size_ - buffered_ ? values.size() - i : buffer_size_ - buffered_;
+                auto* data = buffer_.get() + buffered_ * sizeof(T);
+                std::memcpy(data, values.data() + i, n * sizeof(T));
+                if (order_ != endian::native) {
+                    detail::byteswap_values<underlying_type>(data, n);
+                }
+                buffered_ += n;
+                i += n;
+                if (buffered_ == buffer_size_) {
+                    flush();
+                }
+            }
+            return error_;
+        }
+
+        /**
+         * Appends value to the stream.
+         */
+        stream_error write(const T& value) {
+            return write(span<const T>(&value, 1));
+        }
+
+        /**
+         * Writes the buffered values to the file.
+         */
+        stream_error flush() {
+            if (file_ && error_ == stream_error::none && buffered_ > 0) {
+                if (std::fwrite(buffer_.get(), sizeof(T), buffered_, file_.get()) != buffered_) {
+                    error_ = stream_error::io;
+                }
+                count_ += buffered_;
+                buffered_ = 0;
+            }
+            return error_;
+        }
+
+        /**
+         * Flushes the buffered values, writes the number of values to the header, and closes the file.
+         */
+        stream_error close() {
+            if (!file_) {
+                return error_;
+            }
+            flush();
+            if (error_ == stream_error::none) {
+                if (std::fseek(file_.get(), 0, SEEK_SET) == 0) {
+                    write_header();
+                } else {
+                    error_ = stream_error::io;
+                }
+            }
+            if (std::fclose(file_.release()) != 0 && error_ == stream_error::none) {
+                error_ = stream_error::io;
+            }
+            return error_;
+        }
+
+        /**
+         * Returns the first error that occurred, or stream_error::none.
+         */
+        stream_error error() const noexcept {
+            return error_;
+        }
+
+    private:
+        stream_error write_header() {
+            stream_header header;
+            header.order = order_;
+            header.width = sizeof(underlying_type);
+            header.type_id = stream_type_id<T>;
+            header.count = count_;
+            unsigned char data[stream_header::size];
+            encode_stream_header(header, data);
+            if (std::fwrite(data, 1, sizeof(data), file_.get()) != sizeof(data)) {
+                error_ = stream_error::io;
+            }
+            return error_;
+        }
+
+        endian order_;
+        detail::file_handle file_;
+        std::unique_ptr<unsigned char[]> buffer_;
+        std::size_t buffer_size_;
+        std::size_t buffered_ = 0;
+        std::uint64_t count_ = 0;
+        stream_error error_ = stream_error::none;
+    };
+
+    /**
+     * Reads the values of type T of an enum stream file, converting them to native byte order.
+     *
+     * @tparam T
+     *      The enum, shared enum or shared bitfield type of the values.
+     */
+    template<typename T>
+    class enum_stream_reader {
+        using underlying_type = typename detail::stream_type_traits<T>::underlying_type;
+
+    public:
+        enum_stream_reader() = default;
+
+        /**
+         * Opens the file at path and checks its header.
+         */
+        stream_error open(const char* path) {
+            file_.reset(std::fopen(path, "rb"));
+            remaining_ = 0;
+            if (!file_) {
+                return error_ = stream_error::io;
+            }
+            unsigned char data[stream_header::size];
+            if (std::fread(data, 1, sizeof(data), file_.get()) != sizeof(data)) {
+                return error_ = stream_error::truncated;
+            }
+            if ((error_ = decode_stream_header(data, header_)) != stream_error::none) {
+                return error_;
+            }
+            if ((error_ = check_stream_header<T>(header_)) != stream_error::none) {
+                return error_;
+            }
+            remaining_ = header_.count;
+            return error_;
+        }
+
+        /**
+         * Returns the header of the stream.
+         */
+        const stream_header& header() const noexcept {
+            return header_;
+        }
+
+        /**
+         * Reads up to out.size() values into out, and returns the number of values read. Returns less values
+         * than requested only at the end of the stream or on error.
+         */
+        std::size_t read(span<T> out) {
+            if (error_ != stream_error::none || !file_) {
+                return 0;
+            }
+            const auto requested = out.size() < remaining_ ? out.size() : static_cast<std::size_t>(remaining_);
+            const auto n = std::fread(out.data(), sizeof(T), requested, file_.get());
+            if (n != requested) {
+                error_ = stream_error::truncated;
+            }
+            if (header_.order != endian::native) {
+                detail::byteswap_values<underlying_type>(reinterpret_cast<unsigned char*>(out.data()), n);
+            }
+            remaining_ -= n;
+            return n;
+        }
+
+        /**
+         * Returns the first error that occurred, or stream_error::none.
+         */
+        stream_error error() const noexcept {
+            return error_;
+        }
+
+    private:
+        detail::file_handle file_;
+        stream_header header_;
+        std::uint64_t remaining_ = 0;
+        stream_error error_ = stream_error::none;
+    };
+}
+
+#endif //TRAK_SERIALIZATION_HPP
@@ -15,6 +15,21 @@ namespace trak {
     template<typename... Ts>
     class shared_bitfield;
 
+    namespace detail {
+
+        template<typename... Ts>
+        std::true_type is_shared_bitfield_test(const shared_bitfield<Ts...>*);
+
+        std::false_type is_shared_bitfield_test(const void*);
+
+        /**
+         * Checks whether T is a shared bitfield or derived from a shared bitfield. Provides the member constant
+         * value which is equal to \c true if so. Otherwise, value is \c false.
+         */
+        template<typename T>
+        struct is_shared_bitfield : decltype(is_shared_bitfield_test(static_cast<const T*>(nullptr))) {};
+    }
+
     /**
      * Invalid specification.
      */
@@ -33,6 +48,12 @@ namespace trak {
         using type = shared_bitfield<Ts...>;
     };
 
+    /**
+     * The shared bitfield of the types Ts in canonical order.
+     */
+    template<typename... Ts>
+    using canonical_shared_bitfield_t = typename shared_enum_to_bitfield<canonical_shared_enum_t<Ts...>>::type;
+
     /**
      * Represents an bitfield value being member of multiple bitfields.
      * The value is implicitly convertible to each bitfield type.
@@ -46,7 +67,41 @@ namespace trak {
     class shared_bitfield<T, Ts...> : public shared_enum<T, Ts...> {
     public:
         using underlying_type = typename shared_enum<T, Ts...>::underlying_type;
-        using shared_enum<T, Ts...>::shared_enum;
+
+        // The constructors of shared_enum are forwarded rather than inherited, as inherited constructors do not
+        // inherit the attributes of TRAK_INLINE.
+
+        /**
+         * Constructor
+         *
+         * @tparam U
+         *      The type of value, being one of the types of the shared bitfield.
+         * @param value
+         *      The value of this shared bitfield.
+         */
+        template<typename U, typename std::enable_if<!detail::is_shared_enum<U>::value, int>::type = 0>
+        constexpr TRAK_INLINE shared_bitfield(U value) noexcept : shared_enum<T, Ts...>(value) {}
+
+        /**
+         * Constructor
+         *
+         * Converts a shared enum or bitfield whose types are a superset of the types of this shared bitfield.
+         *
+         * @tparam Us
+         *      The list of types of the shared enum to convert.
+         * @param value
+         *      The value of this shared bitfield.
+         */
+        template<typename... Us, typename std::enable_if<(shared_enum_member<T, Us...> && ... && shared_enum_member<Ts, Us...>), int>::type = 0>
+        constexpr TRAK_INLINE shared_bitfield(const shared_enum<Us...>& value) noexcept : shared_enum<T, Ts...>(value) {}
+
+        /**
+         * Constructor
+         *
+         * @param value
+         *      The value of this shared bitfield.
+         */
+        constexpr TRAK_INLINE explicit shared_bitfield(underlying_type value) noexcept : shared_enum<T, Ts...>(value) {}
 
         /**
          * Performs a bit-wise 'or' operation on the values of this and rhs, while
@@ -56,24 +111,26 @@ namespace trak {
          *      The list of types of the right-hand side shared bitfield.
          */
         template<typename... Us>
-        constexpr inline auto operator|(shared_bitfield<Us...> rhs) const -> typename std::enable_if<!std::is_same<
-                typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type, shared_enum<>>::value,
-        typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type>::type {
-            return static_cast<typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type>(
-                    static_cast<underlying_type>(*this) | static_cast<underlying_type>(rhs));
+        constexpr TRAK_INLINE auto operator|(shared_bitfield<Us...> rhs) const -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>),
+                typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type) {
+            using result_type = typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type;
+            using result_underlying_type = typename result_type::underlying_type;
+            return static_cast<result_type>(static_cast<result_underlying_type>(
+                    static_cast<result_underlying_type>(detail::underlying_value(*this)) | static_cast<result_underlying_type>(detail::underlying_value(rhs))));
         }
 
         /**
          * Performs a bit-wise 'or' assignment operation on the values of this and rhs.
-         * The types of the right-hand side must be a superset of this.
+         * The types of the right-hand side need to intersect the ones of this, and its underlying type must not be
+         * wider than the one of this, so no bit of rhs is lost.
          *
          * @tparam Us
          *      The list of types of the right-hand side shared bitfield.
          */
         template<typename... Us>
-        inline auto operator|=(shared_bitfield<Us...> rhs) -> typename std::enable_if<!std::is_same<
-                typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type, shared_enum<>>::value, shared_bitfield&>::type {
-            this->value_ |= static_cast<underlying_type>(rhs);
+        TRAK_INLINE auto operator|=(shared_bitfield<Us...> rhs) -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>
+                && sizeof(typename shared_bitfield<Us...>::underlying_type) <= sizeof(underlying_type)), shared_bitfield&) {
+            this->value_ |= static_cast<underlying_type>(detail::underlying_value(rhs));
             return *this;
         }
 
@@ -85,24 +142,25 @@ namespace trak {
          *      The list of types of the right-hand side shared bitfield.
          */
         template<typename... Us>
-        constexpr inline auto operator&(shared_bitfield<Us...> rhs) const -> typename std::enable_if<!std::is_same<
-                typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type, shared_enum<>>::value,
-                typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type>::type {
-            return static_cast<typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type>(
-                    static_cast<underlying_type>(*this) & static_cast<underlying_type>(rhs));
+        constexpr TRAK_INLINE auto operator&(shared_bitfield<Us...> rhs) const -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>),
+                typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type) {
+            using result_type = typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type;
+            using result_underlying_type = typename result_type::underlying_type;
+            return static_cast<result_type>(static_cast<result_underlying_type>(
+                    static_cast<result_underlying_type>(detail::underlying_value(*this)) & static_cast<result_underlying_type>(detail::underlying_value(rhs))));
         }
 
         /**
          * Performs a bit-wise 'and' assignment operation on the values of this and rhs.
-         * The types of the right-hand side must be a superset of this.
+         * The types of the right-hand side need to intersect the ones of this. The bits of a wider rhs beyond the
+         * underlying type of this are cleared by the operation, so rhs may be of any width.
          *
          * @tparam Us
          *      The list of types of the right-hand side shared bitfield.
          */
         template<typename... Us>
-        inline auto operator&=(shared_bitfield<Us...> rhs) -> typename std::enable_if<!std::is_same<
-                typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type, shared_enum<>>::value, shared_bitfield&>::type {
-            this->value_ &= static_cast<underlying_type>(rhs);
+        TRAK_INLINE auto operator&=(shared_bitfield<Us...> rhs) -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>), shared_bitfield&) {
+            this->value_ &= static_cast<underlying_type>(detail::underlying_value(rhs));
             return *this;
         }
 
@@ -114,27 +172,41 @@ namespace trak {
          *      The list of types of the right-hand side shared bitfield.
          */
         template<typename... Us>
-        constexpr inline auto operator^(shared_bitfield<Us...> rhs) const -> typename std::enable_if<!std::is_same<
-                typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type, shared_enum<>>::value,
-                typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type>::type {
-            return static_cast<typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type>(
-                    static_cast<underlying_type>(*this) ^ static_cast<underlying_type>(rhs));
+        constexpr TRAK_INLINE auto operator^(shared_bitfield<Us...> rhs) const -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>),
+                typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type) {
+            using result_type = typename shared_enum_to_bitfield<typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type>::type;
+            using result_underlying_type = typename result_type::underlying_type;
+            return static_cast<result_type>(static_cast<result_underlying_type>(
+                    static_cast<result_underlying_type>(detail::underlying_value(*this)) ^ static_cast<result_underlying_type>(detail::underlying_value(rhs))));
         }
 
         /**
          * Performs a bit-wise 'xor' assignment operation on the values of this and rhs.
-         * The types of the right-hand side must be a superset of this.
+         * The types of the right-hand side need to intersect the ones of this, and its underlying type must not be
+         * wider than the one of this, so no bit of rhs is lost.
          *
          * @tparam Us
          *      The list of types of the right-hand side shared bitfield.
          */
         template<typename... Us>
-        inline auto operator^=(shared_bitfield<Us...> rhs) -> typename std::enable_if<!std::is_same<
-                typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type, shared_enum<>>::value, shared_bitfield&>::type {
-            this->value_ ^= static_cast<underlying_type>(rhs);
+        TRAK_INLINE auto operator^=(shared_bitfield<Us...> rhs) -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>
+                && sizeof(typename shared_bitfield<Us...>::underlying_type) <= sizeof(underlying_type)), shared_bitfield&) {
+            this->value_ ^= static_cast<underlying_type>(detail::underlying_value(rhs));
             return *this;
         }
     };
 }
 
+namespace std {
+
+    /**
+     * Hashes a shared bitfield as its underlying value.
+     *
+     * @tparam Ts
+     *      The list of types of the shared bitfield.
+     */
+    template<typename... Ts>
+    struct hash<trak::shared_bitfield<Ts...>> : hash<trak::shared_enum<Ts...>> {};
+}
+
 #endif //TRAK_SHARED_BITFIELD_HPP
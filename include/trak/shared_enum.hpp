@@ -1,7 +1,104 @@
 #ifndef TRAK_SHARED_ENUM_HPP
 #define TRAK_SHARED_ENUM_HPP
 
+#include <trak/detail/type_name.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
 #include <type_traits>
+#include <utility>
+
+/**
+ * TRAK_HAS_THREE_WAY_COMPARISON is 1 if shared enums provide operator<=>, which requires C++20.
+ */
+#if defined(__cpp_impl_three_way_comparison) && __has_include(<compare>)
+#define TRAK_HAS_THREE_WAY_COMPARISON 1
+#include <compare>
+#else
+#define TRAK_HAS_THREE_WAY_COMPARISON 0
+#endif
+
+/**
+ * TRAK_HAS_CONCEPTS is 1 if the constraints of shared enums are concepts, which requires C++20. Otherwise, they
+ * are boolean variable templates checked with std::enable_if.
+ */
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+#define TRAK_HAS_CONCEPTS 1
+#else
+#define TRAK_HAS_CONCEPTS 0
+#endif
+
+/**
+ * Declares the trailing return type of a function template which only participates in overload resolution if the
+ * parenthesized condition holds. With concepts, the condition is a requires-clause, so the return type is only
+ * formed for satisfied constraints.
+ */
+#if TRAK_HAS_CONCEPTS
+#define TRAK_RETURN_IF(condition, ...) __VA_ARGS__ requires condition
+#else
+#define TRAK_RETURN_IF(condition, ...) typename std::enable_if<condition, __VA_ARGS__>::type
+#endif
+
+/**
+ * TRAK_CANONICAL_ORDER selects the order of the types of the shared enums formed by intersect_shared_enum, and so of
+ * the results of the shared bitfield operators. If 0, the order of the left-hand side is preserved. If 1, the
+ * result is canonical_shared_enum_t of the intersection, such that equal sets of types collapse to one type. It
+ * needs to be defined equally in all translation units of a program.
+ */
+#ifndef TRAK_CANONICAL_ORDER
+#define TRAK_CANONICAL_ORDER 0
+#endif
+
+/**
+ * TRAK_INSTRUMENT enables counting the conversions of shared enums to their types and their equality comparisons
+ * per enum type and value, reported by instrument_report of trak/instrumentation.hpp. If 0, the default, the
+ * instrumentation compiles away. It needs to be defined equally in all translation units of a program.
+ */
+#ifndef TRAK_INSTRUMENT
+#define TRAK_INSTRUMENT 0
+#endif
+
+/**
+ * Records an instrumentation event of the enum value, unless the enclosing function is constant evaluated.
+ */
+#if TRAK_INSTRUMENT
+#if defined(__cpp_lib_is_constant_evaluated)
+#define TRAK_INSTRUMENT_EVENT(event, value) \
+    (std::is_constant_evaluated() ? void() : ::trak::detail::instrument(::trak::detail::instrument_event::event, value))
+#else
+#define TRAK_INSTRUMENT_EVENT(event, value) \
+    (__builtin_is_constant_evaluated() ? void() : ::trak::detail::instrument(::trak::detail::instrument_event::event, value))
+#endif
+#else
+#define TRAK_INSTRUMENT_EVENT(event, value) static_cast<void>(0)
+#endif
+
+/**
+ * TRAK_DEBUG_INLINE forces the members and operators of shared enums and shared bitfields to be inlined, also
+ * without optimizations, so conversions and comparisons compile to the same instructions as those of raw enums at
+ * -O0 and -Og instead of chains of calls. The inlined functions are marked artificial, so debuggers step over them
+ * and attribute their code to the calling line. If 0, the default, they are plain inline functions.
+ */
+#ifndef TRAK_DEBUG_INLINE
+#define TRAK_DEBUG_INLINE 0
+#endif
+
+/**
+ * The inline specifier of the hot functions of shared enums, forcing inlining if TRAK_DEBUG_INLINE is set.
+ */
+#if TRAK_DEBUG_INLINE && defined(__GNUC__)
+#if defined(__has_attribute) && __has_attribute(artificial)
+#define TRAK_INLINE __attribute__((always_inline, artificial)) inline
+#else
+#define TRAK_INLINE __attribute__((always_inline)) inline
+#endif
+#elif TRAK_DEBUG_INLINE && defined(_MSC_VER)
+#define TRAK_INLINE __forceinline
+#else
+#define TRAK_INLINE inline
+#endif
 
 namespace trak {
 
@@ -19,36 +116,280 @@ namespace trak {
      * Checks whether U is a member of a shared enum. Provides the member constant value which is
      * equal to \c true if U is in the list of types Ts. Otherwise, value is \c false.
      *
-     * This declaration breaks the recursive definition is_member_of_shared_enum::value.
+     * The membership test is a single fold over Ts and does not recurse on the list tail.
      *
      * @tparam U
      *      The type to test for membership.
      * @tparam Ts
-     *      The tail of the list of shared enum types.
+     *      The list of shared enum types.
      */
     template<typename U, typename... Ts>
-    struct is_member_of_shared_enum {
-        static const bool value = false;
-    };
+    struct is_member_of_shared_enum : std::integral_constant<bool, (std::is_same<U, Ts>::value || ...)> {};
 
+#if TRAK_HAS_CONCEPTS
     /**
-     * Checks whether U is a member of a shared enum. Provides the member constant value which is
-     * equal to \c true if U is the same as T or in the list of types Ts. Otherwise, value is \c false.
-     *
-     * The membership test is done using a recursive definition of value on the list tail Ts.
+     * Satisfied if U is in the list of types Ts.
+     */
+    template<typename U, typename... Ts>
+    concept shared_enum_member = (std::is_same_v<U, Ts> || ...);
+#else
+    /**
+     * \c true if U is in the list of types Ts. Otherwise, \c false.
+     */
+    template<typename U, typename... Ts>
+    inline constexpr bool shared_enum_member = (std::is_same<U, Ts>::value || ...);
+#endif
+
+    namespace detail {
+
+        /**
+         * Checks whether the shared enums L and R have a type in common, without forming their intersection.
+         */
+        template<typename L, typename R>
+        struct shared_enums_intersect : std::false_type {};
+
+        template<typename... Ts, typename... Us>
+        struct shared_enums_intersect<shared_enum<Ts...>, shared_enum<Us...>>
+                : std::integral_constant<bool, (shared_enum_member<Ts, Us...> || ...)> {};
+    }
+
+#if TRAK_HAS_CONCEPTS
+    /**
+     * Satisfied if the shared enums L and R have a type in common.
+     */
+    template<typename L, typename R>
+    concept intersecting_shared_enums = detail::shared_enums_intersect<L, R>::value;
+#else
+    /**
+     * \c true if the shared enums L and R have a type in common. Otherwise, \c false.
+     */
+    template<typename L, typename R>
+    inline constexpr bool intersecting_shared_enums = detail::shared_enums_intersect<L, R>::value;
+#endif
+
+    namespace detail {
+
+        /**
+         * The kinds of events counted by the instrumentation.
+         */
+        enum class instrument_event : unsigned char {
+            conversion,
+            comparison
+        };
+
+        /**
+         * Counts the event for the enum value. Defined in trak/instrumentation.hpp.
+         */
+        template<typename E>
+        void instrument(instrument_event event, E value) noexcept;
+
+        /**
+         * Returns the index of the first of the types Ts being a type of the shared enum R.
+         */
+        template<typename R, typename... Ts>
+        constexpr std::size_t first_common_index() noexcept {
+            constexpr bool common[] = {intersecting_shared_enums<shared_enum<Ts>, R>...};
+            std::size_t i = 0;
+            while (!common[i]) {
+                ++i;
+            }
+            return i;
+        }
+    }
+
+    namespace detail {
+
+        /**
+         * Leaf of indexed_types, associating the index I with the type T.
+         */
+        template<std::size_t I, typename T>
+        struct indexed_type {
+            using type = T;
+        };
+
+        /**
+         * Invalid specification.
+         */
+        template<typename, typename...>
+        struct indexed_types;
+
+        /**
+         * Inherits an indexed_type leaf for each type of Ts, such that the type at an index can be
+         * looked up by overload resolution instead of recursion.
+         */
+        template<std::size_t... Is, typename... Ts>
+        struct indexed_types<std::index_sequence<Is...>, Ts...> : indexed_type<Is, Ts>... {};
+
+        template<std::size_t I, typename T>
+        indexed_type<I, T> select_indexed_type(const indexed_type<I, T>&);
+
+        /**
+         * The type at index I of the list of types Ts.
+         */
+        template<std::size_t I, typename... Ts>
+        using type_at_t = typename decltype(select_indexed_type<I>(
+                std::declval<indexed_types<std::index_sequence_for<Ts...>, Ts...>>()))::type;
+
+        /**
+         * Provides the static member array values, holding the indices of all \c true flags in Keep.
+         */
+        template<bool... Keep>
+        struct kept_indices {
+            static constexpr std::size_t size = (std::size_t{Keep} + ... + 0);
+
+            static constexpr std::array<std::size_t, size> make() noexcept {
+                std::array<std::size_t, size> result{};
+                constexpr bool keep[] = {Keep...};
+                std::size_t n = 0;
+                for (std::size_t i = 0; i < sizeof...(Keep); ++i) {
+                    if (keep[i]) {
+                        result[n++] = i;
+                    }
+                }
+                return result;
+            }
+
+            static constexpr std::array<std::size_t, size> values = make();
+        };
+
+        /**
+         * Invalid specification.
+         */
+        template<typename, typename, typename...>
+        struct select_shared_enum;
+
+        template<typename... Ts>
+        std::true_type is_shared_enum_test(const shared_enum<Ts...>*);
+
+        std::false_type is_shared_enum_test(const void*);
+
+        /**
+         * Checks whether T is a shared enum or derived from a shared enum. Provides the member constant
+         * value which is equal to \c true if so. Otherwise, value is \c false.
+         */
+        template<typename T>
+        struct is_shared_enum : decltype(is_shared_enum_test(static_cast<const T*>(nullptr))) {};
+
+        template<typename... Ts>
+        shared_enum<Ts...> shared_enum_of_test(const shared_enum<Ts...>*);
+
+        /**
+         * The shared enum T is or is derived from.
+         */
+        template<typename T>
+        using shared_enum_of_t = decltype(shared_enum_of_test(static_cast<const T*>(nullptr)));
+
+        /**
+         * Provides public member typedef type, being the shared enum of the types of Ts at Indices::values.
+         */
+        template<typename Indices, std::size_t... Is, typename... Ts>
+        struct select_shared_enum<Indices, std::index_sequence<Is...>, Ts...> {
+            using type = shared_enum<type_at_t<Indices::values[Is], Ts...>...>;
+        };
+
+        /**
+         * Returns the index of the first occurrence of T in the list of types Ts, which needs to contain T.
+         */
+        template<typename T, typename... Ts>
+        constexpr std::size_t first_index_of() noexcept {
+            constexpr bool same[] = {std::is_same<T, Ts>::value...};
+            std::size_t i = 0;
+            while (!same[i]) {
+                ++i;
+            }
+            return i;
+        }
+
+        /**
+         * The first size of values are indices into a list of types.
+         */
+        template<std::size_t N>
+        struct type_indices {
+            std::array<std::size_t, N> values{};
+            std::size_t size = 0;
+        };
+
+        /**
+         * Returns the indices of the first occurrences of the types Ts, sorted by the qualified names of the types.
+         */
+        template<typename... Ts, std::size_t... Is>
+        constexpr type_indices<sizeof...(Ts)> sort_type_indices(std::index_sequence<Is...>) noexcept {
+            constexpr std::array<std::string_view, sizeof...(Ts)> names{{type_name<Ts>()...}};
+            constexpr std::array<bool, sizeof...(Ts)> first{{(first_index_of<Ts, Ts...>() == Is)...}};
+            type_indices<sizeof...(Ts)> sorted;
+            for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+                if (!first[i]) {
+                    continue;
+                }
+                auto k = sorted.size++;
+                for (; k > 0 && names[i] < names[sorted.values[k - 1]]; --k) {
+                    sorted.values[k] = sorted.values[k - 1];
+                }
+                sorted.values[k] = i;
+            }
+            return sorted;
+        }
+
+        /**
+         * Provides the static member array values, holding the indices of the canonical order of the types Ts.
+         */
+        template<typename... Ts>
+        struct canonical_indices {
+            static constexpr type_indices<sizeof...(Ts)> sorted = sort_type_indices<Ts...>(std::index_sequence_for<Ts...>{});
+            static constexpr std::size_t size = sorted.size;
+
+            static constexpr std::array<std::size_t, size> make() noexcept {
+                std::array<std::size_t, size> result{};
+                for (std::size_t i = 0; i < size; ++i) {
+                    result[i] = sorted.values[i];
+                }
+                return result;
+            }
+
+            static constexpr std::array<std::size_t, size> values = make();
+        };
+    }
+
+    /**
+     * Provides public member typedef type, being the shared enum of the types Ts in canonical order: duplicates
+     * are removed and the types are sorted by their qualified names. Shared enums of equal sets of types have the
+     * same canonical shared enum, independent of the order the types are listed in.
      *
-     * @tparam U
-     *      The type to test for membership.
-     * @tparam T
-     *      The head of the list of shared enum types.
      * @tparam Ts
-     *      The tail of the list of shared enum types.
+     *      The list of types of the shared enum.
      */
-    template<typename U, typename T, typename... Ts>
-    struct is_member_of_shared_enum<U, T, Ts...> {
-        static const bool value = std::conditional<std::is_same<U, T>::value, std::true_type, is_member_of_shared_enum<U, Ts...>>::type::value;
+    template<typename... Ts>
+    struct canonical_shared_enum {
+    private:
+        using indices = detail::canonical_indices<Ts...>;
+
+    public:
+        using type = typename detail::select_shared_enum<indices, std::make_index_sequence<indices::size>, Ts...>::type;
+    };
+
+    template<>
+    struct canonical_shared_enum<> {
+        using type = shared_enum<>;
     };
 
+    /**
+     * The shared enum of the types Ts in canonical order.
+     */
+    template<typename... Ts>
+    using canonical_shared_enum_t = typename canonical_shared_enum<Ts...>::type;
+
+    namespace detail {
+
+        /**
+         * Provides public member typedef type, being the canonical shared enum of the shared enum T.
+         */
+        template<typename T>
+        struct canonical_shared_enum_of {};
+
+        template<typename... Ts>
+        struct canonical_shared_enum_of<shared_enum<Ts...>> : canonical_shared_enum<Ts...> {};
+    }
+
     /**
      * Invalid specification.
      */
@@ -78,6 +419,11 @@ namespace trak {
 
     /**
      * Intersects shared enum types and provides public typedef type equal to a shared enum of the intersection.
+     * The order of the types of the first list is preserved, unless TRAK_CANONICAL_ORDER is 1, in which case the
+     * intersection is in canonical order.
+     *
+     * The intersection is computed with constant template depth: the membership of each type is folded
+     * once, and the kept types are selected by index.
      *
      * @tparam T
      *      The head of the first list of shared enum types.
@@ -88,11 +434,152 @@ namespace trak {
      */
     template<typename T, typename... Ts, typename... Us>
     struct intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>> {
-        using type = typename std::conditional<is_member_of_shared_enum<T, Us...>::value,
-                typename prepend_to_shared_enum<T, typename intersect_shared_enum<shared_enum<Ts...>, shared_enum<Us...>>::type>::type,
-                typename intersect_shared_enum<shared_enum<Ts...>, shared_enum<Us...>>::type>::type;
+    private:
+        using indices = detail::kept_indices<is_member_of_shared_enum<T, Us...>::value,
+                is_member_of_shared_enum<Ts, Us...>::value...>;
+
+        using ordered_type = typename detail::select_shared_enum<indices, std::make_index_sequence<indices::size>, T, Ts...>::type;
+
+    public:
+#if TRAK_CANONICAL_ORDER
+        using type = typename detail::canonical_shared_enum_of<ordered_type>::type;
+#else
+        using type = ordered_type;
+#endif
     };
 
+    namespace detail {
+
+        /**
+         * Returns the index of the narrowest of the integer types Us, preferring unsigned types of equal width and
+         * then the first one.
+         */
+        template<typename... Us>
+        constexpr std::size_t narrowest_index() noexcept {
+            constexpr std::size_t sizes[] = {sizeof(Us)...};
+            constexpr bool signs[] = {std::is_signed<Us>::value...};
+            std::size_t index = 0;
+            for (std::size_t i = 1; i < sizeof...(Us); ++i) {
+                if (sizes[i] < sizes[index] || (sizes[i] == sizes[index] && signs[index] && !signs[i])) {
+                    index = i;
+                }
+            }
+            return index;
+        }
+
+        /**
+         * The range of values representable by each of the integer types Us, being the intersection of their ranges.
+         */
+        template<typename... Us>
+        struct common_value_range {
+            static constexpr long long min = [] {
+                long long min = std::numeric_limits<long long>::min();
+                for (auto value : {(std::is_signed<Us>::value ? static_cast<long long>(std::numeric_limits<Us>::min()) : 0ll)...}) {
+                    min = value > min ? value : min;
+                }
+                return min;
+            }();
+
+            static constexpr unsigned long long max = [] {
+                unsigned long long max = std::numeric_limits<unsigned long long>::max();
+                for (auto value : {static_cast<unsigned long long>(std::numeric_limits<Us>::max())...}) {
+                    max = value < max ? value : max;
+                }
+                return max;
+            }();
+
+            /**
+             * Returns \c true if value of the integer type V is in the range.
+             */
+            template<typename V>
+            static constexpr bool contains(V value) noexcept {
+                if constexpr (std::is_signed<V>::value) {
+                    return value < 0 ? static_cast<long long>(value) >= min : static_cast<unsigned long long>(value) <= max;
+                } else {
+                    return static_cast<unsigned long long>(value) <= max;
+                }
+            }
+        };
+
+        /**
+         * The type storing the value of a shared enum of the enums Ts, being the narrowest of their underlying types.
+         * The values valid for each of Ts are the intersection of the ranges of their underlying types, which is
+         * included in the range of the narrowest one.
+         */
+        template<typename... Ts>
+        using shared_storage_t = type_at_t<narrowest_index<typename std::underlying_type<Ts>::type...>(),
+                typename std::underlying_type<Ts>::type...>;
+
+        /**
+         * Called if the value of a shared enum does not fit one of its types. Being no constexpr function, it
+         * stops the constant evaluation of such a value.
+         */
+        inline void shared_enum_value_out_of_range() noexcept {}
+
+        /**
+         * Returns the underlying value of the enum or shared enum value.
+         */
+        template<typename T>
+        constexpr TRAK_INLINE auto underlying_value(const T& value) noexcept {
+            if constexpr (std::is_enum<T>::value) {
+                return static_cast<typename std::underlying_type<T>::type>(value);
+            } else {
+                return static_cast<typename T::underlying_type>(value);
+            }
+        }
+
+        /**
+         * Returns \c true if the integers lhs and rhs are equal, comparing values of different signedness without
+         * loss like std::cmp_equal. Values narrower than long long are compared as long long in a single comparison.
+         */
+        template<typename L, typename R>
+        constexpr TRAK_INLINE bool underlying_equal(L lhs, R rhs) noexcept {
+            if constexpr (std::is_signed<L>::value == std::is_signed<R>::value) {
+                return lhs == rhs;
+            } else if constexpr (sizeof(L) < sizeof(long long) && sizeof(R) < sizeof(long long)) {
+                return static_cast<long long>(lhs) == static_cast<long long>(rhs);
+            } else if constexpr (std::is_signed<L>::value) {
+                return lhs >= 0 && static_cast<typename std::make_unsigned<L>::type>(lhs) == rhs;
+            } else {
+                return rhs >= 0 && lhs == static_cast<typename std::make_unsigned<R>::type>(rhs);
+            }
+        }
+
+        /**
+         * Returns \c true if the integer lhs is less than rhs, comparing values of different signedness without
+         * loss like std::cmp_less. Values narrower than long long are compared as long long in a single comparison.
+         */
+        template<typename L, typename R>
+        constexpr TRAK_INLINE bool underlying_less(L lhs, R rhs) noexcept {
+            if constexpr (std::is_signed<L>::value == std::is_signed<R>::value) {
+                return lhs < rhs;
+            } else if constexpr (sizeof(L) < sizeof(long long) && sizeof(R) < sizeof(long long)) {
+                return static_cast<long long>(lhs) < static_cast<long long>(rhs);
+            } else if constexpr (std::is_signed<L>::value) {
+                return lhs < 0 || static_cast<typename std::make_unsigned<L>::type>(lhs) < rhs;
+            } else {
+                return rhs >= 0 && lhs < static_cast<typename std::make_unsigned<R>::type>(rhs);
+            }
+        }
+
+#if TRAK_HAS_THREE_WAY_COMPARISON
+        /**
+         * Returns the ordering of the integers lhs and rhs, comparing values of different signedness without loss.
+         */
+        template<typename L, typename R>
+        constexpr TRAK_INLINE std::strong_ordering underlying_order(L lhs, R rhs) noexcept {
+            if constexpr (std::is_signed<L>::value == std::is_signed<R>::value) {
+                return lhs <=> rhs;
+            } else if constexpr (sizeof(L) < sizeof(long long) && sizeof(R) < sizeof(long long)) {
+                return static_cast<long long>(lhs) <=> static_cast<long long>(rhs);
+            } else {
+                return underlying_less(lhs, rhs) ? std::strong_ordering::less
+                        : underlying_equal(lhs, rhs) ? std::strong_ordering::equal : std::strong_ordering::greater;
+            }
+        }
+#endif
+    }
+
     /**
      * Base of shared enums containing the actual enum value.
      *
@@ -106,7 +593,7 @@ namespace trak {
          * @param value
          *      The value of the shared enum.
          */
-        constexpr inline explicit shared_enum_base(T value) noexcept : value_(value) {}
+        constexpr TRAK_INLINE explicit shared_enum_base(T value) noexcept : value_(value) {}
 
         /**
          * Cast operator to the underlying type.
@@ -114,7 +601,7 @@ namespace trak {
          * @return
          *      The enum value.
          */
-        constexpr inline explicit operator T() const noexcept {
+        constexpr TRAK_INLINE explicit operator T() const noexcept {
             return value_;
         };
 
@@ -130,16 +617,24 @@ namespace trak {
 
     /**
      * Represents an enum value being a member of multiple enums.
-     * The value is implicitly convertible to T.
+     * The value is implicitly convertible to T and each type of Ts.
+     *
+     * All conversion operators are generated from the pack by a single constrained conversion template,
+     * so a shared enum is one class independent of the number of its types.
      *
      * @tparam T
-     *      The valid enum type of this shared enum.
+     *      The head of the valid types of the shared enum.
+     * @tparam Ts
+     *      The tail of the valid types of the shared enum.
      */
-    template<typename T>
-    class shared_enum<T> : public shared_enum_base<typename std::underlying_type<T>::type> {
-        static_assert(std::is_enum<T>::value, "T is not an enum");
+    template<typename T, typename... Ts>
+    class shared_enum<T, Ts...> : public shared_enum_base<detail::shared_storage_t<T, Ts...>> {
+        static_assert((std::is_enum<T>::value && ... && std::is_enum<Ts>::value), "T is not an enum");
     public:
-        using underlying_type = typename std::underlying_type<T>::type;
+        /**
+         * The type storing the value, being the narrowest of the underlying types of T and Ts.
+         */
+        using underlying_type = detail::shared_storage_t<T, Ts...>;
 
         /**
          * Constructor
@@ -149,29 +644,47 @@ namespace trak {
          * @param value
          *      The value of this shared enum.
          */
-        template<typename U>
-        constexpr inline shared_enum(U value) noexcept
-                : shared_enum_base<underlying_type>(static_cast<underlying_type>(value)) {
-            static_assert(is_member_of_shared_enum<U, T>::value, "U is not a member of shared enum");
+        template<typename U, typename std::enable_if<!detail::is_shared_enum<U>::value, int>::type = 0>
+        constexpr TRAK_INLINE shared_enum(U value) noexcept
+                : shared_enum_base<underlying_type>(checked_value(value)) {
+            static_assert(is_member_of_shared_enum<U, T, Ts...>::value, "U is not a member of shared enum");
         }
 
         /**
          * Constructor
          *
+         * Converts a shared enum whose types are a superset of the types of this shared enum.
+         *
+         * @tparam Us
+         *      The list of types of the shared enum to convert.
          * @param value
          *      The value of this shared enum.
          */
-        constexpr inline explicit shared_enum(underlying_type value) noexcept
+        template<typename... Us, typename std::enable_if<(shared_enum_member<T, Us...> && ... && shared_enum_member<Ts, Us...>), int>::type = 0>
+        constexpr TRAK_INLINE shared_enum(const shared_enum<Us...>& value) noexcept
+                : shared_enum_base<underlying_type>(static_cast<underlying_type>(detail::underlying_value(value))) {}
+
+        /**
+         * Constructor
+         *
+         * @param value
+         *      The value of this shared enum.
+         */
+        constexpr TRAK_INLINE explicit shared_enum(underlying_type value) noexcept
                 : shared_enum_base<underlying_type>(value) {}
 
         /**
-         * Cast operator allowing for implicit conversion to T.
+         * Cast operator allowing for implicit conversion to each valid type of the shared enum.
          *
+         * @tparam U
+         *      The valid type to convert to.
          * @return
-         *      The enum value as T.
+         *      The enum value as U.
          */
-        constexpr inline operator T() const noexcept {
-            return static_cast<T>(this->value_);
+        template<typename U, typename std::enable_if<(shared_enum_member<U, T, Ts...>), int>::type = 0>
+        constexpr TRAK_INLINE operator U() const noexcept {
+            TRAK_INSTRUMENT_EVENT(conversion, static_cast<U>(this->value_));
+            return static_cast<U>(this->value_);
         }
 
         /**
@@ -185,9 +698,9 @@ namespace trak {
          *      \c true if equal. Otherwise, \c false.
          */
         template<typename... Us>
-        constexpr inline auto operator==(shared_enum<Us...> rhs) const -> typename std::enable_if<!std::is_same<
-                typename intersect_shared_enum<shared_enum<T>, shared_enum<Us...>>::type, shared_enum<>>::value, bool>::type {
-            return static_cast<underlying_type>(*this) == static_cast<underlying_type>(rhs);
+        constexpr TRAK_INLINE auto operator==(shared_enum<Us...> rhs) const -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>), bool) {
+            TRAK_INSTRUMENT_EVENT(comparison, (static_cast<detail::type_at_t<detail::first_common_index<shared_enum<Us...>, T, Ts...>(), T, Ts...>>(this->value_)));
+            return detail::underlying_equal(this->value_, detail::underlying_value(rhs));
         }
 
         /**
@@ -201,88 +714,312 @@ namespace trak {
          *      \c true of equal. Otherwise, \c false.
          */
         template<typename U>
-        constexpr inline auto operator==(U rhs) const -> typename std::enable_if<is_member_of_shared_enum<U, T>::value, bool>::type {
-            return static_cast<underlying_type>(*this) == static_cast<underlying_type>(rhs);
+        constexpr TRAK_INLINE auto operator==(U rhs) const -> TRAK_RETURN_IF((shared_enum_member<U, T, Ts...>), bool) {
+            TRAK_INSTRUMENT_EVENT(comparison, rhs);
+            return detail::underlying_equal(this->value_, detail::underlying_value(rhs));
+        }
+
+    private:
+        /**
+         * Returns the underlying value of value of the type U. If U is wider than the value range of the shared
+         * enum, values outside of it do not compile in constant expressions.
+         */
+        template<typename U>
+        static constexpr TRAK_INLINE underlying_type checked_value(U value) noexcept {
+            using range = detail::common_value_range<typename std::underlying_type<T>::type, typename std::underlying_type<Ts>::type...>;
+            const auto raw = detail::underlying_value(value);
+            if constexpr (range::min > static_cast<long long>(std::numeric_limits<decltype(raw)>::min())
+                    || range::max < static_cast<unsigned long long>(std::numeric_limits<decltype(raw)>::max())) {
+                if (!range::contains(raw)) {
+                    detail::shared_enum_value_out_of_range();
+                }
+            }
+            return static_cast<underlying_type>(raw);
         }
     };
 
     /**
-     * Represents an enum value being a member of multiple enums.
-     * The value is implicitly convertible to T.
+     * Returns \c true if the left-hand side value is equal to this enum value. Otherwise, return \c false.
      *
-     * @tparam T
-     *      The head of the valid types of the shared enum.
+     * @tparam U
+     *      The type of the left-hand side value.
      * @tparam Ts
-     *      The tail of the valid types of the shared enum.
+     *      The list of types of the right-hand side shared_enum.
+     * @param lhs
+     *      The value to compare against.
+     * @param rhs
+     *      The shared_enum to compare.
+     * @return
+     *      \c true of equal. Otherwise, \c false.
      */
-    template<typename T, typename... Ts>
-    class shared_enum<T, Ts...> : public shared_enum<Ts...> {
-        static_assert(std::is_enum<T>::value, "T is not an enum");
-    public:
-        using underlying_type = typename shared_enum<Ts...>::underlying_type;
+    template<typename U, typename... Ts>
+    constexpr TRAK_INLINE auto operator==(U lhs, const shared_enum<Ts...>& rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        TRAK_INSTRUMENT_EVENT(comparison, lhs);
+        return detail::underlying_equal(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
 
-        /**
-         * Constructor
-         *
-         * @tparam U
-         *      The parameter type of value which is implicitly convertible to the underlying type of T.
-         * @param value
-         *      The value of this shared enum.
-         */
-        template<typename U>
-        constexpr inline shared_enum(U value) noexcept : shared_enum<Ts...>(static_cast<underlying_type>(value)) {
-            static_assert(is_member_of_shared_enum<U, T, Ts...>::value, "U is not a member of shared enum");
-        }
+    /**
+     * Returns \c true if the left-hand side value is not equal to the right-hand side value. Otherwise, returns \c false.
+     * Shared enums are ordered by their underlying value, and the types of both sides need to intersect.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam Us
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename... Ts, typename... Us>
+    constexpr TRAK_INLINE auto operator!=(const shared_enum<Ts...>& lhs, const shared_enum<Us...>& rhs) -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), bool) {
+        TRAK_INSTRUMENT_EVENT(comparison, (static_cast<detail::type_at_t<detail::first_common_index<shared_enum<Us...>, Ts...>(), Ts...>>(detail::underlying_value(lhs))));
+        return !detail::underlying_equal(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
 
-        /**
-         * Constructor
-         *
-         * @param value
-         *      The value of this shared enum.
-         */
-        constexpr inline explicit shared_enum(underlying_type value) noexcept : shared_enum<Ts...>(value) {}
+    /**
+     * Returns \c true if the left-hand side shared_enum is not equal to the right-hand side value. Otherwise,
+     * returns \c false.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam U
+     *      The type of the right-hand side value, being a type of the shared_enum.
+     */
+    template<typename... Ts, typename U>
+    constexpr TRAK_INLINE auto operator!=(const shared_enum<Ts...>& lhs, U rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        TRAK_INSTRUMENT_EVENT(comparison, rhs);
+        return !detail::underlying_equal(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
 
-        /**
-         * Cast operator allowing for implicit conversion to T.
-         *
-         * @return
-         *      The enum value as T.
-         */
-        constexpr inline operator T() const noexcept {
-            return static_cast<T>(this->value_);
-        }
+    /**
+     * Returns \c true if the left-hand side value is not equal to the right-hand side shared_enum. Otherwise,
+     * returns \c false.
+     *
+     * @tparam U
+     *      The type of the left-hand side value, being a type of the shared_enum.
+     * @tparam Ts
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename U, typename... Ts>
+    constexpr TRAK_INLINE auto operator!=(U lhs, const shared_enum<Ts...>& rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        TRAK_INSTRUMENT_EVENT(comparison, lhs);
+        return !detail::underlying_equal(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
 
-        /**
-         * Returns \c true if this enum value is equal to the right-hand side value. Otherwise, return \c false.
-         *
-         * @tparam Us
-         *      The list of types of the right-hand side shared_enum.
-         * @param rhs
-         *      The shared_enum to compare against.
-         * @return
-         *      \c true if equal. Otherwise, \c false.
-         */
-        template<typename... Us>
-        constexpr inline auto operator==(shared_enum<Us...> rhs) const -> typename std::enable_if<!std::is_same<
-                typename intersect_shared_enum<shared_enum<T, Ts...>, shared_enum<Us...>>::type, shared_enum<>>::value, bool>::type {
-            return static_cast<underlying_type>(*this) == static_cast<underlying_type>(rhs);
-        }
+    /**
+     * Returns \c true if the left-hand side value is less than the right-hand side value. Otherwise, returns \c false.
+     * Shared enums are ordered by their underlying value, and the types of both sides need to intersect.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam Us
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename... Ts, typename... Us>
+    constexpr TRAK_INLINE auto operator<(const shared_enum<Ts...>& lhs, const shared_enum<Us...>& rhs) -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), bool) {
+        return detail::underlying_less(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
 
-        /**
-         * Returns \c true if this enum value is equal to the right-hand side value. Otherwise, return \c false.
-         *
-         * @tparam U
-         *      The type of the right-hand side value.
-         * @param rhs
-         *      The value to compare against.
-         * @return
-         *      \c true of equal. Otherwise, \c false.
-         */
-        template<typename U>
-        constexpr inline auto operator==(U rhs) const -> typename std::enable_if<is_member_of_shared_enum<U, T, Ts...>::value, bool>::type {
-            return static_cast<underlying_type>(*this) == static_cast<underlying_type>(rhs);
+    /**
+     * Returns \c true if the left-hand side shared_enum is less than the right-hand side value. Otherwise,
+     * returns \c false.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam U
+     *      The type of the right-hand side value, being a type of the shared_enum.
+     */
+    template<typename... Ts, typename U>
+    constexpr TRAK_INLINE auto operator<(const shared_enum<Ts...>& lhs, U rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        return detail::underlying_less(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side value is less than the right-hand side shared_enum. Otherwise,
+     * returns \c false.
+     *
+     * @tparam U
+     *      The type of the left-hand side value, being a type of the shared_enum.
+     * @tparam Ts
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename U, typename... Ts>
+    constexpr TRAK_INLINE auto operator<(U lhs, const shared_enum<Ts...>& rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        return detail::underlying_less(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side value is less than or equal to the right-hand side value. Otherwise, returns \c false.
+     * Shared enums are ordered by their underlying value, and the types of both sides need to intersect.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam Us
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename... Ts, typename... Us>
+    constexpr TRAK_INLINE auto operator<=(const shared_enum<Ts...>& lhs, const shared_enum<Us...>& rhs) -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), bool) {
+        return !detail::underlying_less(detail::underlying_value(rhs), detail::underlying_value(lhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side shared_enum is less than or equal to the right-hand side value. Otherwise,
+     * returns \c false.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam U
+     *      The type of the right-hand side value, being a type of the shared_enum.
+     */
+    template<typename... Ts, typename U>
+    constexpr TRAK_INLINE auto operator<=(const shared_enum<Ts...>& lhs, U rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        return !detail::underlying_less(detail::underlying_value(rhs), detail::underlying_value(lhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side value is less than or equal to the right-hand side shared_enum. Otherwise,
+     * returns \c false.
+     *
+     * @tparam U
+     *      The type of the left-hand side value, being a type of the shared_enum.
+     * @tparam Ts
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename U, typename... Ts>
+    constexpr TRAK_INLINE auto operator<=(U lhs, const shared_enum<Ts...>& rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        return !detail::underlying_less(detail::underlying_value(rhs), detail::underlying_value(lhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side value is greater than the right-hand side value. Otherwise, returns \c false.
+     * Shared enums are ordered by their underlying value, and the types of both sides need to intersect.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam Us
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename... Ts, typename... Us>
+    constexpr TRAK_INLINE auto operator>(const shared_enum<Ts...>& lhs, const shared_enum<Us...>& rhs) -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), bool) {
+        return detail::underlying_less(detail::underlying_value(rhs), detail::underlying_value(lhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side shared_enum is greater than the right-hand side value. Otherwise,
+     * returns \c false.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam U
+     *      The type of the right-hand side value, being a type of the shared_enum.
+     */
+    template<typename... Ts, typename U>
+    constexpr TRAK_INLINE auto operator>(const shared_enum<Ts...>& lhs, U rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        return detail::underlying_less(detail::underlying_value(rhs), detail::underlying_value(lhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side value is greater than the right-hand side shared_enum. Otherwise,
+     * returns \c false.
+     *
+     * @tparam U
+     *      The type of the left-hand side value, being a type of the shared_enum.
+     * @tparam Ts
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename U, typename... Ts>
+    constexpr TRAK_INLINE auto operator>(U lhs, const shared_enum<Ts...>& rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        return detail::underlying_less(detail::underlying_value(rhs), detail::underlying_value(lhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side value is greater than or equal to the right-hand side value. Otherwise, returns \c false.
+     * Shared enums are ordered by their underlying value, and the types of both sides need to intersect.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam Us
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename... Ts, typename... Us>
+    constexpr TRAK_INLINE auto operator>=(const shared_enum<Ts...>& lhs, const shared_enum<Us...>& rhs) -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), bool) {
+        return !detail::underlying_less(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side shared_enum is greater than or equal to the right-hand side value. Otherwise,
+     * returns \c false.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam U
+     *      The type of the right-hand side value, being a type of the shared_enum.
+     */
+    template<typename... Ts, typename U>
+    constexpr TRAK_INLINE auto operator>=(const shared_enum<Ts...>& lhs, U rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        return !detail::underlying_less(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
+
+    /**
+     * Returns \c true if the left-hand side value is greater than or equal to the right-hand side shared_enum. Otherwise,
+     * returns \c false.
+     *
+     * @tparam U
+     *      The type of the left-hand side value, being a type of the shared_enum.
+     * @tparam Ts
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename U, typename... Ts>
+    constexpr TRAK_INLINE auto operator>=(U lhs, const shared_enum<Ts...>& rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), bool) {
+        return !detail::underlying_less(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
+
+#if TRAK_HAS_THREE_WAY_COMPARISON
+    /**
+     * Compares shared enums by their underlying value. The types of both sides need to intersect.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam Us
+     *      The list of types of the right-hand side shared_enum.
+     */
+    template<typename... Ts, typename... Us>
+    constexpr TRAK_INLINE auto operator<=>(const shared_enum<Ts...>& lhs, const shared_enum<Us...>& rhs) -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<Ts...>, shared_enum<Us...>>), std::strong_ordering) {
+        return detail::underlying_order(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
+
+    /**
+     * Compares a shared enum and a value of one of its types by their underlying value. The reversed comparison
+     * is synthesized by the compiler.
+     *
+     * @tparam Ts
+     *      The list of types of the left-hand side shared_enum.
+     * @tparam U
+     *      The type of the right-hand side value, being a type of the shared_enum.
+     */
+    template<typename... Ts, typename U>
+    constexpr TRAK_INLINE auto operator<=>(const shared_enum<Ts...>& lhs, U rhs) -> TRAK_RETURN_IF((shared_enum_member<U, Ts...>), std::strong_ordering) {
+        return detail::underlying_order(detail::underlying_value(lhs), detail::underlying_value(rhs));
+    }
+#endif
+}
+
+namespace std {
+
+    /**
+     * Hashes a shared enum as its underlying value.
+     *
+     * @tparam Ts
+     *      The list of types of the shared enum.
+     */
+    template<typename... Ts>
+    struct hash<trak::shared_enum<Ts...>> {
+        std::size_t operator()(const trak::shared_enum<Ts...>& value) const noexcept {
+            using underlying_type = typename trak::shared_enum<Ts...>::underlying_type;
+            return std::hash<underlying_type>{}(static_cast<underlying_type>(value));
         }
     };
 }
 
+#if TRAK_INSTRUMENT
+#include <trak/instrumentation.hpp>
+#endif
+
 #endif //TRAK_SHARED_ENUM_HPP
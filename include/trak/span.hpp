@@ -0,0 +1,106 @@
+#ifndef TRAK_SPAN_HPP
+#define TRAK_SPAN_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace trak {
+
+    /**
+     * A non-owning view of a contiguous sequence of T, as a minimal C++17 replacement of std::span with
+     * dynamic extent.
+     *
+     * @tparam T
+     *      The element type, which may be const.
+     */
+    template<typename T>
+    class span {
+    public:
+        using element_type = T;
+        using value_type = typename std::remove_cv<T>::type;
+        using size_type = std::size_t;
+        using pointer = T*;
+        using reference = T&;
+        using iterator = T*;
+
+        constexpr inline span() noexcept = default;
+
+        /**
+         * @param data
+         *      The first element.
+         * @param size
+         *      The number of elements.
+         */
+        constexpr inline span(T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+        /**
+         * @param array
+         *      The array to view.
+         */
+        template<std::size_t N>
+        constexpr inline span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+        /**
+         * @tparam Container
+         *      A contiguous container, such as std::vector or std::array, whose elements are convertible to T.
+         * @param container
+         *      The container to view.
+         */
+        template<typename Container, typename std::enable_if<!std::is_array<Container>::value && std::is_convertible<
+                typename std::remove_pointer<decltype(std::data(std::declval<Container&>()))>::type(*)[], T(*)[]>::value, int>::type = 0>
+        constexpr inline span(Container& container) noexcept : data_(std::data(container)), size_(std::size(container)) {}
+
+        /**
+         * @tparam U
+         *      The element type of other, such that span<U> is convertible to span<const U>.
+         * @param other
+         *      The span to view.
+         */
+        template<typename U, typename std::enable_if<!std::is_same<U, T>::value && std::is_convertible<U(*)[], T(*)[]>::value, int>::type = 0>
+        constexpr inline span(const span<U>& other) noexcept : data_(other.data()), size_(other.size()) {}
+
+        constexpr inline T* data() const noexcept {
+            return data_;
+        }
+
+        constexpr inline std::size_t size() const noexcept {
+            return size_;
+        }
+
+        constexpr inline bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        constexpr inline T& operator[](std::size_t index) const noexcept {
+            return data_[index];
+        }
+
+        constexpr inline T* begin() const noexcept {
+            return data_;
+        }
+
+        constexpr inline T* end() const noexcept {
+            return data_ + size_;
+        }
+
+        /**
+         * Returns the view of count elements starting at offset.
+         */
+        constexpr inline span subspan(std::size_t offset, std::size_t count) const noexcept {
+            return span(data_ + offset, count);
+        }
+
+    private:
+        T* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    template<typename T, std::size_t N>
+    span(T (&)[N]) -> span<T>;
+
+    template<typename Container>
+    span(Container&) -> span<typename std::remove_pointer<decltype(std::data(std::declval<Container&>()))>::type>;
+}
+
+#endif //TRAK_SPAN_HPP
@@ -0,0 +1,372 @@
+#ifndef TRAK_WIDE_SHARED_BITFIELD_HPP
+#define TRAK_WIDE_SHARED_BITFIELD_HPP
+
+#include <trak/detail/bitfield_kernels.hpp>
+#include <trak/detail/bits.hpp>
+#include <trak/shared_enum.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace trak {
+
+    /**
+     * Represents a set of N flags being member of multiple flag enums, for flag sets exceeding the 64 bits of an
+     * integral bitfield. The enumerators of the types Ts are the indices of their flags, rather than masks.
+     * Like shared_bitfield, the operators of wide shared bitfields with intersecting types return the wide
+     * shared bitfield of the intersection.
+     *
+     * The flags are stored in an array of 64-bit words. The bit-wise operators and any are loops over the words,
+     * which the compiler vectorizes and unrolls for the known number of words, and which are faster than calling
+     * the bitfield kernels for each value. count uses the bitfield kernels of the widest instruction set supported
+     * by the executing CPU, once a bitfield fills a vector of 256 bits.
+     *
+     * @tparam N
+     *      The number of flags.
+     * @tparam Ts
+     *      List of flag enums this bitfield is a member of.
+     */
+    template<std::size_t N, typename... Ts>
+    class wide_shared_bitfield;
+
+    namespace detail {
+
+        /**
+         * The number of words of wide shared bitfields from which count uses the bitfield kernels.
+         */
+        constexpr std::size_t wide_bitfield_count_kernel_words = 4;
+
+        template<std::size_t N, typename>
+        struct shared_enum_to_wide_bitfield {};
+
+        template<std::size_t N, typename... Ts>
+        struct shared_enum_to_wide_bitfield<N, shared_enum<Ts...>> {
+            using type = wide_shared_bitfield<N, Ts...>;
+        };
+
+        /**
+         * The wide shared bitfield of N flags of the intersection of the types of shared_enum<Ts...> and
+         * shared_enum<Us...>.
+         */
+        template<std::size_t N, typename L, typename R>
+        using wide_intersection_t = typename shared_enum_to_wide_bitfield<N, typename intersect_shared_enum<L, R>::type>::type;
+
+        /**
+         * Called if a flag is no index below N. Being no constexpr function, it stops the constant evaluation of
+         * such a flag.
+         */
+        inline void wide_flag_out_of_range() noexcept {}
+    }
+
+    /**
+     * Invalid specification.
+     */
+    template<std::size_t N>
+    class wide_shared_bitfield<N> {};
+
+    /**
+     * Represents a set of N flags being member of multiple flag enums.
+     *
+     * @tparam N
+     *      The number of flags.
+     * @tparam T
+     *      The head of the valid types of the wide shared bitfield.
+     * @tparam Ts
+     *      The tail of the valid types of the wide shared bitfield.
+     */
+    template<std::size_t N, typename T, typename... Ts>
+    class wide_shared_bitfield<N, T, Ts...> {
+        static_assert((std::is_enum<T>::value && ... && std::is_enum<Ts>::value), "T is not an enum");
+        static_assert(N > 0, "Wide bitfields need at least one flag");
+    public:
+        using word_type = std::uint64_t;
+
+        /**
+         * The number of words storing the flags.
+         */
+        static constexpr std::size_t words = (N + 63) / 64;
+
+        /**
+         * Constructs a bitfield without flags set.
+         */
+        constexpr wide_shared_bitfield() noexcept = default;
+
+        /**
+         * Constructor
+         *
+         * Constructs a bitfield with the single flag set whose index is the value of flag.
+         *
+         * @tparam U
+         *      The type of flag, being one of the types of the wide shared bitfield.
+         * @param flag
+         *      The flag to set.
+         */
+        template<typename U, typename std::enable_if<(shared_enum_member<U, T, Ts...>), int>::type = 0>
+        constexpr wide_shared_bitfield(U flag) noexcept {
+            set_bit(index_of(flag));
+        }
+
+        /**
+         * Constructor
+         *
+         * Converts a wide shared bitfield whose types are a superset of the types of this wide shared bitfield.
+         *
+         * @tparam Us
+         *      The list of types of the wide shared bitfield to convert.
+         * @param value
+         *      The value of this wide shared bitfield.
+         */
+        template<typename... Us, typename std::enable_if<(shared_enum_member<T, Us...> && ... && shared_enum_member<Ts, Us...>), int>::type = 0>
+        constexpr wide_shared_bitfield(const wide_shared_bitfield<N, Us...>& value) noexcept : words_(value.data()) {}
+
+        /**
+         * Returns the words storing the flags, the flag with index i being bit i % 64 of word i / 64. The bits of
+         * the last word above N are zero.
+         */
+        constexpr const std::array<word_type, words>& data() const noexcept {
+            return words_;
+        }
+
+        /**
+         * Returns the number of flags.
+         */
+        static constexpr std::size_t size() noexcept {
+            return N;
+        }
+
+        /**
+         * Returns \c true if flag is set. Otherwise, returns \c false.
+         */
+        template<typename U>
+        constexpr auto test(U flag) const noexcept -> TRAK_RETURN_IF((shared_enum_member<U, T, Ts...>), bool) {
+            const auto index = index_of(flag);
+            return index < N && ((words_[index / 64] >> (index % 64)) & 1u) != 0;
+        }
+
+        /**
+         * Sets flag.
+         */
+        template<typename U>
+        constexpr auto set(U flag) noexcept -> TRAK_RETURN_IF((shared_enum_member<U, T, Ts...>), wide_shared_bitfield&) {
+            set_bit(index_of(flag));
+            return *this;
+        }
+
+        /**
+         * Clears flag.
+         */
+        template<typename U>
+        constexpr auto reset(U flag) noexcept -> TRAK_RETURN_IF((shared_enum_member<U, T, Ts...>), wide_shared_bitfield&) {
+            const auto index = index_of(flag);
+            if (index < N) {
+                words_[index / 64] &= ~(word_type{1} << (index % 64));
+            }
+            return *this;
+        }
+
+        /**
+         * Returns \c true if any flag is set. Otherwise, returns \c false.
+         */
+        constexpr bool any() const noexcept {
+            word_type result = 0;
+            for (std::size_t i = 0; i < words; ++i) {
+                result |= words_[i];
+            }
+            return result != 0;
+        }
+
+        /**
+         * Returns \c true if no flag is set. Otherwise, returns \c false.
+         */
+        constexpr bool none() const noexcept {
+            return !any();
+        }
+
+        /**
+         * Returns the number of flags set.
+         */
+        inline std::size_t count() const noexcept {
+            if constexpr (words >= detail::wide_bitfield_count_kernel_words) {
+                return detail::active_bitfield_kernels().count(reinterpret_cast<const unsigned char*>(words_.data()), sizeof(words_));
+            } else {
+                std::size_t result = 0;
+                for (std::size_t i = 0; i < words; ++i) {
+                    result += detail::popcount64(words_[i]);
+                }
+                return result;
+            }
+        }
+
+        /**
+         * Performs a bit-wise 'or' assignment operation on the flags of this and rhs.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side wide shared bitfield.
+         */
+        template<typename... Us>
+        constexpr auto operator|=(const wide_shared_bitfield<N, Us...>& rhs) noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>), wide_shared_bitfield&) {
+            for (std::size_t i = 0; i < words; ++i) {
+                words_[i] |= rhs.data()[i];
+            }
+            return *this;
+        }
+
+        /**
+         * Performs a bit-wise 'and' assignment operation on the flags of this and rhs.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side wide shared bitfield.
+         */
+        template<typename... Us>
+        constexpr auto operator&=(const wide_shared_bitfield<N, Us...>& rhs) noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>), wide_shared_bitfield&) {
+            for (std::size_t i = 0; i < words; ++i) {
+                words_[i] &= rhs.data()[i];
+            }
+            return *this;
+        }
+
+        /**
+         * Performs a bit-wise 'xor' assignment operation on the flags of this and rhs.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side wide shared bitfield.
+         */
+        template<typename... Us>
+        constexpr auto operator^=(const wide_shared_bitfield<N, Us...>& rhs) noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>), wide_shared_bitfield&) {
+            for (std::size_t i = 0; i < words; ++i) {
+                words_[i] ^= rhs.data()[i];
+            }
+            return *this;
+        }
+
+        /**
+         * Performs a bit-wise 'or' operation on the flags of this and rhs, while constraining the shared types
+         * to the intersection.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side wide shared bitfield.
+         */
+        template<typename... Us>
+        constexpr auto operator|(const wide_shared_bitfield<N, Us...>& rhs) const noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>),
+                                  detail::wide_intersection_t<N, shared_enum<T, Ts...>, shared_enum<Us...>>) {
+            detail::wide_intersection_t<N, shared_enum<T, Ts...>, shared_enum<Us...>> result = *this;
+            result |= rhs;
+            return result;
+        }
+
+        /**
+         * Performs a bit-wise 'and' operation on the flags of this and rhs, while constraining the shared types
+         * to the intersection.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side wide shared bitfield.
+         */
+        template<typename... Us>
+        constexpr auto operator&(const wide_shared_bitfield<N, Us...>& rhs) const noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>),
+                                  detail::wide_intersection_t<N, shared_enum<T, Ts...>, shared_enum<Us...>>) {
+            detail::wide_intersection_t<N, shared_enum<T, Ts...>, shared_enum<Us...>> result = *this;
+            result &= rhs;
+            return result;
+        }
+
+        /**
+         * Performs a bit-wise 'xor' operation on the flags of this and rhs, while constraining the shared types
+         * to the intersection.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side wide shared bitfield.
+         */
+        template<typename... Us>
+        constexpr auto operator^(const wide_shared_bitfield<N, Us...>& rhs) const noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>),
+                                  detail::wide_intersection_t<N, shared_enum<T, Ts...>, shared_enum<Us...>>) {
+            detail::wide_intersection_t<N, shared_enum<T, Ts...>, shared_enum<Us...>> result = *this;
+            result ^= rhs;
+            return result;
+        }
+
+        /**
+         * Returns \c true if the flags of this and rhs are equal. Otherwise, returns \c false.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side wide shared bitfield.
+         */
+        template<typename... Us>
+        constexpr auto operator==(const wide_shared_bitfield<N, Us...>& rhs) const noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>), bool) {
+            for (std::size_t i = 0; i < words; ++i) {
+                if (words_[i] != rhs.data()[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Returns \c true if the flags of this and rhs differ. Otherwise, returns \c false.
+         *
+         * @tparam Us
+         *      The list of types of the right-hand side wide shared bitfield.
+         */
+        template<typename... Us>
+        constexpr auto operator!=(const wide_shared_bitfield<N, Us...>& rhs) const noexcept
+                -> TRAK_RETURN_IF((intersecting_shared_enums<shared_enum<T, Ts...>, shared_enum<Us...>>), bool) {
+            return !(*this == rhs);
+        }
+
+    private:
+        /**
+         * Returns the index of flag, as unsigned value.
+         */
+        template<typename U>
+        static constexpr std::size_t index_of(U flag) noexcept {
+            return static_cast<std::size_t>(static_cast<typename std::make_unsigned<typename std::underlying_type<U>::type>::type>(flag));
+        }
+
+        /**
+         * Sets the bit of index, which does not compile in constant expressions unless it is below N, and is
+         * ignored at runtime otherwise.
+         */
+        constexpr void set_bit(std::size_t index) noexcept {
+            if (index < N) {
+                words_[index / 64] |= word_type{1} << (index % 64);
+            } else {
+                detail::wide_flag_out_of_range();
+            }
+        }
+
+        std::array<word_type, words> words_{};
+    };
+}
+
+namespace std {
+
+    /**
+     * Hashes a wide shared bitfield as its words.
+     *
+     * @tparam N
+     *      The number of flags.
+     * @tparam Ts
+     *      The list of types of the wide shared bitfield.
+     */
+    template<std::size_t N, typename... Ts>
+    struct hash<trak::wide_shared_bitfield<N, Ts...>> {
+        std::size_t operator()(const trak::wide_shared_bitfield<N, Ts...>& value) const noexcept {
+            std::size_t result = 0;
+            for (auto word : value.data()) {
+                result = result * 31 + hash<std::uint64_t>()(word);
+            }
+            return result;
+        }
+    };
+}
+
+#endif //TRAK_WIDE_SHARED_BITFIELD_HPP
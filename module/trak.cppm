@@ -0,0 +1,127 @@
+module;
+
+#include <trak/atomic_shared_bitfield.hpp>
+#include <trak/bitfield_algorithm.hpp>
+#include <trak/bitfield_flags.hpp>
+#include <trak/dispatch.hpp>
+#include <trak/dynamic_shared_enum.hpp>
+#include <trak/enum_algorithm.hpp>
+#include <trak/enum_hash_indexer.hpp>
+#include <trak/enum_indexer.hpp>
+#include <trak/enum_map.hpp>
+#include <trak/enum_parse.hpp>
+#include <trak/enum_reflection.hpp>
+#include <trak/enum_set.hpp>
+#include <trak/enum_traits.hpp>
+#include <trak/instrumentation.hpp>
+#include <trak/mapped_file.hpp>
+#include <trak/packed_enum_vector.hpp>
+#include <trak/serialization.hpp>
+#include <trak/shared_bitfield.hpp>
+#include <trak/shared_enum.hpp>
+#include <trak/span.hpp>
+#include <trak/wide_shared_bitfield.hpp>
+
+/**
+ * The trak library as named module. Importing it replaces including the headers, which are parsed once when the
+ * module is built. Configuration macros such as TRAK_ENUM_RANGE_MAX or TRAK_NO_SIMD apply when building the module,
+ * not when importing it. Specializations of enum_range, enum_indexer, enum_traits and stream_type_name work as with
+ * the headers.
+ */
+export module trak;
+
+export namespace trak {
+
+    // shared_enum.hpp
+    using trak::shared_enum;
+    using trak::shared_enum_base;
+    using trak::is_member_of_shared_enum;
+    using trak::shared_enum_member;
+    using trak::intersecting_shared_enums;
+    using trak::prepend_to_shared_enum;
+    using trak::intersect_shared_enum;
+    using trak::canonical_shared_enum;
+    using trak::canonical_shared_enum_t;
+    using trak::operator==;
+    using trak::operator!=;
+    using trak::operator<;
+    using trak::operator<=;
+    using trak::operator>;
+    using trak::operator>=;
+#if TRAK_HAS_THREE_WAY_COMPARISON
+    using trak::operator<=>;
+#endif
+
+    // shared_bitfield.hpp
+    using trak::shared_bitfield;
+    using trak::shared_enum_to_bitfield;
+    using trak::canonical_shared_bitfield_t;
+
+    // enum_reflection.hpp, enum_parse.hpp, enum_traits.hpp
+    using trak::enum_range;
+    using trak::enum_reflection;
+    using trak::name_of;
+    using trak::parse;
+    using trak::enum_traits;
+    using trak::detected_enum_traits;
+    using trak::declared_enum_traits;
+    using trak::declared_flag_traits;
+    using trak::is_valid_value;
+    using trak::checked_cast;
+    using trak::validate;
+
+    // span.hpp, bitfield_algorithm.hpp, bitfield_flags.hpp, wide_shared_bitfield.hpp, atomic_shared_bitfield.hpp
+    using trak::span;
+    using trak::bitfield_or;
+    using trak::bitfield_and;
+    using trak::bitfield_xor;
+    using trak::bitfield_any;
+    using trak::bitfield_all;
+    using trak::bitfield_count;
+    using trak::bitfield_mismatch;
+    using trak::flag_range;
+    using trak::flags_of;
+    using trak::for_each_flag;
+    using trak::flag_decomposition;
+    using trak::decompose_flags;
+    using trak::wide_shared_bitfield;
+    using trak::atomic_shared_bitfield;
+
+    // enum_indexer.hpp, enum_hash_indexer.hpp, enum_map.hpp, enum_set.hpp, packed_enum_vector.hpp, enum_algorithm.hpp, dispatch.hpp
+    using trak::enum_indexer;
+    using trak::enum_range_indexer;
+    using trak::enum_hash_indexer;
+    using trak::enum_map;
+    using trak::enum_set;
+    using trak::packed_enum_vector;
+    using trak::enum_buckets;
+    using trak::counting_sort;
+    using trak::partition_by_enum;
+    using trak::dispatch;
+
+    // dynamic_shared_enum.hpp
+    using trak::dynamic_shared_enum;
+    using trak::visit;
+
+    // serialization.hpp, mapped_file.hpp
+    using trak::endian;
+    using trak::stream_error;
+    using trak::stream_header;
+    using trak::stream_type_id;
+    using trak::stream_type_name;
+    using trak::encode_stream_header;
+    using trak::decode_stream_header;
+    using trak::check_stream_header;
+    using trak::view_enum_stream;
+    using trak::enum_stream_writer;
+    using trak::enum_stream_reader;
+#if TRAK_HAS_MAPPED_FILE
+    using trak::mapped_file;
+#endif
+
+    // instrumentation.hpp
+    using trak::instrument_record;
+    using trak::instrument_report;
+    using trak::reset_instrument_counters;
+    using trak::write_instrument_report;
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <trak/atomic_shared_bitfield.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class A : std::uint32_t {
+        First = 1,
+        Second = 2,
+        Third = 4
+    };
+
+    enum class B : std::uint32_t {
+        First = 1,
+        Second = 2,
+        Third = 4
+    };
+
+    enum class C : std::uint32_t {
+        First = 1,
+        Second = 2,
+        Third = 4
+    };
+
+    enum class Narrow : std::uint8_t {
+        First = 1,
+        Second = 2,
+        Third = 4
+    };
+
+    using ab = shared_bitfield<A, B>;
+    using bc = shared_bitfield<B, C>;
+
+    template<typename T, typename U, typename = void>
+    struct can_fetch_or : std::false_type {};
+
+    template<typename T, typename U>
+    struct can_fetch_or<T, U, decltype(static_cast<void>(std::declval<T&>().fetch_or(std::declval<U>())))> : std::true_type {};
+}
+
+TEST(atomic_shared_bitfield, fetch_operations) {
+    static_assert(atomic_shared_bitfield<A, B>::is_always_lock_free);
+    static_assert(can_fetch_or<atomic_shared_bitfield<A, B>, bc>::value);
+    static_assert(!can_fetch_or<atomic_shared_bitfield<A, B>, shared_bitfield<C>>::value);
+
+    atomic_shared_bitfield<A, B> flags;
+    EXPECT_EQ(flags.load(), ab(A::First) & ab(A::Second));
+
+    EXPECT_EQ(flags.fetch_or(ab(A::First)), static_cast<ab>(0u));
+    EXPECT_EQ(flags.fetch_or(bc(B::Second), std::memory_order_relaxed), ab(A::First));
+    EXPECT_EQ(flags.fetch_and(ab(A::Second), std::memory_order_acq_rel), ab(A::First) | ab(A::Second));
+    EXPECT_EQ(flags.fetch_xor(ab(A::Third)), ab(A::Second));
+    EXPECT_EQ(flags.load(std::memory_order_acquire), ab(A::Second) | ab(A::Third));
+
+    EXPECT_EQ(flags |= bc(B::First), ab(A::First) | ab(A::Second) | ab(A::Third));
+    EXPECT_EQ(flags &= ab(A::First), ab(A::First));
+    EXPECT_EQ(flags ^= ab(A::First), static_cast<ab>(0u));
+
+    flags.store(ab(A::Third));
+    EXPECT_EQ(flags.exchange(ab(A::First)), ab(A::Third));
+    EXPECT_TRUE(flags.test(ab(A::First)));
+    EXPECT_FALSE(flags.test(ab(A::Second)));
+
+    auto expected = ab(A::Second);
+    EXPECT_FALSE(flags.compare_exchange_strong(expected, ab(A::Third)));
+    EXPECT_EQ(expected, ab(A::First));
+    EXPECT_TRUE(flags.compare_exchange_strong(expected, ab(A::Third)));
+    const ab value = flags;
+    EXPECT_EQ(value, ab(A::Third));
+}
+
+TEST(atomic_shared_bitfield, test_and_set) {
+    atomic_shared_bitfield<A, B> flags = ab(A::First);
+    EXPECT_TRUE(flags.test_and_set(ab(A::First)));
+    EXPECT_FALSE(flags.test_and_set(bc(B::Second), std::memory_order_acq_rel));
+    EXPECT_EQ(flags.load(), ab(A::First) | ab(A::Second));
+
+    EXPECT_TRUE(flags.test_and_clear(ab(A::First) | ab(A::Third)));
+    EXPECT_FALSE(flags.test_and_clear(ab(A::Third)));
+    EXPECT_EQ(flags.load(), ab(A::Second));
+}
+
+TEST(atomic_shared_bitfield, heterogeneous) {
+    using an = shared_bitfield<A, Narrow>;
+    static_assert(sizeof(atomic_shared_bitfield<A, Narrow>) == 1);
+
+    // Setting or toggling the bits of a wider bitfield would lose the ones beyond the narrow bitfield.
+    static_assert(!can_fetch_or<atomic_shared_bitfield<A, Narrow>, shared_bitfield<A>>::value);
+    static_assert(can_fetch_or<atomic_shared_bitfield<A>, an>::value);
+
+    atomic_shared_bitfield<A, Narrow> narrow;
+    EXPECT_EQ(narrow.fetch_or(an(A::First)), static_cast<an>(std::uint8_t{0}));
+    EXPECT_EQ(narrow |= an(A::Second), an(A::First) | an(A::Second));
+    EXPECT_EQ(narrow.fetch_and(shared_bitfield<A>(A::Second)), an(A::First) | an(A::Second));
+    EXPECT_EQ(narrow ^= an(A::Third), an(A::Second) | an(A::Third));
+    EXPECT_TRUE(narrow.test(shared_bitfield<A>(A::Third)));
+    EXPECT_TRUE(narrow.test_and_clear(shared_bitfield<A>(A::Second)));
+    EXPECT_FALSE(narrow.test_and_set(an(A::First)));
+    EXPECT_EQ(narrow.load(), an(A::First) | an(A::Third));
+
+    atomic_shared_bitfield<A> wide;
+    EXPECT_EQ(wide.fetch_or(an(Narrow::Second)), static_cast<shared_bitfield<A>>(0u));
+    EXPECT_EQ(wide &= an(A::Second), shared_bitfield<A>(A::Second));
+    EXPECT_TRUE(wide.test(an(Narrow::Second)));
+}
+
+TEST(atomic_shared_bitfield, concurrent_test_and_set) {
+    constexpr std::uint32_t bits = 32;
+    constexpr std::size_t thread_count = 4;
+    atomic_shared_bitfield<A, B> flags;
+    std::atomic<std::uint32_t> won{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&] {
+            for (std::uint32_t bit = 0; bit < bits; ++bit) {
+                if (!flags.test_and_set(static_cast<ab>(std::uint32_t{1} << bit))) {
+                    won.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Each flag is won by exactly one thread.
+    EXPECT_EQ(won.load(), bits);
+    EXPECT_EQ(flags.load(), static_cast<ab>(0xffffffffu));
+}
+
+#if defined(__cpp_lib_atomic_wait)
+TEST(atomic_shared_bitfield, wait_notify) {
+    atomic_shared_bitfield<A, B> flags;
+
+    std::thread producer([&] {
+        flags.fetch_or(ab(A::First));
+        flags.notify_all();
+        flags.fetch_or(bc(B::Third));
+        flags.notify_all();
+    });
+
+    const auto observed = flags.wait_any(ab(A::Third));
+    EXPECT_EQ(observed & ab(A::Third), ab(A::Third));
+    producer.join();
+
+    const auto old = flags.load();
+    std::thread consumer([&] {
+        flags.wait(old);
+    });
+    flags.fetch_xor(ab(A::Second));
+    flags.notify_one();
+    consumer.join();
+    EXPECT_EQ(flags.load(), ab(A::First) | ab(A::Second) | ab(A::Third));
+}
+#endif
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <trak/bitfield_algorithm.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class A : std::uint16_t {
+        First = 1,
+        Second = 2,
+        Third = 4,
+        High = 0x8000
+    };
+
+    enum class B : std::uint16_t {
+        First = 1,
+        Second = 2,
+        Third = 4,
+        High = 0x8000
+    };
+
+    enum class C : std::uint16_t {
+        First = 1,
+        Second = 2,
+        Third = 4,
+        High = 0x8000
+    };
+
+    enum class Narrow : std::uint8_t {
+        First = 1,
+        Second = 2,
+        Third = 4
+    };
+
+    using ab = shared_bitfield<A, B>;
+    using bc = shared_bitfield<B, C>;
+    using an = shared_bitfield<A, Narrow>;
+
+    std::vector<ab> make_bitfields(std::size_t size, unsigned int seed) {
+        std::mt19937 engine(seed);
+        std::vector<ab> values;
+        for (std::size_t i = 0; i < size; ++i) {
+            values.push_back(static_cast<ab>(static_cast<std::uint16_t>(engine())));
+        }
+        return values;
+    }
+
+    std::vector<detail::simd_level> supported_levels() {
+        std::vector<detail::simd_level> levels;
+        for (auto level : {detail::simd_level::scalar, detail::simd_level::sse2, detail::simd_level::avx2, detail::simd_level::avx512}) {
+            if (level <= detail::detect_simd_level()) {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+}
+
+TEST(bitfield_algorithm, binary) {
+    auto dst = make_bitfields(37, 1);
+    auto src = std::vector<bc>();
+    for (auto value : make_bitfields(37, 2)) {
+        src.push_back(static_cast<bc>(static_cast<std::uint16_t>(value)));
+    }
+
+    auto expected = dst;
+    for (std::size_t i = 0; i < dst.size(); ++i) {
+        expected[i] |= src[i];
+    }
+    bitfield_or(span(dst), span<const bc>(src));
+    EXPECT_EQ(expected, dst);
+
+    for (std::size_t i = 0; i < dst.size(); ++i) {
+        expected[i] &= src[i];
+    }
+    bitfield_and(span(dst), span(src));
+    EXPECT_EQ(expected, dst);
+
+    for (std::size_t i = 0; i < dst.size(); ++i) {
+        expected[i] ^= src[i];
+    }
+    bitfield_xor(span(dst), span(src));
+    EXPECT_EQ(expected, dst);
+
+    // Only the common prefix is processed.
+    auto shorter = span(src).subspan(0, 3);
+    auto before = dst;
+    bitfield_or(span(dst), shorter);
+    EXPECT_EQ(before[3], dst[3]);
+}
+
+TEST(bitfield_algorithm, reductions) {
+    std::vector<ab> values(21, ab(A::First) | ab(A::Third));
+    const bc first = B::First;
+    const bc second = B::Second;
+
+    EXPECT_TRUE(bitfield_any(span(values), first));
+    EXPECT_FALSE(bitfield_any(span(values), second));
+    EXPECT_TRUE(bitfield_all(span(values), first));
+    EXPECT_FALSE(bitfield_all(span(values), first | second));
+    EXPECT_EQ(42u, bitfield_count(span(values)));
+
+    values[20] = A::Second;
+    EXPECT_TRUE(bitfield_any(span(values), second));
+    EXPECT_FALSE(bitfield_all(span(values), first));
+
+    std::vector<ab> empty;
+    EXPECT_FALSE(bitfield_any(span(empty), first));
+    EXPECT_TRUE(bitfield_all(span(empty), first));
+    EXPECT_EQ(0u, bitfield_count(span(empty)));
+}
+
+TEST(bitfield_algorithm, mismatch) {
+    auto lhs = make_bitfields(50, 3);
+    auto rhs = lhs;
+    const ab all = static_cast<ab>(static_cast<std::uint16_t>(0xffff));
+    const ab high = A::High;
+
+    EXPECT_EQ(50u, bitfield_mismatch(span(lhs), span(rhs), all));
+    rhs[41] ^= high;
+    EXPECT_EQ(41u, bitfield_mismatch(span(lhs), span(rhs), all));
+    EXPECT_EQ(50u, bitfield_mismatch(span(lhs), span(rhs), static_cast<ab>(static_cast<std::uint16_t>(0x7fff))));
+    rhs[7] ^= high;
+    EXPECT_EQ(7u, bitfield_mismatch(span(lhs), span(rhs), high));
+}
+
+TEST(bitfield_algorithm, heterogeneous) {
+    auto wide = make_bitfields(37, 4);
+    std::vector<an> narrow;
+    for (auto value : make_bitfields(37, 5)) {
+        narrow.push_back(static_cast<an>(static_cast<std::uint8_t>(static_cast<std::uint16_t>(value))));
+    }
+
+    auto expected_wide = wide;
+    for (std::size_t i = 0; i < wide.size(); ++i) {
+        expected_wide[i] |= narrow[i];
+        expected_wide[i] ^= narrow[(i + 1) % narrow.size()];
+    }
+    std::vector<an> rotated(narrow.begin() + 1, narrow.end());
+    rotated.push_back(narrow.front());
+    bitfield_or(span(wide), span<const an>(narrow));
+    bitfield_xor(span(wide), span(rotated));
+    EXPECT_EQ(expected_wide, wide);
+
+    for (std::size_t i = 0; i < wide.size(); ++i) {
+        expected_wide[i] &= narrow[i];
+    }
+    bitfield_and(span(wide), span(narrow));
+    EXPECT_EQ(expected_wide, wide);
+
+    auto expected_narrow = narrow;
+    for (std::size_t i = 0; i < narrow.size(); ++i) {
+        expected_narrow[i] &= wide[i];
+    }
+    bitfield_and(span(narrow), span<const ab>(wide));
+    EXPECT_EQ(expected_narrow, narrow);
+
+    std::vector<ab> values(21, ab(A::First) | ab(A::High));
+    EXPECT_TRUE(bitfield_any(span(values), an(A::First)));
+    EXPECT_FALSE(bitfield_any(span(values), an(Narrow::Second)));
+    EXPECT_TRUE(bitfield_all(span(values), an(A::First)));
+
+    std::vector<an> masks(21, an(A::First));
+    EXPECT_EQ(21u, bitfield_mismatch(span(values), span(masks), an(A::First)));
+    EXPECT_EQ(0u, bitfield_mismatch(span(values), span(masks), ab(A::High)));
+    masks[13] = Narrow::Second;
+    EXPECT_EQ(13u, bitfield_mismatch(span(values), span(masks), an(A::First)));
+    EXPECT_EQ(13u, bitfield_mismatch(span(masks), span(values), ab(A::First) | ab(A::Second)));
+}
+
+TEST(bitfield_algorithm, kernels) {
+    // Every kernel supported by this CPU needs to agree with the scalar kernel, at all offsets and tails.
+    const auto& scalar = detail::bitfield_kernels_for(detail::simd_level::scalar);
+    for (auto level : supported_levels()) {
+        const auto& kernels = detail::bitfield_kernels_for(level);
+        for (std::size_t size : {0u, 1u, 7u, 8u, 31u, 64u, 129u, 300u, 1000u}) {
+            auto lhs = make_bitfields(size, static_cast<unsigned int>(size));
+            auto rhs = make_bitfields(size, static_cast<unsigned int>(size) + 1);
+            auto* l = detail::bitfield_bytes(lhs.data());
+            auto* r = detail::bitfield_bytes(rhs.data());
+            const auto bytes = size * sizeof(ab);
+
+            EXPECT_EQ(scalar.count(l, bytes), kernels.count(l, bytes));
+            for (std::uint64_t mask : {0x0001000100010001ull, 0x8000800080008000ull, 0xffffffffffffffffull}) {
+                EXPECT_EQ(scalar.any(l, bytes, mask), kernels.any(l, bytes, mask));
+                EXPECT_EQ(scalar.all(l, bytes, mask), kernels.all(l, bytes, mask));
+                EXPECT_EQ(scalar.mismatch(l, r, bytes, mask), kernels.mismatch(l, r, bytes, mask));
+                EXPECT_EQ(bytes, kernels.mismatch(l, l, bytes, mask));
+            }
+
+            auto expected = lhs;
+            scalar.bit_xor(detail::bitfield_bytes(expected.data()), r, bytes);
+            kernels.bit_xor(l, r, bytes);
+            EXPECT_EQ(expected, lhs);
+            if (size > 0) {
+                rhs = lhs;
+                rhs.back() ^= ab(A::High);
+                EXPECT_EQ(bytes - sizeof(ab) + 1, kernels.mismatch(l, detail::bitfield_bytes(rhs.data()), bytes, 0xffffffffffffffffull));
+            }
+        }
+    }
+}
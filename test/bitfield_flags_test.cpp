@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <trak/bitfield_flags.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class Access : std::uint32_t {
+        None = 0,
+        Read = 1,
+        Write = 2,
+        Execute = 8,
+        ReadWrite = 3,
+        High = 0x80000000u
+    };
+
+    enum class Mode : std::uint32_t {
+        Read = 1,
+        Append = 4
+    };
+
+    enum class Small : std::int8_t {
+        Low = 1,
+        Sign = -128
+    };
+
+    using access_bits = shared_bitfield<Access, Mode>;
+}
+
+namespace trak {
+    template<>
+    struct enum_range<Access> {
+        static constexpr long long min = 0;
+        static constexpr long long max = 0;
+        static constexpr bool flags = true;
+    };
+}
+
+TEST(bitfield_flags, range) {
+    const auto value = access_bits(std::uint32_t{0x8000000Du});
+    std::vector<std::uint32_t> bits;
+    std::vector<unsigned int> indices;
+    const auto range = flags_of(value);
+    for (auto it = range.begin(); it != range.end(); ++it) {
+        static_assert(std::is_same<decltype(*it), access_bits>::value);
+        bits.push_back(static_cast<std::uint32_t>(static_cast<Access>(*it)));
+        indices.push_back(it.bit());
+    }
+    EXPECT_EQ(bits, (std::vector<std::uint32_t>{1, 4, 8, 0x80000000u}));
+    EXPECT_EQ(indices, (std::vector<unsigned int>{0, 2, 3, 31}));
+    EXPECT_EQ(range.size(), 4u);
+    EXPECT_TRUE(flags_of(access_bits(std::uint32_t{0})).empty());
+
+    // Should yield the sign bit of signed underlying types.
+    std::size_t count = 0;
+    for (auto flag : flags_of(static_cast<Small>(-127))) {
+        EXPECT_TRUE(flag == Small::Low || flag == Small::Sign);
+        ++count;
+    }
+    EXPECT_EQ(count, 2u);
+}
+
+TEST(bitfield_flags, for_each_flag) {
+    std::uint32_t sum = 0;
+    std::size_t count = 0;
+    for_each_flag(access_bits(Access::ReadWrite) | access_bits(Mode::Append), [&](access_bits flag) {
+        sum += static_cast<std::uint32_t>(static_cast<Mode>(flag));
+        ++count;
+    });
+    EXPECT_EQ(sum, 7u);
+    EXPECT_EQ(count, 3u);
+
+    constexpr auto bits = [] {
+        std::uint32_t bits = 0;
+        for_each_flag(static_cast<Access>(10), [&](Access flag) { bits |= static_cast<std::uint32_t>(flag) << 4u; });
+        return bits;
+    }();
+    static_assert(bits == 160);
+}
+
+TEST(bitfield_flags, decompose) {
+    static_assert(detail::named_flag_mask<Access> == 0x8000000Bu);
+
+    const auto value = access_bits(std::uint32_t{0x8000001Fu});
+    const auto access = decompose_flags(value);
+    std::vector<std::string_view> names;
+    for (auto flag : access.named) {
+        names.push_back(name_of(flag));
+    }
+    EXPECT_EQ(names, (std::vector<std::string_view>{"Read", "Write", "Execute", "High"}));
+    EXPECT_EQ(access.unnamed, static_cast<Access>(0x14));
+
+    const auto mode = decompose_flags<Mode>(value);
+    EXPECT_EQ(mode.named.size(), 2u);
+    EXPECT_EQ(mode.unnamed, static_cast<Mode>(0x8000001Au));
+
+    EXPECT_TRUE(decompose_flags<Access>(Access::None).named.empty());
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <trak/shared_bitfield.hpp>
+
+#include <type_traits>
+
+using namespace trak;
+
+static_assert(TRAK_CANONICAL_ORDER == 1, "canonical_order_test requires TRAK_CANONICAL_ORDER");
+
+namespace {
+    enum class A : unsigned int {
+        First = 1,
+        Second = 2
+    };
+
+    enum class B : unsigned int {
+        First = 1,
+        Second = 2
+    };
+
+    enum class C : unsigned int {
+        First = 1,
+        Second = 2
+    };
+}
+
+TEST(canonical_order, intersection) {
+    static_assert(std::is_same<intersect_shared_enum<shared_enum<C, B, A>, shared_enum<A, B>>::type, shared_enum<A, B>>::value);
+    static_assert(std::is_same<intersect_shared_enum<shared_enum<B, A>, shared_enum<A, B, C>>::type,
+            intersect_shared_enum<shared_enum<A, B>, shared_enum<C, B, A>>::type>::value);
+    static_assert(std::is_same<intersect_shared_enum<shared_enum<A>, shared_enum<B>>::type, shared_enum<>>::value);
+}
+
+TEST(canonical_order, operators) {
+    shared_bitfield<B, A> ba = A::First;
+    shared_bitfield<A, B, C> abc = C::Second;
+    shared_bitfield<C, A, B> cab = B::Second;
+
+    // Should collapse equal sets of types to one type, independent of the order of the operands.
+    auto lhs = ba | abc;
+    auto rhs = abc & cab;
+    static_assert(std::is_same<decltype(lhs), shared_bitfield<A, B>>::value);
+    static_assert(std::is_same<decltype(rhs), shared_bitfield<A, B, C>>::value);
+    static_assert(std::is_same<decltype(cab ^ ba), decltype(ba ^ cab)>::value);
+
+    EXPECT_EQ(static_cast<unsigned int>(lhs), 3u);
+    EXPECT_EQ(static_cast<unsigned int>(rhs), 2u);
+    EXPECT_EQ(lhs, (shared_bitfield<A, B>(3u)));
+}
@@ -0,0 +1,25 @@
+# Compiles SOURCE with TRAK_DEBUG_INLINE=1 and fails if the generated assembly calls a function of trak, as all
+# members and operators of shared enums and shared bitfields need to be inlined even without optimizations.
+#
+# Arguments:
+#   COMPILER    The C++ compiler.
+#   FLAGS       The compiler flags, separated by semicolons.
+#   SOURCE      The kernel source file.
+#   OUTPUT      The file to write the assembly to.
+
+execute_process(
+        COMMAND ${COMPILER} ${FLAGS} -DTRAK_DEBUG_INLINE=1 -S -o ${OUTPUT} ${SOURCE}
+        RESULT_VARIABLE result
+        ERROR_VARIABLE error)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "Compiling the kernels failed:\n${error}")
+endif ()
+
+# Calls and branches to symbols of the namespace trak, whose mangled names contain 4trak.
+file(STRINGS ${OUTPUT} calls REGEX "^[ \t]+(call|callq|jmp|bl|b)[ \t]+[^ \t]*4trak")
+if (calls)
+    list(JOIN calls "\n" calls)
+    message(FATAL_ERROR "Calls to trak functions remain with TRAK_DEBUG_INLINE:\n${calls}\nSee ${OUTPUT}")
+endif ()
+
+message(STATUS "No calls to trak functions with TRAK_DEBUG_INLINE")
@@ -0,0 +1,76 @@
+/*
+ * Kernels whose generated code must not depend on whether shared enums or raw enums are used.
+ *
+ * The file is compiled twice, once with TRAK_CODEGEN_RAW defined and once without. Both compilations
+ * must produce the same instruction sequence for every function.
+ */
+#include <cstddef>
+#include <trak/shared_bitfield.hpp>
+
+enum class A : unsigned int {
+    First = 1,
+    Second = 2,
+    Third = 4
+};
+
+enum class B : unsigned int {
+    First = 1,
+    Second = 2,
+    Third = 4
+};
+
+#ifdef TRAK_CODEGEN_RAW
+constexpr inline A operator|(A a, A b) {
+    return static_cast<A>(static_cast<unsigned int>(a) | static_cast<unsigned int>(b));
+}
+
+constexpr inline A operator&(A a, A b) {
+    return static_cast<A>(static_cast<unsigned int>(a) & static_cast<unsigned int>(b));
+}
+
+using value_type = A;
+using flags_type = A;
+#else
+using value_type = trak::shared_enum<A, B>;
+using flags_type = trak::shared_bitfield<A, B>;
+#endif
+
+static inline unsigned int takes_A(A value) {
+    return static_cast<unsigned int>(value);
+}
+
+extern "C" A convert(value_type value) {
+    return value;
+}
+
+extern "C" unsigned int pass_through(const value_type* values, std::size_t size) {
+    unsigned int sum = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        sum += takes_A(values[i]);
+    }
+    return sum;
+}
+
+extern "C" A combine_flags(const flags_type* flags, std::size_t size) {
+    flags_type result = A::First;
+    for (std::size_t i = 0; i < size; ++i) {
+        result = result | flags[i];
+    }
+    return result;
+}
+
+extern "C" A mask_flags(flags_type lhs, flags_type rhs) {
+    return lhs & rhs;
+}
+
+extern "C" bool equals(value_type value) {
+    return value == A::Second;
+}
+
+extern "C" std::size_t count_equal(const value_type* values, std::size_t size) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        count += values[i] == A::Third;
+    }
+    return count;
+}
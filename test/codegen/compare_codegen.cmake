@@ -0,0 +1,81 @@
+# Compiles SOURCE twice, with and without TRAK_CODEGEN_RAW defined, and fails if the instruction
+# sequences of the generated assembly differ.
+#
+# Arguments:
+#   COMPILER    The C++ compiler.
+#   FLAGS       The compiler flags, separated by semicolons.
+#   SOURCE      The kernel source file.
+#   OUTPUT_DIR  The directory to write the assembly to.
+
+foreach (variant raw shared)
+    set(defines)
+    if (variant STREQUAL "raw")
+        set(defines -DTRAK_CODEGEN_RAW)
+    endif ()
+    execute_process(
+            COMMAND ${COMPILER} ${FLAGS} ${defines} -S -o ${OUTPUT_DIR}/codegen_${variant}.s ${SOURCE}
+            RESULT_VARIABLE result
+            ERROR_VARIABLE error)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "Compiling the ${variant} kernels failed:\n${error}")
+    endif ()
+
+    # Keep labels and instructions, drop assembler directives. Local labels are numbered by the
+    # compiler's internal declaration ids, so they are renumbered in order of appearance.
+    file(STRINGS ${OUTPUT_DIR}/codegen_${variant}.s lines)
+    set(${variant}_lines)
+    set(labels 0)
+    foreach (line IN LISTS lines)
+        if (NOT line MATCHES "^[A-Za-z_.$][A-Za-z0-9_.$]*:" AND NOT line MATCHES "^[ \t]+[a-z]")
+            continue()
+        endif ()
+        string(STRIP "${line}" line)
+        set(normalized "")
+        while (line MATCHES "^(.*)(\\.?L[A-Za-z_]*[0-9]+)(.*)$")
+            set(prefix "${CMAKE_MATCH_1}")
+            set(label "${CMAKE_MATCH_2}")
+            set(normalized "${CMAKE_MATCH_3}${normalized}")
+            string(MAKE_C_IDENTIFIER "${variant}${label}" key)
+            if (NOT DEFINED label_${key})
+                set(label_${key} ${labels})
+                math(EXPR labels "${labels} + 1")
+            endif ()
+            set(normalized "L${label_${key}}${normalized}")
+            set(line "${prefix}")
+        endwhile ()
+        list(APPEND ${variant}_lines "${line}${normalized}")
+    endforeach ()
+endforeach ()
+
+list(LENGTH raw_lines raw_length)
+list(LENGTH shared_lines shared_length)
+if (raw_length GREATER shared_length)
+    set(length ${raw_length})
+else ()
+    set(length ${shared_length})
+endif ()
+
+set(function "<none>")
+set(index 0)
+while (index LESS length)
+    set(raw_line "<end>")
+    set(shared_line "<end>")
+    if (index LESS raw_length)
+        list(GET raw_lines ${index} raw_line)
+    endif ()
+    if (index LESS shared_length)
+        list(GET shared_lines ${index} shared_line)
+    endif ()
+    if (raw_line MATCHES "^([A-Za-z_][A-Za-z0-9_]*):")
+        set(function ${CMAKE_MATCH_1})
+    endif ()
+    if (NOT raw_line STREQUAL shared_line)
+        message(FATAL_ERROR "Generated code of '${function}' differs from the raw enum version:\n"
+                "  raw:    ${raw_line}\n"
+                "  shared: ${shared_line}\n"
+                "See ${OUTPUT_DIR}/codegen_raw.s and ${OUTPUT_DIR}/codegen_shared.s")
+    endif ()
+    math(EXPR index "${index} + 1")
+endwhile ()
+
+message(STATUS "Generated code of ${raw_length} lines matches the raw enum version")
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <trak/dispatch.hpp>
+
+#include <string_view>
+#include <type_traits>
+
+using namespace trak;
+
+namespace {
+    enum class Dense : int {
+        First = -1,
+        Second,
+        Third,
+        Fifth = 3,
+        Sixth
+    };
+
+    enum class Sparse : unsigned int {
+        First = 1,
+        Second = 10,
+        Third = 100,
+        Fourth = 120,
+        Fifth = 127
+    };
+
+    enum class Other : int {
+        First = -1,
+        Second
+    };
+
+    /**
+     * Returns the name of the enumerator of the integral constant value, checking that it is a constant expression.
+     */
+    struct name_handler {
+        template<typename E, E V>
+        constexpr std::string_view operator()(std::integral_constant<E, V>) const noexcept {
+            constexpr auto name = name_of(V);
+            return name;
+        }
+    };
+}
+
+TEST(dispatch, strategy) {
+    EXPECT_TRUE(detail::uses_dispatch_table<Dense>::value);
+    EXPECT_FALSE(detail::uses_dispatch_table<Sparse>::value);
+    EXPECT_FALSE(detail::uses_dispatch_table<Other>::value);
+}
+
+TEST(dispatch, table) {
+    for (auto value : enum_reflection<Dense>::values) {
+        EXPECT_EQ(dispatch(value, name_handler{}), name_of(value));
+    }
+    EXPECT_EQ(dispatch(static_cast<Dense>(2), name_handler{}), "");
+    EXPECT_EQ(dispatch(static_cast<Dense>(-2), name_handler{}), "");
+    EXPECT_EQ(dispatch(static_cast<Dense>(100), name_handler{}, [](Dense value) {
+        return static_cast<int>(value) == 100 ? std::string_view("fallback") : std::string_view();
+    }), "fallback");
+    static_assert(dispatch(Dense::Fifth, name_handler{}) == "Fifth");
+}
+
+TEST(dispatch, tree) {
+    for (auto value : enum_reflection<Sparse>::values) {
+        EXPECT_EQ(dispatch(value, name_handler{}), name_of(value));
+    }
+    for (auto value : {0u, 2u, 11u, 99u, 101u, 121u, 128u}) {
+        EXPECT_EQ(dispatch(static_cast<Sparse>(value), name_handler{}), "");
+    }
+    static_assert(dispatch(Sparse::Fourth, name_handler{}) == "Fourth");
+    static_assert(dispatch(static_cast<Sparse>(5), name_handler{}, [](Sparse) { return std::string_view("none"); }) == "none");
+}
+
+TEST(dispatch, shared_enum) {
+    const shared_enum<Other, Dense> value = Dense::Second;
+    EXPECT_EQ(dispatch(value, name_handler{}), "Second");
+    EXPECT_EQ(dispatch<Dense>(value, name_handler{}), "Second");
+
+    // Handlers may return different types with a common type, or nothing.
+    auto result = dispatch(Dense::Third, [](auto constant) {
+        if constexpr (constant.value == Dense::Third) {
+            return 1.5;
+        } else {
+            return 1;
+        }
+    });
+    EXPECT_TRUE((std::is_same<decltype(result), double>::value));
+    EXPECT_EQ(result, 1.5);
+
+    int calls = 0;
+    dispatch(Sparse::First, [&](auto) {
+        ++calls;
+    });
+    dispatch(static_cast<Sparse>(3), [&](auto) {
+        ++calls;
+    });
+    EXPECT_EQ(calls, 1);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <trak/dynamic_shared_enum.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class A : std::uint32_t {
+        First,
+        Second
+    };
+
+    enum class B : std::uint32_t {
+        First,
+        Second
+    };
+
+    enum class C : std::uint16_t {
+        First,
+        Second
+    };
+
+    enum class Signed : std::int8_t {
+        Negative = -3
+    };
+
+    enum class WideSigned : std::int32_t {
+        Negative = -3
+    };
+
+    enum class Late : std::uint32_t {
+        Value = 7
+    };
+
+    struct visitor {
+        std::string operator()(A value) const {
+            return "A" + std::to_string(static_cast<unsigned int>(value));
+        }
+
+        std::string operator()(B value) const {
+            return "B" + std::to_string(static_cast<unsigned int>(value));
+        }
+
+        std::string operator()(shared_enum<A, C> value) const {
+            return "AC" + std::to_string(static_cast<unsigned int>(static_cast<A>(value)));
+        }
+    };
+}
+
+TEST(dynamic_shared_enum, layout) {
+    static_assert(sizeof(dynamic_shared_enum) == 8);
+    static_assert(std::is_trivially_copyable<dynamic_shared_enum>::value);
+
+    dynamic_shared_enum empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.is<A>());
+    EXPECT_TRUE(empty.type_name().empty());
+}
+
+TEST(dynamic_shared_enum, as) {
+    dynamic_shared_enum value = A::Second;
+    EXPECT_FALSE(value.empty());
+    EXPECT_EQ(value.as<A>(), A::Second);
+    EXPECT_FALSE(value.as<B>().has_value());
+    EXPECT_EQ(value.type_name().substr(value.type_name().size() - 1), "A");
+
+    // Should honour the conversions of shared enums.
+    EXPECT_EQ((value.as<shared_enum<A, B>>()), A::Second);
+    EXPECT_FALSE((value.as<shared_enum<B, C>>().has_value()));
+
+    dynamic_shared_enum shared = shared_enum<A, B, C>(B::Second);
+    EXPECT_EQ(shared.as<A>(), A::Second);
+    EXPECT_EQ(shared.as<C>(), C::Second);
+    EXPECT_EQ((shared.as<shared_enum<C, A>>()), C::Second);
+    EXPECT_EQ((shared.as<shared_bitfield<A, B>>()), B::Second);
+    EXPECT_FALSE(shared.as<Signed>().has_value());
+    EXPECT_FALSE(dynamic_shared_enum(shared_enum<A, B>(A::First)).is<C>());
+
+    dynamic_shared_enum negative = Signed::Negative;
+    EXPECT_EQ(negative.raw(), 0xfffffffdu);
+    EXPECT_EQ(negative.as<Signed>(), Signed::Negative);
+
+    // The shared enum stores the narrowest type, so its negative values are read as the wider type sign-extended.
+    dynamic_shared_enum mixed = shared_enum<Signed, WideSigned>(Signed::Negative);
+    EXPECT_EQ(mixed.as<WideSigned>(), WideSigned::Negative);
+    EXPECT_EQ(mixed.as<Signed>(), Signed::Negative);
+    EXPECT_EQ((mixed.as<shared_enum<WideSigned, Signed>>()), WideSigned::Negative);
+}
+
+TEST(dynamic_shared_enum, compare) {
+    EXPECT_EQ(dynamic_shared_enum(A::First), dynamic_shared_enum(A::First));
+    EXPECT_NE(dynamic_shared_enum(A::First), dynamic_shared_enum(B::First));
+    EXPECT_NE(dynamic_shared_enum(A::First), dynamic_shared_enum(A::Second));
+
+    std::unordered_set<dynamic_shared_enum> set{A::First, B::First, shared_enum<A, B>(A::First)};
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_EQ(set.count(B::First), 1u);
+}
+
+TEST(dynamic_shared_enum, visit) {
+    const std::vector<dynamic_shared_enum> values{A::First, B::Second, shared_enum<C, A>(C::Second), shared_enum<B, A>(A::Second),
+                                                  C::First, dynamic_shared_enum()};
+    std::vector<std::string> visited;
+    for (const auto& value : values) {
+        visited.push_back(visit<A, B, shared_enum<A, C>>(value, visitor{}, [](dynamic_shared_enum) { return std::string("?"); }));
+    }
+    EXPECT_EQ(visited, (std::vector<std::string>{"A0", "B1", "A1", "A1", "AC0", "?"}));
+
+    // Should find types registered after the first visit.
+    EXPECT_EQ((visit<Late, A>(Late::Value, [](auto value) { return static_cast<std::uint32_t>(value); })), 7u);
+    EXPECT_EQ((visit<B>(C::Second, [](B value) { return static_cast<int>(value) + 1; })), 0);
+}
+
+TEST(dynamic_shared_enum, threads) {
+    std::vector<std::thread> threads;
+    std::vector<int> results(4);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&results, i] {
+            for (int k = 0; k < 1000; ++k) {
+                const dynamic_shared_enum value = k % 2 == 0 ? dynamic_shared_enum(A::Second) : dynamic_shared_enum(B::First);
+                results[i] += visit<B, A>(value, [](auto v) { return static_cast<int>(v) + 1; });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto result : results) {
+        EXPECT_EQ(result, 1500);
+    }
+}
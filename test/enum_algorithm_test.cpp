@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <trak/enum_algorithm.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class A : unsigned int {
+        First,
+        Second,
+        Third,
+        Fourth
+    };
+
+    enum class B : unsigned int {
+        First,
+        Second,
+        Third
+    };
+
+    using shared = shared_enum<A, B>;
+
+    struct command {
+        shared state;
+        int order;
+    };
+
+    std::vector<command> make_commands(std::size_t size) {
+        std::mt19937 engine(1);
+        std::vector<command> commands;
+        for (std::size_t i = 0; i < size; ++i) {
+            commands.push_back({static_cast<A>(engine() % 4), static_cast<int>(i)});
+        }
+        return commands;
+    }
+}
+
+TEST(enum_algorithm, counting_sort) {
+    auto commands = make_commands(1000);
+    auto expected = commands;
+    std::stable_sort(expected.begin(), expected.end(), [](const command& lhs, const command& rhs) {
+        return lhs.state < rhs.state;
+    });
+
+    const auto buckets = counting_sort(commands.begin(), commands.end(), [](const command& value) {
+        return value.state;
+    });
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        ASSERT_EQ(commands[i].state, expected[i].state);
+        ASSERT_EQ(commands[i].order, expected[i].order);
+    }
+
+    std::size_t offset = 0;
+    for (auto key : {A::First, A::Second, A::Third, A::Fourth}) {
+        EXPECT_EQ(buckets.first(key), offset);
+        offset = buckets.last(key);
+        for (auto i = buckets.first(key); i < buckets.last(key); ++i) {
+            EXPECT_EQ(commands[i].state, key);
+        }
+    }
+    EXPECT_EQ(buckets.unindexed(), commands.size());
+    EXPECT_EQ(buckets.count(shared(B::Second)), buckets.count(A::Second));
+}
+
+TEST(enum_algorithm, counting_sort_values) {
+    std::vector<A> values{A::Third, static_cast<A>(100), A::First, A::Third, A::Second};
+    const auto buckets = counting_sort(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<A>{A::First, A::Second, A::Third, A::Third, static_cast<A>(100)}));
+    EXPECT_EQ(buckets.count(A::Third), 2u);
+    EXPECT_EQ(buckets.count(A::Fourth), 0u);
+    EXPECT_EQ(buckets.unindexed(), 4u);
+}
+
+TEST(enum_algorithm, counting_sort_move_only) {
+    std::vector<std::unique_ptr<A>> values;
+    for (auto value : {A::Second, A::First, A::Second, A::First}) {
+        values.push_back(std::make_unique<A>(value));
+    }
+    const auto* first = values[1].get();
+    counting_sort(values.begin(), values.end(), [](const std::unique_ptr<A>& value) {
+        return *value;
+    });
+    EXPECT_EQ(values[0].get(), first);
+    EXPECT_EQ(*values[1], A::First);
+    EXPECT_EQ(*values[2], A::Second);
+}
+
+TEST(enum_algorithm, partition_by_enum) {
+    auto commands = make_commands(1000);
+    commands.push_back({static_cast<A>(7), -1});
+
+    const auto buckets = partition_by_enum(commands.begin(), commands.end(), [](const command& value) {
+        return value.state;
+    });
+    EXPECT_TRUE(std::is_sorted(commands.begin(), commands.end() - 1, [](const command& lhs, const command& rhs) {
+        return lhs.state < rhs.state;
+    }));
+    EXPECT_EQ(commands.back().order, -1);
+    EXPECT_EQ(buckets.unindexed(), 1000u);
+    EXPECT_EQ(buckets.count(A::First) + buckets.count(A::Second) + buckets.count(A::Third) + buckets.count(A::Fourth), 1000u);
+    EXPECT_EQ(buckets.first(A::Second), buckets.last(A::First));
+
+    std::vector<shared> values{B::Third, A::First, B::Second, A::First};
+    partition_by_enum(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<shared>{A::First, A::First, A::Second, A::Third}));
+}
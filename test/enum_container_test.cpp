@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <trak/enum_map.hpp>
+#include <trak/enum_set.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class A : std::uint8_t {
+        First = 3,
+        Second = 4,
+        Fourth = 6,
+        Last = 70
+    };
+
+    enum class B : std::uint8_t {
+        First = 3,
+        Second = 4,
+        Third = 5
+    };
+
+    enum class Signed : int {
+        Negative = -2,
+        Zero = 0,
+        Positive = 2
+    };
+
+    constexpr inline shared_enum<A, B> Shared = A::Second;
+}
+
+TEST(enum_map, indexing) {
+    static_assert(enum_map<A, int>::size() == 68);
+    static_assert(enum_map<Signed, int>::size() == 5);
+    static_assert(enum_map<A, int>::contains(A::First));
+    static_assert(enum_map<A, int>::contains(static_cast<A>(5)));
+    static_assert(!enum_map<A, int>::contains(static_cast<A>(2)));
+    static_assert(!enum_map<A, int>::contains(static_cast<A>(71)));
+    static_assert(enum_map<Signed, int>::key_at(0) == Signed::Negative);
+    static_assert(enum_map<Signed, int>::key_at(4) == Signed::Positive);
+    static_assert(!enum_map<Signed, int>::contains(static_cast<Signed>(-3)));
+}
+
+TEST(enum_map, access) {
+    enum_map<A, std::string> map;
+    map[A::First] = "first";
+    map[Shared] += "shared";
+    map[A::Last] = "last";
+
+    EXPECT_EQ(map[A::First], "first");
+    EXPECT_EQ(map[A::Second], "shared");
+    EXPECT_EQ(map[A::Fourth], "");
+    EXPECT_EQ(*map.find(A::Last), "last");
+    EXPECT_EQ(map.find(static_cast<A>(0)), nullptr);
+
+    const auto& const_map = map;
+    EXPECT_EQ(const_map[Shared], "shared");
+    EXPECT_EQ(const_map.find(static_cast<A>(200)), nullptr);
+
+    std::size_t filled = 0;
+    for (const auto& value : map) {
+        filled += !value.empty();
+    }
+    EXPECT_EQ(filled, 3u);
+
+    map.fill("all");
+    EXPECT_EQ(map[static_cast<A>(50)], "all");
+}
+
+TEST(enum_map, constexpr_map) {
+    constexpr auto map = [] {
+        enum_map<Signed, int> map;
+        map[Signed::Negative] = -1;
+        map[Signed::Positive] = 1;
+        return map;
+    }();
+    static_assert(map[Signed::Negative] == -1);
+    static_assert(map[Signed::Zero] == 0);
+    static_assert(map[Signed::Positive] == 1);
+}
+
+TEST(enum_set, modify) {
+    enum_set<A> set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert(A::First));
+    EXPECT_FALSE(set.insert(A::First));
+    EXPECT_TRUE(set.insert(Shared));
+    EXPECT_TRUE(set.insert(A::Last));
+    EXPECT_FALSE(set.insert(static_cast<A>(100)));
+    EXPECT_EQ(set.size(), 3u);
+
+    EXPECT_TRUE(set.contains(A::Second));
+    EXPECT_FALSE(set.contains(A::Fourth));
+    EXPECT_FALSE(set.contains(static_cast<A>(100)));
+
+    EXPECT_TRUE(set.erase(A::First));
+    EXPECT_FALSE(set.erase(A::First));
+    EXPECT_FALSE(set.erase(static_cast<A>(100)));
+    EXPECT_EQ(set.size(), 2u);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(enum_set, iterate) {
+    const enum_set<A> set{A::Last, A::First, A::Fourth};
+    EXPECT_EQ(std::vector<A>(set.begin(), set.end()), (std::vector<A>{A::First, A::Fourth, A::Last}));
+    EXPECT_EQ(enum_set<A>().begin(), enum_set<A>().end());
+
+    const enum_set<Signed> signed_set{Signed::Positive, Signed::Negative};
+    EXPECT_EQ(std::vector<Signed>(signed_set.begin(), signed_set.end()), (std::vector<Signed>{Signed::Negative, Signed::Positive}));
+}
+
+TEST(enum_set, operators) {
+    constexpr enum_set<A> lhs{A::First, A::Second};
+    constexpr enum_set<A> rhs{A::Second, A::Last};
+    static_assert((lhs | rhs) == enum_set<A>{A::First, A::Second, A::Last});
+    static_assert((lhs & rhs) == enum_set<A>{A::Second});
+    static_assert((lhs - rhs) == enum_set<A>{A::First});
+    static_assert(lhs != rhs);
+    static_assert(lhs.contains(A::First) && !lhs.contains(A::Last));
+    static_assert(enum_set<A>::capacity() == 68);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <trak/enum_hash_indexer.hpp>
+#include <trak/enum_map.hpp>
+#include <trak/enum_set.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class Sparse : std::uint32_t {
+        One = 0x1,
+        Vertex = 0x8B31,
+        Fragment = 0x8B30,
+        Compute = 0x91B9,
+        High = 0xFFFF0000
+    };
+
+    enum class Signed : int {
+        Low = -100000,
+        Minus = -1,
+        High = 1 << 30
+    };
+
+    enum class Program : std::uint32_t {
+        Fragment = 0x8B30,
+        Linked = 0x8B82
+    };
+
+    enum class Shader : std::uint16_t {
+        Fragment = 0x8B30,
+        Compiled = 0x8B81
+    };
+
+    enum class Wide : std::uint64_t {
+        Fragment = 0x8B30,
+        Huge = 0x100000000
+    };
+
+    enum class Small : std::uint8_t {
+        Low = 0x7,
+        Fragment = 0x30
+    };
+
+    enum class Negative : std::int8_t {
+        Minus = -1,
+        Low = 0x7
+    };
+
+    enum class Empty : std::uint8_t {};
+}
+
+template<>
+struct trak::enum_traits<Sparse> : declared_enum_traits<Sparse, Sparse::One, Sparse::Vertex, Sparse::Fragment, Sparse::Compute, Sparse::High> {};
+
+template<>
+struct trak::enum_traits<Signed> : declared_enum_traits<Signed, Signed::Low, Signed::Minus, Signed::High> {};
+
+template<>
+struct trak::enum_traits<Program> : declared_enum_traits<Program, Program::Fragment, Program::Linked> {};
+
+template<>
+struct trak::enum_traits<Shader> : declared_enum_traits<Shader, Shader::Fragment, Shader::Compiled> {};
+
+template<>
+struct trak::enum_traits<Wide> : declared_enum_traits<Wide, Wide::Fragment, Wide::Huge> {};
+
+template<>
+struct trak::enum_traits<Small> : declared_enum_traits<Small, Small::Low, Small::Fragment> {};
+
+template<>
+struct trak::enum_traits<Negative> : declared_enum_traits<Negative, Negative::Minus, Negative::Low> {};
+
+template<>
+struct trak::enum_indexer<Sparse> : enum_hash_indexer<Sparse> {};
+
+template<>
+struct trak::enum_indexer<Program> : enum_hash_indexer<shared_enum<Program, Shader>> {};
+
+TEST(enum_hash_indexer, indexing) {
+    using indexer = enum_hash_indexer<Sparse>;
+    static_assert(indexer::size == 5);
+    static_assert(indexer::index(Sparse::One) == 0);
+    static_assert(indexer::index(Sparse::Fragment) == 1);
+    static_assert(indexer::index(Sparse::Vertex) == 2);
+    static_assert(indexer::index(Sparse::Compute) == 3);
+    static_assert(indexer::index(Sparse::High) == 4);
+    static_assert(indexer::index(static_cast<Sparse>(0)) == indexer::size);
+    static_assert(indexer::index(static_cast<Sparse>(0x8B32)) == indexer::size);
+    static_assert(indexer::value(2) == Sparse::Vertex);
+
+    for (std::size_t i = 0; i < indexer::size; ++i) {
+        EXPECT_EQ(indexer::index(indexer::value(i)), i);
+    }
+    for (std::uint32_t raw = 0; raw < 0x10000; ++raw) {
+        const auto index = indexer::index(static_cast<Sparse>(raw));
+        EXPECT_TRUE(index == indexer::size || indexer::value(index) == static_cast<Sparse>(raw));
+    }
+}
+
+TEST(enum_hash_indexer, signed_values) {
+    using indexer = enum_hash_indexer<Signed>;
+    static_assert(indexer::size == 3);
+    static_assert(indexer::index(Signed::Low) == 0);
+    static_assert(indexer::index(Signed::Minus) == 1);
+    static_assert(indexer::index(Signed::High) == 2);
+    static_assert(indexer::index(static_cast<Signed>(0)) == indexer::size);
+    static_assert(indexer::index(static_cast<Signed>(-2)) == indexer::size);
+}
+
+TEST(enum_hash_indexer, shared_enum_union) {
+    using indexer = enum_hash_indexer<shared_enum<Program, Shader>>;
+    static_assert(std::is_same<indexer::enum_type, Program>::value);
+    static_assert(indexer::size == 3);
+    static_assert(indexer::index(Program::Fragment) == 0);
+    static_assert(indexer::index(Shader::Fragment) == 0);
+    static_assert(indexer::index(shared_enum<Program, Shader>(Program::Fragment)) == 0);
+    static_assert(indexer::index(Shader::Compiled) == 1);
+    static_assert(indexer::index(Program::Linked) == 2);
+    static_assert(indexer::index(static_cast<Shader>(0x8B82)) == 2);
+    static_assert(indexer::index(static_cast<Shader>(0x8B83)) == indexer::size);
+    static_assert(indexer::value(1) == static_cast<Program>(0x8B81));
+
+    using wide = enum_hash_indexer<shared_enum<Wide, Program>>;
+    static_assert(wide::size == 3);
+    static_assert(wide::index(Program::Fragment) == 0);
+    static_assert(wide::index(Wide::Huge) == 2);
+}
+
+TEST(enum_hash_indexer, shared_enum_order) {
+    // The values of all types are keyed by a type representing each of them, whichever type comes first.
+    using narrow_first = enum_hash_indexer<shared_enum<Small, Shader>>;
+    using wide_first = enum_hash_indexer<shared_enum<Shader, Small>>;
+    static_assert(narrow_first::size == 4 && wide_first::size == 4);
+    static_assert(narrow_first::index(Small::Fragment) == 1 && wide_first::index(Small::Fragment) == 1);
+    static_assert(narrow_first::index(Shader::Compiled) == 3 && wide_first::index(Shader::Compiled) == 3);
+    static_assert(narrow_first::index(static_cast<Shader>(0x130)) == narrow_first::size);
+    static_assert(wide_first::value(3) == Shader::Compiled);
+
+    using signed_first = enum_hash_indexer<shared_enum<Negative, Shader>>;
+    using unsigned_first = enum_hash_indexer<shared_enum<Shader, Negative>>;
+    static_assert(signed_first::size == 4 && unsigned_first::size == 4);
+    static_assert(signed_first::index(Negative::Minus) == 0 && unsigned_first::index(Negative::Minus) == 0);
+    static_assert(signed_first::index(Shader::Fragment) == 2 && unsigned_first::index(Shader::Fragment) == 2);
+    static_assert(unsigned_first::index(static_cast<Shader>(0xFFFF)) == unsigned_first::size);
+    static_assert(signed_first::value(0) == Negative::Minus);
+}
+
+TEST(enum_hash_indexer, empty) {
+    static_assert(enum_hash_indexer<Empty>::size == 0);
+    static_assert(enum_hash_indexer<Empty>::index(static_cast<Empty>(0)) == 0);
+}
+
+TEST(enum_hash_indexer, many_keys) {
+    constexpr std::size_t count = 1000;
+    constexpr auto keys = [] {
+        std::array<std::uint32_t, count> keys{};
+        for (std::size_t i = 0; i < count; ++i) {
+            keys[i] = static_cast<std::uint32_t>(0x8000 + i * 37 + (i * i) % 11);
+        }
+        return keys;
+    }();
+    constexpr auto table = detail::make_perfect_hash(keys);
+    static_assert(table.found);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(table.find(keys[i]), i);
+    }
+    std::size_t unknown = 0;
+    for (std::uint32_t raw = 0; raw < 0x20000; ++raw) {
+        const auto index = table.find(raw);
+        EXPECT_TRUE(index == count || keys[index] == raw);
+        unknown += index == count;
+    }
+    EXPECT_EQ(unknown, 0x20000 - count);
+}
+
+TEST(enum_hash_indexer, containers) {
+    static_assert(enum_map<Sparse, int>::size() == 5);
+    static_assert(!enum_map<Sparse, int>::contains(static_cast<Sparse>(0x8B32)));
+
+    enum_map<Sparse, int> map;
+    map[Sparse::Vertex] = 1;
+    map[Sparse::High] = 2;
+    EXPECT_EQ(map[Sparse::Vertex], 1);
+    EXPECT_EQ(map[Sparse::Fragment], 0);
+    EXPECT_EQ(map.find(static_cast<Sparse>(7)), nullptr);
+    EXPECT_EQ(map.key_at(4), Sparse::High);
+
+    enum_set<Sparse> set{Sparse::Compute, Sparse::One};
+    set.insert(static_cast<Sparse>(3));
+    EXPECT_EQ(set.size(), 2u);
+    EXPECT_TRUE(set.contains(Sparse::Compute));
+    EXPECT_EQ(std::vector<Sparse>(set.begin(), set.end()), (std::vector<Sparse>{Sparse::One, Sparse::Compute}));
+
+    constexpr shared_enum<Program, Shader> fragment = Program::Fragment;
+    enum_map<Program, int> counters;
+    ++counters[fragment];
+    ++counters[static_cast<Program>(Shader::Compiled)];
+    EXPECT_EQ((enum_map<Program, int>::size()), 3u);
+    EXPECT_EQ(counters[Program::Fragment], 1);
+    EXPECT_EQ(counters[static_cast<Program>(0x8B81)], 1);
+    EXPECT_EQ(counters[Program::Linked], 0);
+}
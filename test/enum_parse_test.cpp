@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <trak/enum_parse.hpp>
+#include <trak/shared_bitfield.hpp>
+
+#include <string>
+
+using namespace trak;
+
+namespace {
+    enum class A : unsigned int {
+        SharedEnum,
+        AnEnum,
+        Other
+    };
+
+    enum class B : unsigned int {
+        SharedEnum,
+        AnotherEnum,
+        Other
+    };
+
+    enum class Large : int {
+        V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11, V12, V13, V14, V15,
+        V16, V17, V18, V19, V20, V21, V22, V23, V24, V25, V26, V27, V28, V29, V30, V31,
+        V32, V33, V34, V35, V36, V37, V38, V39, V40, V41, V42, V43, V44, V45, V46, V47,
+        V48, V49, V50, V51, V52, V53, V54, V55, V56, V57, V58, V59, V60, V61, V62, V63
+    };
+
+    enum class Empty : int {};
+}
+
+TEST(enum_parse, enum) {
+    static_assert(*parse<A>("AnEnum") == A::AnEnum, "");
+
+    EXPECT_EQ(A::SharedEnum, parse<A>("SharedEnum"));
+    EXPECT_EQ(A::Other, parse<A>("Other"));
+    EXPECT_FALSE(parse<A>("AnotherEnum"));
+    EXPECT_FALSE(parse<A>(""));
+    EXPECT_FALSE(parse<A>("anEnum"));
+    EXPECT_FALSE(parse<A>("AnEnum "));
+    EXPECT_FALSE(parse<Empty>("Any"));
+}
+
+TEST(enum_parse, all_names) {
+    for (std::size_t i = 0; i < enum_reflection<Large>::size; ++i) {
+        EXPECT_EQ(enum_reflection<Large>::values[i], parse<Large>(enum_reflection<Large>::names[i]));
+    }
+    EXPECT_FALSE(parse<Large>("V64"));
+}
+
+TEST(enum_parse, shared_enum) {
+    auto shared = parse<shared_enum<A, B>>("SharedEnum");
+    ASSERT_TRUE(shared);
+    EXPECT_EQ(A::SharedEnum, *shared);
+    EXPECT_EQ(B::SharedEnum, *shared);
+
+    EXPECT_TRUE((parse<shared_enum<A, B>>("Other")));
+
+    // Names need to exist in all types of the shared enum.
+    EXPECT_FALSE((parse<shared_enum<A, B>>("AnEnum")));
+    EXPECT_FALSE((parse<shared_enum<B, A>>("AnotherEnum")));
+}
+
+TEST(enum_parse, shared_bitfield) {
+    auto bitfield = parse<shared_bitfield<A, B>>(std::string("Other"));
+    ASSERT_TRUE(bitfield);
+    EXPECT_EQ(B::Other, *bitfield);
+}
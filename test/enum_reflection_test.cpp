@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <trak/enum_reflection.hpp>
+#include <trak/shared_bitfield.hpp>
+
+using namespace trak;
+
+namespace {
+    enum class Dense : unsigned char {
+        Zero,
+        One,
+        Two
+    };
+
+    enum class Sparse : int {
+        Negative = -100,
+        Small = 3,
+        Large = 120
+    };
+
+    enum class Flags : unsigned int {
+        None = 0,
+        Read = 1u << 0u,
+        Write = 1u << 4u,
+        Execute = 1u << 31u
+    };
+
+    enum class OtherFlags : unsigned int {
+        Write = 1u << 4u,
+        Delete = 1u << 8u
+    };
+
+    enum class Empty : int {};
+}
+
+namespace trak {
+    template<>
+    struct enum_range<Flags> {
+        static constexpr long long min = 0;
+        static constexpr long long max = 0;
+        static constexpr bool flags = true;
+    };
+
+    template<>
+    struct enum_range<OtherFlags> : enum_range<Flags> {};
+}
+
+TEST(enum_reflection, dense) {
+    using reflection = enum_reflection<Dense>;
+    static_assert(reflection::size == 3, "");
+    static_assert(reflection::dense, "");
+    static_assert(reflection::values[2] == Dense::Two, "");
+    static_assert(name_of(Dense::One) == "One", "");
+
+    EXPECT_EQ("Zero", name_of(Dense::Zero));
+    EXPECT_EQ("Two", name_of(Dense::Two));
+    EXPECT_EQ("", name_of(static_cast<Dense>(3)));
+    EXPECT_EQ("", name_of(static_cast<Dense>(255)));
+}
+
+TEST(enum_reflection, sparse) {
+    using reflection = enum_reflection<Sparse>;
+    static_assert(reflection::size == 3, "");
+    static_assert(!reflection::dense, "");
+    static_assert(reflection::values[0] == Sparse::Negative, "");
+
+    EXPECT_EQ("Negative", name_of(Sparse::Negative));
+    EXPECT_EQ("Small", name_of(Sparse::Small));
+    EXPECT_EQ("Large", name_of(Sparse::Large));
+    EXPECT_EQ("", name_of(static_cast<Sparse>(4)));
+    EXPECT_EQ("", name_of(static_cast<Sparse>(1000)));
+}
+
+TEST(enum_reflection, flags) {
+    using reflection = enum_reflection<Flags>;
+    static_assert(reflection::size == 4, "");
+    static_assert(reflection::values[3] == Flags::Execute, "");
+
+    EXPECT_EQ("None", name_of(Flags::None));
+    EXPECT_EQ("Write", name_of(Flags::Write));
+    EXPECT_EQ("Execute", name_of(Flags::Execute));
+    EXPECT_EQ("", name_of(static_cast<Flags>(3)));
+}
+
+TEST(enum_reflection, empty) {
+    static_assert(enum_reflection<Empty>::size == 0, "");
+    EXPECT_EQ("", name_of(static_cast<Empty>(0)));
+}
+
+TEST(enum_reflection, names_are_contiguous) {
+    const auto& names = enum_reflection<Dense>::names;
+    EXPECT_EQ(names[0].data() + names[0].size() + 1, names[1].data());
+    EXPECT_EQ(names[1].data() + names[1].size() + 1, names[2].data());
+    EXPECT_EQ('\0', names[2].data()[names[2].size()]);
+}
+
+TEST(enum_reflection, shared) {
+    shared_enum<Dense> dense = Dense::Two;
+    EXPECT_EQ("Two", name_of(dense));
+
+    shared_bitfield<Flags, OtherFlags> write = OtherFlags::Write;
+    EXPECT_EQ("Write", name_of(write));
+
+    // The name is taken from the first type having an enumerator of the value.
+    shared_bitfield<OtherFlags, Flags> read = Flags::Read;
+    EXPECT_EQ("Read", name_of(read));
+
+    shared_bitfield<Flags, OtherFlags> unnamed = static_cast<shared_bitfield<Flags, OtherFlags>>(3u);
+    EXPECT_EQ("", name_of(unnamed));
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <trak/enum_traits.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class A : std::uint16_t {
+        First = 1,
+        Second,
+        Third,
+        Tenth = 10
+    };
+
+    enum class B : std::uint16_t {
+        First = 1,
+        Second,
+        Eleventh = 11
+    };
+
+    enum class Signed : std::int32_t {
+        Negative = -2,
+        MinusOne = -1,
+        Zero = 0,
+        Large = 100
+    };
+
+    enum class Flags : std::uint8_t {
+        One = 1,
+        Two = 2,
+        Eight = 8
+    };
+
+    enum class WideFlags : std::int16_t {
+        One = 1,
+        Eight = 8,
+        High = 0x100,
+        Sign = std::numeric_limits<std::int16_t>::min()
+    };
+
+    enum class Declared : std::uint64_t {
+        Low = 3,
+        High = 0x1000000000ull
+    };
+
+    enum class Sparse : std::uint8_t {
+        V0 = 0, V2 = 2, V4 = 4, V6 = 6, V8 = 8, V10 = 10, V12 = 12, V14 = 14, V16 = 16, V18 = 18
+    };
+
+    using ab = shared_enum<A, B>;
+    using ab_bits = shared_bitfield<A, B>;
+
+    std::vector<detail::simd_level> supported_levels() {
+        std::vector<detail::simd_level> levels;
+        for (auto level : {detail::simd_level::scalar, detail::simd_level::sse2, detail::simd_level::avx2, detail::simd_level::avx512}) {
+            if (level <= detail::detect_simd_level()) {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+}
+
+namespace trak {
+    template<>
+    struct enum_range<Flags> {
+        static constexpr long long min = 0;
+        static constexpr long long max = 0;
+        static constexpr bool flags = true;
+    };
+
+    template<>
+    struct enum_traits<WideFlags> : declared_flag_traits<WideFlags, WideFlags::One, WideFlags::Eight, WideFlags::High, WideFlags::Sign> {};
+
+    template<>
+    struct enum_traits<Declared> : declared_enum_traits<Declared, Declared::High, Declared::Low> {};
+}
+
+TEST(enum_traits, detected) {
+    static_assert(enum_traits<A>::size == 4);
+    static_assert(enum_traits<A>::min == 1);
+    static_assert(enum_traits<A>::max == 10);
+    static_assert(enum_traits<A>::mask == 11);
+    static_assert(!enum_traits<A>::flags);
+    static_assert(enum_traits<A>::contains(3) && !enum_traits<A>::contains(4));
+
+    static_assert(enum_traits<Signed>::min == -2);
+    static_assert(enum_traits<Signed>::contains(-1) && !enum_traits<Signed>::contains(-3));
+
+    static_assert(enum_traits<Flags>::flags);
+    static_assert(enum_traits<Flags>::mask == 11);
+    static_assert(enum_traits<Flags>::contains(0) && enum_traits<Flags>::contains(9) && !enum_traits<Flags>::contains(4));
+}
+
+TEST(enum_traits, declared) {
+    static_assert(enum_traits<Declared>::size == 2);
+    static_assert(enum_traits<Declared>::values[0] == Declared::Low);
+    static_assert(enum_traits<Declared>::max == 0x1000000000ull);
+    static_assert(enum_traits<Declared>::contains(0x1000000000ull) && !enum_traits<Declared>::contains(4));
+
+    EXPECT_TRUE(checked_cast<Declared>(3).has_value());
+    EXPECT_FALSE(checked_cast<Declared>(5).has_value());
+}
+
+TEST(enum_traits, checked_cast) {
+    static_assert(is_valid_value<ab>(2) && !is_valid_value<ab>(3) && !is_valid_value<ab>(10));
+    static_assert(is_valid_value<ab_bits>(11) && !is_valid_value<ab_bits>(4));
+
+    constexpr auto value = checked_cast<ab>(2);
+    static_assert(value.has_value() && *value == A::Second);
+    EXPECT_FALSE(checked_cast<ab>(11).has_value());
+    EXPECT_EQ(checked_cast<A>(10), A::Tenth);
+    EXPECT_EQ(checked_cast<ab_bits>(3), ab_bits(A::First) | ab_bits(B::Second));
+    EXPECT_FALSE(checked_cast<ab_bits>(4).has_value());
+    EXPECT_EQ(checked_cast<Flags>(10), static_cast<Flags>(10));
+}
+
+TEST(enum_traits, intervals) {
+    constexpr auto intervals = detail::make_value_intervals<std::int32_t, Signed>();
+    static_assert(intervals.size == 2);
+    static_assert(intervals.first[0] == static_cast<std::uint32_t>(-2) && intervals.extent[0] == 2);
+    static_assert(intervals.first[1] == 100 && intervals.extent[1] == 0);
+
+    constexpr auto shared = detail::make_value_intervals<std::uint16_t, A, B>();
+    static_assert(shared.size == 1 && shared.first[0] == 1 && shared.extent[0] == 1);
+}
+
+TEST(enum_traits, validate) {
+    std::vector<std::uint16_t> values(1000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<std::uint16_t>(i % 2 == 0 ? 1 : 2);
+    }
+    EXPECT_EQ(validate<A>(span<const std::uint16_t>(values)), values.size());
+    EXPECT_EQ(validate<ab>(span<const std::uint16_t>(values)), values.size());
+    EXPECT_EQ(validate<ab_bits>(span<const std::uint16_t>(values)), values.size());
+    for (auto invalid : {std::size_t{0}, std::size_t{31}, std::size_t{500}, std::size_t{999}}) {
+        auto copy = values;
+        copy[invalid] = 4;
+        EXPECT_EQ(validate<A>(span<const std::uint16_t>(copy)), invalid);
+        EXPECT_EQ(validate<ab_bits>(span<const std::uint16_t>(copy)), invalid);
+        copy[invalid] = 10;
+        EXPECT_EQ(validate<ab>(span<const std::uint16_t>(copy)), invalid);
+        EXPECT_EQ(validate<A>(span<const std::uint16_t>(copy)), values.size());
+    }
+
+    std::vector<ab> shared(values.size(), A::First);
+    EXPECT_EQ(validate(span<const ab>(shared)), shared.size());
+    shared[123] = static_cast<ab>(std::uint16_t{3});
+    EXPECT_EQ(validate(span<const ab>(shared)), 123u);
+}
+
+TEST(enum_traits, validate_fallback) {
+    static_assert(detail::make_value_intervals<std::uint8_t, Sparse>().size > detail::max_validate_intervals);
+    std::vector<std::uint8_t> values(300, 18);
+    EXPECT_EQ(validate<Sparse>(span<const std::uint8_t>(values)), values.size());
+    values[250] = 5;
+    EXPECT_EQ(validate<Sparse>(span<const std::uint8_t>(values)), 250u);
+
+}
+
+TEST(enum_traits, validate_flags) {
+    using shared_flags = shared_enum<Flags, WideFlags>;
+    static_assert(detail::make_flags_mask<std::uint8_t, Flags>() == 11);
+    static_assert(detail::make_flags_mask<std::uint8_t, Flags, WideFlags>() == 9);
+
+    std::vector<std::uint8_t> flags(300);
+    for (std::size_t i = 0; i < flags.size(); ++i) {
+        flags[i] = static_cast<std::uint8_t>(i % 3 == 0 ? 9 : i % 3);
+    }
+    EXPECT_EQ(validate<Flags>(span<const std::uint8_t>(flags)), flags.size());
+    EXPECT_EQ(validate<shared_flags>(span<const std::uint8_t>(flags)), 2u);
+    for (auto invalid : {std::size_t{0}, std::size_t{63}, std::size_t{65}, std::size_t{299}}) {
+        auto copy = flags;
+        copy[invalid] = 4;
+        EXPECT_EQ(validate<Flags>(span<const std::uint8_t>(copy)), invalid);
+        for (auto& value : copy) {
+            value = static_cast<std::uint8_t>(value & 9);
+        }
+        copy[invalid] = 2;
+        EXPECT_EQ(validate<shared_flags>(span<const std::uint8_t>(copy)), invalid);
+        EXPECT_EQ(validate<Flags>(span<const std::uint8_t>(copy)), flags.size());
+    }
+    EXPECT_FALSE(is_valid_value<shared_flags>(0x80));
+}
+
+template<typename U>
+void test_kernels(const detail::validate_kernels<U>& kernels) {
+    constexpr U first[] = {U{5}, static_cast<U>(std::numeric_limits<U>::max() - 1)};
+    constexpr U extent[] = {U{3}, U{2}};
+    std::vector<U> values(515);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<U>(i % 3 == 0 ? 5 : i % 3 == 1 ? 8 : 0);
+    }
+    EXPECT_EQ(kernels.first_outside(values.data(), values.size(), first, extent, 2), values.size());
+    EXPECT_EQ(kernels.first_with_bits(values.data(), values.size(), static_cast<U>(~U{15})), values.size());
+    for (std::size_t invalid = 0; invalid < values.size(); invalid += 7) {
+        auto copy = values;
+        copy[invalid] = 9;
+        EXPECT_EQ(kernels.first_outside(copy.data(), copy.size(), first, extent, 2), invalid);
+        copy[invalid] = 1;
+        EXPECT_EQ(kernels.first_outside(copy.data(), copy.size(), first, extent, 2), invalid);
+        copy[invalid] = 16;
+        EXPECT_EQ(kernels.first_with_bits(copy.data(), copy.size(), static_cast<U>(~U{15})), invalid);
+    }
+}
+
+TEST(enum_traits, kernels) {
+    for (auto level : supported_levels()) {
+        SCOPED_TRACE(static_cast<int>(level));
+        test_kernels(detail::validate_kernels_for<std::uint8_t>(level));
+        test_kernels(detail::validate_kernels_for<std::uint16_t>(level));
+        test_kernels(detail::validate_kernels_for<std::uint32_t>(level));
+        test_kernels(detail::validate_kernels_for<std::uint64_t>(level));
+    }
+}
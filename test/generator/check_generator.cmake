@@ -0,0 +1,51 @@
+# Runs the registry generator on REGISTRY, then on modified copies of it, and fails unless exactly the outputs
+# whose content changed are rewritten, and conflicting registries are rejected.
+#
+# Arguments:
+#   PYTHON      The Python 3 interpreter.
+#   SCRIPT      The generator script.
+#   REGISTRY    The registry file.
+#   OUTPUT_DIR  The directory to generate into.
+
+function(generate registry expected)
+    execute_process(
+            COMMAND ${PYTHON} ${SCRIPT} --registry ${registry} --output ${OUTPUT_DIR}/generated --verbose
+            OUTPUT_VARIABLE output
+            RESULT_VARIABLE result)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "Generating from ${registry} failed")
+    endif ()
+    string(REGEX MATCHALL "(written|removed) [^\n]+" changes "${output}")
+    if (NOT "${expected}" STREQUAL "*" AND NOT "${changes}" STREQUAL "${expected}")
+        message(FATAL_ERROR "Expected the changes '${expected}', but got '${changes}'")
+    endif ()
+endfunction()
+
+file(REMOVE_RECURSE ${OUTPUT_DIR}/generated)
+file(READ ${REGISTRY} content)
+
+# Generating again without changes writes nothing.
+generate(${REGISTRY} "*")
+generate(${REGISTRY} "")
+
+# Adding a value to an enum without shared values rewrites its definition and its constants only.
+string(REPLACE "{\"name\": \"ENABLED\", \"value\": 1}" "{\"name\": \"ENABLED\", \"value\": 1}, {\"name\": \"UNKNOWN\", \"value\": 2}" added "${content}")
+file(WRITE ${OUTPUT_DIR}/added/registry.json "${added}")
+generate(${OUTPUT_DIR}/added/registry.json "written registry/types/Boolean.hpp;written registry/values/Boolean.hpp")
+
+# Removing an enum removes its outputs, and rewrites the outputs of the constants it shared.
+string(REGEX REPLACE ",[ \n]*{[ \n]*\"name\": \"DrawBufferMode\"[^]]*][ \n]*}" "" removed "${added}")
+file(WRITE ${OUTPUT_DIR}/removed/registry.json "${removed}")
+generate(${OUTPUT_DIR}/removed/registry.json
+        "removed registry/DrawBufferMode.hpp;removed registry/types/DrawBufferMode.hpp;removed registry/values/DrawBufferMode.hpp;written registry/all.hpp;written registry/fwd.hpp;written registry/values/CullFaceMode.hpp")
+
+# A name shared with different values is rejected.
+string(REPLACE "{\"name\": \"NO_BUFFER\", \"value\": 0}" "{\"name\": \"NO_BUFFER\", \"value\": 0}, {\"name\": \"ENABLED\", \"value\": 5}" conflicting "${content}")
+file(WRITE ${OUTPUT_DIR}/conflicting/registry.json "${conflicting}")
+execute_process(
+        COMMAND ${PYTHON} ${SCRIPT} --registry ${OUTPUT_DIR}/conflicting/registry.json --output ${OUTPUT_DIR}/generated
+        ERROR_VARIABLE error
+        RESULT_VARIABLE result)
+if (result EQUAL 0 OR NOT error MATCHES "value ENABLED is 5 in enum DrawBufferMode, but 1 in enum Boolean")
+    message(FATAL_ERROR "Expected the conflicting registry to be rejected, but got '${error}'")
+endif ()
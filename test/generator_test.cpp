@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <registry/fwd.hpp>
+#include <registry/all.hpp>
+
+#include <type_traits>
+
+namespace {
+    // Should be usable with the opaque declarations only.
+    registry::CullFaceMode forward(registry::CullFaceMode mode);
+
+    registry::CullFaceMode forward(registry::CullFaceMode mode) {
+        return mode;
+    }
+
+    std::uint32_t takes_attrib_mask(registry::AttribMask mask) {
+        return static_cast<std::uint32_t>(mask);
+    }
+
+    std::uint32_t takes_clear_buffer_mask(registry::ClearBufferMask mask) {
+        return static_cast<std::uint32_t>(mask);
+    }
+
+    std::uint32_t takes_draw_buffer_mode(registry::DrawBufferMode mode) {
+        return static_cast<std::uint32_t>(mode);
+    }
+}
+
+TEST(generator, constants) {
+    static_assert(std::is_same<std::underlying_type<registry::Boolean>::type, std::uint32_t>::value);
+    static_assert(std::is_same<decltype(registry::ENABLED), const registry::Boolean>::value);
+    static_assert(std::is_same<decltype(registry::DEPTH_BUFFER_BIT),
+            const trak::shared_bitfield<registry::AttribMask, registry::ClearBufferMask>>::value);
+    static_assert(std::is_same<decltype(registry::FRONT),
+            const trak::shared_enum<registry::CullFaceMode, registry::DrawBufferMode>>::value);
+    // Shared by enums of 16 and 32 bits, stored in 16 bits.
+    static_assert(sizeof(registry::FRONT) == sizeof(std::uint16_t));
+
+    EXPECT_EQ(takes_attrib_mask(registry::DEPTH_BUFFER_BIT | registry::COLOR_BUFFER_BIT), 0x4100u);
+    EXPECT_EQ(takes_clear_buffer_mask(registry::DEPTH_BUFFER_BIT), 0x100u);
+    EXPECT_EQ(takes_draw_buffer_mode(registry::BACK), 0x405u);
+    EXPECT_EQ(forward(registry::FRONT), registry::CullFaceMode::FRONT);
+    EXPECT_EQ(registry::FRONT, registry::DrawBufferMode::FRONT);
+}
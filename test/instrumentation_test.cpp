@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <trak/instrumentation.hpp>
+#include <trak/shared_bitfield.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace trak;
+
+static_assert(TRAK_INSTRUMENT == 1, "instrumentation_test requires TRAK_INSTRUMENT");
+
+namespace {
+    enum class A : std::uint16_t {
+        First = 1,
+        Second = 2
+    };
+
+    enum class B : std::uint16_t {
+        First = 1,
+        Second = 2,
+        Third = 3
+    };
+
+    using shared = shared_enum<A, B>;
+
+    // Should not count conversions and comparisons in constant expressions.
+    constexpr shared constant = A::Second;
+    static_assert(static_cast<B>(constant) == B::Second && constant == A::Second);
+
+    const instrument_record* find(const std::vector<instrument_record>& report, std::string_view type, std::string_view name) {
+        for (const auto& record : report) {
+            if (record.type.size() >= type.size() && record.type.substr(record.type.size() - type.size()) == type && record.name == name) {
+                return &record;
+            }
+        }
+        return nullptr;
+    }
+}
+
+TEST(instrumentation, counts) {
+    reset_instrument_counters();
+    shared value = A::First;
+    volatile bool sink = false;
+    for (int i = 0; i < 10; ++i) {
+        B converted = value;
+        sink = converted == B::First;
+        sink = value == A::First;
+        sink = B::Second != value;
+    }
+    sink = value == shared(B::Third);
+    sink = shared_enum<B, A>(std::uint16_t{7}) != value;
+    static_cast<void>(sink);
+
+    const auto report = instrument_report();
+    ASSERT_EQ(report.size(), 4u);
+    const auto* b_first = find(report, "::B", "First");
+    ASSERT_NE(b_first, nullptr);
+    EXPECT_EQ(b_first->conversions, 10u);
+    EXPECT_EQ(b_first->comparisons, 0u);
+    EXPECT_EQ(b_first->value, 1);
+    EXPECT_EQ(find(report, "::A", "First")->comparisons, 11u);
+    EXPECT_EQ(find(report, "::B", "Second")->comparisons, 10u);
+    // Comparisons of shared enums are counted for the first common type of the left-hand side.
+    EXPECT_EQ(find(report, "::B", "")->comparisons, 1u);
+    EXPECT_EQ(find(report, "::B", "")->value, 0);
+}
+
+TEST(instrumentation, threads) {
+    reset_instrument_counters();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            shared value = B::Third;
+            for (int i = 0; i < 1000; ++i) {
+                B converted = value;
+                static_cast<void>(converted);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto report = instrument_report();
+    ASSERT_EQ(report.size(), 1u);
+    EXPECT_EQ(report[0].name, "Third");
+    EXPECT_EQ(report[0].conversions, 4000u);
+
+    reset_instrument_counters();
+    EXPECT_TRUE(instrument_report().empty());
+}
+
+TEST(instrumentation, write) {
+    reset_instrument_counters();
+    shared value = A::Second;
+    A converted = value;
+    static_cast<void>(converted);
+
+    auto* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    EXPECT_TRUE(write_instrument_report(file));
+    std::rewind(file);
+    char line[256];
+    ASSERT_NE(std::fgets(line, sizeof(line), file), nullptr);
+    EXPECT_STREQ(line, "type\tenumerator\tvalue\tconversions\tcomparisons\n");
+    ASSERT_NE(std::fgets(line, sizeof(line), file), nullptr);
+    EXPECT_NE(std::string_view(line).find("A\tSecond\t2\t1\t0\n"), std::string_view::npos);
+    std::fclose(file);
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+import trak;
+
+namespace {
+    enum class A : std::uint16_t {
+        First = 1,
+        Second = 2
+    };
+
+    enum class B : std::uint16_t {
+        First = 1,
+        Third = 4
+    };
+}
+
+TEST(module, import) {
+    trak::shared_enum<A, B> value = A::First;
+    trak::shared_bitfield<A, B> bits = B::Third;
+    bits |= trak::shared_bitfield<A, B>(A::First);
+
+    EXPECT_TRUE(value == B::First);
+    EXPECT_TRUE(value < B::Third);
+    EXPECT_EQ(static_cast<std::uint16_t>(bits), 5);
+    EXPECT_EQ(trak::name_of(A::Second), "Second");
+    EXPECT_EQ(trak::parse<A>("Second"), A::Second);
+    static_assert(trak::intersecting_shared_enums<trak::shared_enum<A>, trak::shared_enum<B, A>>);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <trak/packed_enum_vector.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class A : unsigned int {
+        First = 10,
+        Second,
+        Third,
+        Fourth,
+        Fifth
+    };
+
+    enum class B : unsigned int {
+        First = 10,
+        Second,
+        Third
+    };
+
+    enum class Wide : int {
+        Min = -300,
+        Max = 300
+    };
+
+    using shared = shared_enum<A, B>;
+}
+
+namespace trak {
+    template<>
+    struct enum_range<Wide> {
+        static constexpr long long min = -300;
+        static constexpr long long max = 300;
+        static constexpr bool flags = false;
+    };
+}
+
+namespace {
+
+    std::vector<detail::simd_level> supported_levels() {
+        std::vector<detail::simd_level> levels;
+        for (auto level : {detail::simd_level::scalar, detail::simd_level::sse2, detail::simd_level::avx2, detail::simd_level::avx512}) {
+            if (level <= detail::detect_simd_level()) {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+}
+
+TEST(packed_enum_vector, width) {
+    static_assert(packed_enum_vector<A>::width == 3);
+    static_assert(packed_enum_vector<shared>::width == 3);
+    static_assert(packed_enum_vector<Wide>::width == 10);
+    static_assert(std::is_same<packed_enum_vector<shared>::enum_type, A>::value);
+}
+
+TEST(packed_enum_vector, access) {
+    packed_enum_vector<shared> values;
+    EXPECT_TRUE(values.empty());
+    values.push_back(A::Third);
+    values.push_back(B::First);
+    values.push_back(A::Third);
+    EXPECT_EQ(values.size(), 3u);
+    EXPECT_EQ(values[0], A::Third);
+    EXPECT_EQ(values[1], B::First);
+
+    values.set(1, A::Second);
+    EXPECT_EQ(values[0], A::Third);
+    EXPECT_EQ(values[1], A::Second);
+    EXPECT_EQ(values[2], A::Third);
+
+    values.clear();
+    EXPECT_TRUE(values.empty());
+}
+
+TEST(packed_enum_vector, memory) {
+    packed_enum_vector<A> values;
+    values.reserve(1000);
+    for (std::size_t i = 0; i < 1000; ++i) {
+        values.push_back(static_cast<A>(10 + i % 5));
+    }
+    EXPECT_LE(values.memory_usage(), 1000 * 3 / 8 + 16);
+}
+
+TEST(packed_enum_vector, unpack) {
+    std::mt19937 engine(1);
+    std::vector<Wide> expected;
+    packed_enum_vector<Wide> values;
+    for (std::size_t i = 0; i < 1037; ++i) {
+        const auto value = static_cast<Wide>(static_cast<int>(engine() % 601) - 300);
+        expected.push_back(value);
+        values.push_back(value);
+    }
+    EXPECT_EQ(values.unpack(), expected);
+
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(values[i], expected[i]);
+    }
+
+    std::vector<Wide> slice(300);
+    values.unpack(17, slice.size(), slice.data());
+    EXPECT_EQ(slice, std::vector<Wide>(expected.begin() + 17, expected.begin() + 317));
+}
+
+TEST(packed_enum_vector, kernels) {
+    std::mt19937 engine(2);
+    std::vector<unsigned char> data(4096 + 8);
+    for (auto& byte : data) {
+        byte = static_cast<unsigned char>(engine());
+    }
+
+    for (unsigned int width = 1; width <= 24; ++width) {
+        const std::size_t count = 4096 * 8 / width - 37;
+        std::vector<std::uint32_t> expected(count);
+        detail::scalar_kernels::unpack(data.data(), 0, count, width, expected.data());
+        for (auto level : supported_levels()) {
+            for (std::size_t first : {std::size_t{0}, std::size_t{3}, std::size_t{37}}) {
+                std::vector<std::uint32_t> actual(count - first);
+                detail::unpack_kernel_for(level)(data.data(), first, count - first, width, actual.data());
+                EXPECT_EQ(actual, std::vector<std::uint32_t>(expected.begin() + first, expected.end()))
+                        << "width " << width << ", level " << static_cast<int>(level) << ", first " << first;
+            }
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <trak/mapped_file.hpp>
+#include <trak/serialization.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace trak;
+
+namespace {
+    enum class A : std::uint16_t {
+        First = 1,
+        Second = 0x0102,
+        Third = 0x8000
+    };
+
+    enum class B : std::uint16_t {
+        First = 1,
+        Second = 2
+    };
+
+    enum class Named : std::uint8_t {
+        First = 1
+    };
+
+    using shared = shared_enum<A, B>;
+    using bits = shared_bitfield<A, B>;
+
+    std::string temp_path(const char* name) {
+        return testing::TempDir() + name;
+    }
+
+    std::vector<shared> make_values(std::size_t size) {
+        std::vector<shared> values;
+        for (std::size_t i = 0; i < size; ++i) {
+            values.push_back(i % 3 == 0 ? shared(A::Second) : i % 3 == 1 ? shared(A::Third) : shared(B::Second));
+        }
+        return values;
+    }
+
+    constexpr std::uint64_t hash_names(std::string_view kind, std::string_view names) {
+        return detail::hash_bytes(detail::hash_bytes(0xcbf29ce484222325ull, kind), names);
+    }
+
+    std::vector<unsigned char> read_file(const std::string& path) {
+        std::vector<unsigned char> bytes;
+        if (auto* file = std::fopen(path.c_str(), "rb")) {
+            int c;
+            while ((c = std::fgetc(file)) != EOF) {
+                bytes.push_back(static_cast<unsigned char>(c));
+            }
+            std::fclose(file);
+        }
+        return bytes;
+    }
+}
+
+template<>
+struct trak::stream_type_name<Named> {
+    static constexpr std::string_view value = "trak.test.Named";
+};
+
+TEST(serialization, type_id) {
+    static_assert(stream_type_id<shared> == stream_type_id<shared_enum<A, B>>);
+    static_assert(stream_type_id<shared> != stream_type_id<shared_enum<B, A>>);
+    static_assert(stream_type_id<shared> != stream_type_id<bits>);
+    static_assert(stream_type_id<shared> != stream_type_id<A>);
+    EXPECT_EQ(detail::type_name<A>().substr(detail::type_name<A>().size() - 3), "::A");
+
+    static_assert(stream_type_id<Named> == hash_names("enum:", "trak.test.Named"));
+    static_assert(stream_type_id<shared_enum<Named>> == hash_names("shared_enum:", "trak.test.Named,"));
+}
+
+TEST(serialization, header) {
+    stream_header header;
+    header.order = endian::big;
+    header.width = 2;
+    header.type_id = 0x0102030405060708ull;
+    header.count = 42;
+    unsigned char data[stream_header::size];
+    encode_stream_header(header, data);
+    EXPECT_EQ(data[16], 0x08);
+
+    stream_header decoded;
+    ASSERT_EQ(decode_stream_header(data, decoded), stream_error::none);
+    EXPECT_EQ(decoded.order, endian::big);
+    EXPECT_EQ(decoded.width, 2);
+    EXPECT_EQ(decoded.type_id, header.type_id);
+    EXPECT_EQ(decoded.count, 42u);
+
+    data[0] = 'X';
+    EXPECT_EQ(decode_stream_header(data, decoded), stream_error::format);
+}
+
+TEST(serialization, round_trip) {
+    const auto path = temp_path("trak_round_trip.bin");
+    const auto values = make_values(100000);
+    for (auto order : {endian::little, endian::big}) {
+        enum_stream_writer<shared> writer(order, 1000);
+        ASSERT_EQ(writer.open(path.c_str()), stream_error::none);
+        ASSERT_EQ(writer.write(span<const shared>(values.data(), 10)), stream_error::none);
+        for (std::size_t i = 10; i < 20; ++i) {
+            ASSERT_EQ(writer.write(values[i]), stream_error::none);
+        }
+        ASSERT_EQ(writer.write(span<const shared>(values.data() + 20, values.size() - 20)), stream_error::none);
+        ASSERT_EQ(writer.close(), stream_error::none);
+
+        enum_stream_reader<shared> reader;
+        ASSERT_EQ(reader.open(path.c_str()), stream_error::none);
+        EXPECT_EQ(reader.header().order, order);
+        EXPECT_EQ(reader.header().count, values.size());
+        std::vector<shared> read(values.size() + 1, A::First);
+        std::size_t size = 0;
+        while (auto n = reader.read(span<shared>(read.data() + size, 777 < read.size() - size ? 777 : read.size() - size))) {
+            size += n;
+        }
+        EXPECT_EQ(reader.error(), stream_error::none);
+        ASSERT_EQ(size, values.size());
+        read.pop_back();
+        EXPECT_EQ(read, values);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(serialization, big_endian_layout) {
+    const auto path = temp_path("trak_big_endian.bin");
+    {
+        enum_stream_writer<shared> writer(endian::big);
+        ASSERT_EQ(writer.open(path.c_str()), stream_error::none);
+        writer.write(shared(A::Second));
+    }
+    const auto bytes = read_file(path);
+    ASSERT_EQ(bytes.size(), stream_header::size + 2);
+    EXPECT_EQ(bytes[stream_header::size], 0x01);
+    EXPECT_EQ(bytes[stream_header::size + 1], 0x02);
+    std::remove(path.c_str());
+}
+
+TEST(serialization, view) {
+    const auto path = temp_path("trak_view.bin");
+    const auto values = make_values(1000);
+    {
+        enum_stream_writer<shared> writer;
+        ASSERT_EQ(writer.open(path.c_str()), stream_error::none);
+        writer.write(span<const shared>(values));
+    }
+#if TRAK_HAS_MAPPED_FILE
+    mapped_file file;
+    ASSERT_EQ(file.open(path.c_str()), stream_error::none);
+    const auto bytes = file.bytes();
+#else
+    const auto data = read_file(path);
+    const auto bytes = span<const unsigned char>(data);
+#endif
+    span<const shared> view;
+    ASSERT_EQ(view_enum_stream(bytes, view), stream_error::none);
+    EXPECT_EQ(static_cast<const void*>(view.data()), static_cast<const void*>(bytes.data() + stream_header::size));
+    EXPECT_EQ(std::vector<shared>(view.begin(), view.end()), values);
+
+    span<const bits> bitfields;
+    EXPECT_EQ(view_enum_stream(bytes, bitfields), stream_error::type);
+    span<const shared_enum<B, A>> reordered;
+    EXPECT_EQ(view_enum_stream(bytes, reordered), stream_error::type);
+    EXPECT_EQ(view_enum_stream(span<const unsigned char>(bytes.data(), bytes.size() - 1), view), stream_error::truncated);
+    EXPECT_EQ(view_enum_stream(span<const unsigned char>(bytes.data(), 8), view), stream_error::truncated);
+
+    std::vector<unsigned char> misaligned(1);
+    misaligned.insert(misaligned.end(), bytes.begin(), bytes.end());
+    EXPECT_EQ(view_enum_stream(span<const unsigned char>(misaligned.data() + 1, bytes.size()), view), stream_error::alignment);
+    std::remove(path.c_str());
+}
+
+TEST(serialization, errors) {
+    const auto path = temp_path("trak_errors.bin");
+    {
+        enum_stream_writer<bits> writer(endian::native == endian::little ? endian::big : endian::little);
+        ASSERT_EQ(writer.open(path.c_str()), stream_error::none);
+        writer.write(bits(A::First) | bits(B::Second));
+    }
+    const auto bytes = read_file(path);
+    span<const bits> view;
+    EXPECT_EQ(view_enum_stream(span<const unsigned char>(bytes), view), stream_error::endianness);
+
+    enum_stream_reader<bits> reader;
+    ASSERT_EQ(reader.open(path.c_str()), stream_error::none);
+    bits value = A::Third;
+    ASSERT_EQ(reader.read(span<bits>(&value, 1)), 1u);
+    EXPECT_EQ(value, bits(A::First) | bits(B::Second));
+
+    enum_stream_reader<shared> mismatch;
+    EXPECT_EQ(mismatch.open(path.c_str()), stream_error::type);
+    EXPECT_EQ(mismatch.read(span<shared>(nullptr, 0)), 0u);
+
+    enum_stream_reader<shared> missing;
+    EXPECT_EQ(missing.open((path + ".missing").c_str()), stream_error::io);
+    std::remove(path.c_str());
+}
@@ -2,6 +2,13 @@
 #include <trak/shared_enum.hpp>
 #include <trak/shared_bitfield.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
 using namespace trak;
 
 enum class A : unsigned int {
@@ -91,6 +98,11 @@ TEST(shared_enum, convertible) {
 
     shared_enum<A> value3 = A::Second;
     EXPECT_EQ(1, takes_A(value3));
+
+    // Should be convertible to shared enums of a subset of its types.
+    shared_enum<C, A> value4 = value1;
+    EXPECT_EQ(0, takes_C(value4));
+    EXPECT_EQ(0, takes_A(value4));
 }
 
 TEST(shared_enum, comparable) {
@@ -125,6 +137,82 @@ TEST(shared_enum, comparable) {
     EXPECT_EQ(shared_1, shared_bc_first);
 }
 
+template<typename L, typename R, typename = void>
+struct is_less_comparable : std::false_type {};
+
+template<typename L, typename R>
+struct is_less_comparable<L, R, decltype(static_cast<void>(std::declval<L>() < std::declval<R>()))> : std::true_type {};
+
+TEST(shared_enum, ordered) {
+    shared_enum<A, B, C> shared_first = A::First;
+    shared_enum<A, B> shared_ab_second = B::Second;
+    shared_enum<B, C> shared_bc_third = C::Third;
+
+    // Should be ordered by their underlying value.
+    EXPECT_TRUE(shared_first < shared_ab_second);
+    EXPECT_TRUE(shared_first <= shared_ab_second);
+    EXPECT_FALSE(shared_first > shared_ab_second);
+    EXPECT_TRUE(shared_bc_third >= shared_ab_second);
+    EXPECT_TRUE(shared_first != shared_bc_third);
+    EXPECT_FALSE(shared_first != C::First);
+
+    // Should be ordered against the values of their types in both directions.
+    EXPECT_TRUE(shared_first < B::Second);
+    EXPECT_TRUE(A::First < shared_ab_second);
+    EXPECT_FALSE(A::First > shared_ab_second);
+    EXPECT_TRUE(shared_bc_third >= B::Third);
+    EXPECT_TRUE(A::Third != shared_ab_second);
+
+    // Should not be ordered against shared enums and values without a common type.
+    EXPECT_FALSE((is_less_comparable<shared_enum<A>, shared_enum<B>>::value));
+    EXPECT_FALSE((is_less_comparable<shared_enum<A, B>, C>::value));
+    EXPECT_FALSE((is_less_comparable<C, shared_enum<A, B>>::value));
+    EXPECT_TRUE((is_less_comparable<shared_enum<A, B>, shared_bitfield<B, C>>::value));
+
+#if TRAK_HAS_THREE_WAY_COMPARISON
+    EXPECT_TRUE((shared_first <=> shared_ab_second) < 0);
+    EXPECT_TRUE((shared_bc_third <=> B::Third) == 0);
+    EXPECT_TRUE((B::Third <=> shared_ab_second) > 0);
+#endif
+}
+
+TEST(shared_enum, constraints) {
+    static_assert(shared_enum_member<A, A, B>);
+    static_assert(!shared_enum_member<C, A, B>);
+    static_assert(intersecting_shared_enums<shared_enum<A, B>, shared_enum<B, C>>);
+    static_assert(!intersecting_shared_enums<shared_enum<A>, shared_enum<B, C>>);
+
+    // Should constrain the operators the same way in C++17 and C++20.
+    EXPECT_FALSE((is_less_comparable<shared_bitfield<A>, shared_enum<C>>::value));
+    EXPECT_TRUE((is_less_comparable<shared_bitfield<A, C>, shared_enum<C>>::value));
+}
+
+TEST(shared_enum, canonical) {
+    static_assert(std::is_same<canonical_shared_enum_t<B, A>, shared_enum<A, B>>::value);
+    static_assert(std::is_same<canonical_shared_enum_t<C, A, C, B, A>, shared_enum<A, B, C>>::value);
+    static_assert(std::is_same<canonical_shared_bitfield_t<C, B>, shared_bitfield<B, C>>::value);
+
+    // Should preserve the order of the left-hand side by default.
+    static_assert(std::is_same<intersect_shared_enum<shared_enum<C, B, A>, shared_enum<A, B>>::type, shared_enum<B, A>>::value);
+
+    canonical_shared_enum_t<B, A> value = shared_enum<B, A>(B::Second);
+    EXPECT_EQ(value, A::Second);
+}
+
+TEST(shared_enum, hashable) {
+    std::unordered_set<shared_enum<A, B>> set{A::First, B::Second};
+    EXPECT_EQ(set.count(A::First), 1u);
+    EXPECT_EQ(set.count(A::Second), 1u);
+    EXPECT_EQ(set.count(B::Third), 0u);
+
+    std::set<shared_enum<A, B>> ordered{B::Third, A::First, A::Second};
+    EXPECT_EQ(*ordered.begin(), A::First);
+    EXPECT_EQ(*ordered.rbegin(), B::Third);
+
+    std::unordered_set<shared_bitfield<A, B>> bitfields{A::First, A::Second};
+    EXPECT_EQ(bitfields.count(B::Second), 1u);
+}
+
 TEST(shared_bitfield, operator_or) {
     shared_bitfield<A, B> bitfield_ab_second = A::Second;
     shared_bitfield<B, C> bitfield_bc_third = B::Third;
@@ -155,4 +243,123 @@ TEST(shared_bitfield, operator_xor) {
     EXPECT_EQ(A::Second, bitfield_ab_second);
     bitfield_ab_second ^= bitfield_bc_third;
     EXPECT_EQ(A::Second ^ A::Third, bitfield_ab_second);
-}
\ No newline at end of file
+}
+
+enum class Narrow : std::uint8_t {
+    First,
+    Second,
+    Third
+};
+
+enum class Medium : std::uint16_t {
+    First,
+    Second,
+    Third,
+    Wide = 0x1000
+};
+
+enum class Signed : std::int8_t {
+    Negative = -1,
+    First,
+    Second,
+    Third
+};
+
+enum class Signed64 : std::int64_t {
+    Negative = -1,
+    First
+};
+
+enum class Unsigned64 : std::uint64_t {
+    First = 1
+};
+
+TEST(shared_enum, heterogeneous) {
+    // The value is stored in the narrowest underlying type, independent of the order of the types.
+    EXPECT_EQ(sizeof(std::uint8_t), (sizeof(shared_enum<A, Medium, Narrow>)));
+    EXPECT_TRUE((std::is_same<shared_enum<Narrow, A>::underlying_type, std::uint8_t>::value));
+    EXPECT_TRUE((std::is_same<shared_enum<A, Narrow>::underlying_type, std::uint8_t>::value));
+    EXPECT_TRUE((std::is_same<shared_enum<A, Medium>::underlying_type, std::uint16_t>::value));
+    // Of equal widths, the unsigned type is chosen, as the shared values are not negative.
+    EXPECT_TRUE((std::is_same<shared_enum<Signed, Narrow>::underlying_type, std::uint8_t>::value));
+    EXPECT_TRUE((std::is_same<shared_enum<Signed>::underlying_type, std::int8_t>::value));
+
+    // Conversions are lossless in both directions.
+    constexpr shared_enum<A, Medium, Narrow> value = Medium::Third;
+    EXPECT_EQ(A::Third, value);
+    EXPECT_EQ(Narrow::Third, static_cast<Narrow>(value));
+    EXPECT_EQ(Medium::Third, static_cast<Medium>(value));
+    const shared_enum<A, Medium> wider = value;
+    EXPECT_EQ(sizeof(std::uint16_t), sizeof(wider));
+    EXPECT_EQ(Medium::Third, wider);
+    const shared_enum<A, Medium, Narrow> narrower = shared_enum<A, Medium, Narrow, B>(B::Second);
+    EXPECT_EQ(Narrow::Second, narrower);
+
+    // Values are compared in a type representing both sides.
+    const shared_enum<Medium, A> wide = Medium::Wide;
+    EXPECT_NE(wide, value);
+    EXPECT_TRUE(wide > value);
+    EXPECT_TRUE(value < wide);
+    EXPECT_TRUE(wide > Medium::Third);
+    EXPECT_TRUE(Medium::First < wide);
+    EXPECT_FALSE((wide == shared_enum<Medium, A>(Medium::Third)));
+    const shared_enum<Signed> negative = Signed::Negative;
+    EXPECT_TRUE((negative < shared_enum<Signed, Narrow>(Signed::First)));
+    EXPECT_TRUE((negative != shared_enum<Signed, Narrow>(Narrow::Third)));
+    // Signed and unsigned 64-bit values are compared by sign first, as no wider type represents both.
+    const shared_enum<Signed64> negative64 = Signed64::Negative;
+    const shared_enum<Signed64, Unsigned64> first64 = Unsigned64::First;
+    const shared_enum<Signed64, Unsigned64> max64(std::numeric_limits<std::uint64_t>::max());
+    EXPECT_TRUE((std::is_same<shared_enum<Signed64, Unsigned64>::underlying_type, std::uint64_t>::value));
+    EXPECT_TRUE(negative64 < first64);
+    EXPECT_TRUE(first64 > negative64);
+    EXPECT_TRUE(negative64 <= max64);
+    EXPECT_FALSE(negative64 >= max64);
+    EXPECT_TRUE(negative64 != max64);
+    EXPECT_FALSE(negative64 == max64);
+#if TRAK_HAS_THREE_WAY_COMPARISON
+    EXPECT_TRUE((negative64 <=> max64) < 0);
+#endif
+
+    std::set<shared_enum<A, Medium, Narrow>> ordered = {Narrow::Third, A::First, Medium::Second};
+    EXPECT_EQ(A::First, *ordered.begin());
+    EXPECT_EQ(A::Third, *ordered.rbegin());
+}
+
+template<typename T, typename U, typename = void>
+struct can_or_assign : std::false_type {};
+
+template<typename T, typename U>
+struct can_or_assign<T, U, decltype(static_cast<void>(std::declval<T&>() |= std::declval<U>()))> : std::true_type {};
+
+template<typename T, typename U, typename = void>
+struct can_and_assign : std::false_type {};
+
+template<typename T, typename U>
+struct can_and_assign<T, U, decltype(static_cast<void>(std::declval<T&>() &= std::declval<U>()))> : std::true_type {};
+
+TEST(shared_bitfield, heterogeneous) {
+    const shared_bitfield<A, Narrow> narrow = Narrow::Second;
+    const shared_bitfield<A, Medium> medium = Medium::Third;
+    const auto combined = narrow | medium;
+    EXPECT_TRUE((std::is_same<decltype(combined), const shared_bitfield<A>>::value));
+    EXPECT_EQ(3u, static_cast<unsigned int>(static_cast<A>(combined)));
+    EXPECT_EQ(0u, static_cast<unsigned int>(static_cast<A>(narrow & medium)));
+    EXPECT_EQ(3u, static_cast<unsigned int>(static_cast<A>(narrow ^ medium)));
+
+    shared_bitfield<A, Medium> assigned = Medium::First;
+    assigned |= shared_bitfield<A, Medium, Narrow>(Narrow::Third);
+    EXPECT_EQ(Medium::Third, assigned);
+
+    // Bits of a wider right-hand side would be lost by 'or' and 'xor', while 'and' clears them anyway.
+    EXPECT_FALSE((can_or_assign<shared_bitfield<A, Narrow>, shared_bitfield<A>>::value));
+    EXPECT_TRUE((can_or_assign<shared_bitfield<A>, shared_bitfield<A, Narrow>>::value));
+    EXPECT_TRUE((can_and_assign<shared_bitfield<A, Narrow>, shared_bitfield<A>>::value));
+    shared_bitfield<A, Narrow> small = Narrow::Second;
+    small &= shared_bitfield<A>(static_cast<A>(0x101));
+    EXPECT_EQ(Narrow::Second, small);
+    shared_bitfield<A> large = static_cast<A>(0x100);
+    large |= small;
+    large ^= shared_bitfield<A, Narrow>(Narrow::Third);
+    EXPECT_EQ(static_cast<A>(0x103), large);
+}
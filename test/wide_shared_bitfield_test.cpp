@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <trak/wide_shared_bitfield.hpp>
+
+#include <cstdint>
+#include <unordered_set>
+
+using namespace trak;
+
+namespace {
+    enum class Feature : std::uint16_t {
+        Base = 0,
+        Vector = 63,
+        Matrix = 64,
+        Tensor = 200,
+        Last = 299
+    };
+
+    enum class Extension : std::uint16_t {
+        Base = 0,
+        Vector = 63,
+        Matrix = 64,
+        Tensor = 200,
+        Ray = 250
+    };
+
+    enum class Device : std::uint16_t {
+        Matrix = 64,
+        Ray = 250
+    };
+
+    using features = wide_shared_bitfield<300, Feature, Extension>;
+    using extensions = wide_shared_bitfield<300, Extension, Device>;
+}
+
+TEST(wide_shared_bitfield, construction) {
+    static_assert(features::words == 5 && sizeof(features) == 5 * sizeof(std::uint64_t));
+    constexpr features none;
+    static_assert(!none.test(Feature::Base));
+    constexpr features tensor = Feature::Tensor;
+    static_assert(tensor.test(Feature::Tensor) && tensor.test(Extension::Tensor) && !tensor.test(Feature::Matrix));
+    EXPECT_TRUE(none.none());
+    EXPECT_TRUE(tensor.any());
+    EXPECT_EQ(1u, tensor.count());
+    EXPECT_EQ(std::uint64_t{1} << (200 - 192), tensor.data()[3]);
+
+    features value = Feature::Vector;
+    value.set(Extension::Matrix).set(Feature::Last);
+    EXPECT_EQ(3u, value.count());
+    EXPECT_TRUE(value.test(Feature::Vector) && value.test(Feature::Matrix) && value.test(Feature::Last));
+    value.reset(Feature::Matrix);
+    EXPECT_EQ(2u, value.count());
+    EXPECT_FALSE(value.test(Extension::Matrix));
+
+    // Converting to a subset of the types keeps the flags.
+    const wide_shared_bitfield<300, Extension> extension = value;
+    EXPECT_TRUE(extension.test(Extension::Vector));
+    EXPECT_TRUE(extension == value);
+}
+
+TEST(wide_shared_bitfield, operators) {
+    const features vector = Feature::Vector;
+    const extensions ray = Device::Ray;
+    const extensions matrix = Extension::Matrix;
+
+    // The result is the wide shared bitfield of the intersection.
+    const auto combined = vector | ray;
+    EXPECT_TRUE((std::is_same<decltype(combined), const wide_shared_bitfield<300, Extension>>::value));
+    EXPECT_EQ(2u, combined.count());
+    EXPECT_TRUE(combined.test(Extension::Vector) && combined.test(Extension::Ray));
+    EXPECT_TRUE((combined & ray).test(Extension::Ray));
+    EXPECT_EQ(1u, (combined & ray).count());
+    EXPECT_TRUE((combined ^ combined).none());
+    EXPECT_EQ(3u, (combined ^ matrix).count());
+
+    features value = Feature::Base;
+    value |= matrix;
+    value |= ray;
+    EXPECT_EQ(3u, value.count());
+    value &= matrix | ray;
+    EXPECT_EQ(2u, value.count());
+    value ^= matrix;
+    EXPECT_TRUE(value.test(Extension::Ray) && !value.test(Extension::Matrix));
+    EXPECT_TRUE(value != vector);
+}
+
+TEST(wide_shared_bitfield, small) {
+    // Bitfields of few words operate on their words directly.
+    using small = wide_shared_bitfield<100, Feature, Extension>;
+    static_assert(small::words == 2);
+    small value = Feature::Vector;
+    value |= small(Feature::Matrix);
+    EXPECT_EQ(2u, value.count());
+    EXPECT_TRUE((value & small(Feature::Matrix)).any());
+    EXPECT_TRUE((value ^ value).none());
+
+    std::unordered_set<small> set = {value, small(Feature::Base)};
+    EXPECT_EQ(1u, set.count(small(Feature::Base)));
+}